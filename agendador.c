@@ -0,0 +1,111 @@
+#include "agendador.h"
+
+#include "pico/stdlib.h"
+#include "rastro.h"
+
+static agendador_tarefa_t tarefas[AGENDADOR_MAX_TAREFAS];
+static size_t num_tarefas;
+static uint64_t ocioso_us;
+
+bool agendador_adicionar(const char *nome, agendador_funcao_t funcao, uint32_t periodo_ms, uint32_t prazo_ms)
+{
+    if (num_tarefas >= AGENDADOR_MAX_TAREFAS)
+    {
+        return false;
+    }
+
+    agendador_tarefa_t *t = &tarefas[num_tarefas++];
+    t->nome = nome;
+    t->funcao = funcao;
+    t->periodo_us = periodo_ms * 1000u;
+    t->prazo_us = prazo_ms * 1000u;
+    t->liberacao_us = time_us_64();
+    t->ultimo_fim_us = t->liberacao_us;
+    return true;
+}
+
+// Roda a tarefa e calcula sua próxima liberação, mantendo o alinhamento ao período.
+// Liberações cujo prazo já passou quando a tarefa termina são descartadas (e contadas
+// como perdidas) em vez de executadas em rajada.
+static void executar_tarefa(agendador_tarefa_t *t, uint64_t inicio)
+{
+    uint64_t prazo = t->liberacao_us + t->prazo_us;
+
+    RASTRO_INICIO(t->nome);
+    t->funcao();
+    RASTRO_FIM(t->nome);
+
+    uint64_t fim = time_us_64();
+    uint32_t duracao = (uint32_t)(fim - inicio);
+    t->execucoes++;
+    t->ultimo_fim_us = fim;
+    if (duracao > t->maior_duracao_us)
+    {
+        t->maior_duracao_us = duracao;
+    }
+    if (fim > prazo)
+    {
+        t->prazos_perdidos++;
+    }
+
+    t->liberacao_us += t->periodo_us;
+    if (t->liberacao_us + t->prazo_us < fim)
+    {
+        uint64_t descartadas = (fim - (t->liberacao_us + t->prazo_us)) / t->periodo_us + 1;
+        t->liberacao_us += descartadas * t->periodo_us;
+        t->prazos_perdidos += (uint32_t)descartadas;
+    }
+}
+
+void agendador_executar(void)
+{
+    while (true)
+    {
+        uint64_t agora = time_us_64();
+        agendador_tarefa_t *escolhida = NULL;
+        uint64_t proxima = UINT64_MAX;
+
+        // Entre as tarefas prontas, a de prazo mais próximo (EDF)
+        for (size_t i = 0; i < num_tarefas; i++)
+        {
+            agendador_tarefa_t *t = &tarefas[i];
+            if (t->liberacao_us <= agora)
+            {
+                if (!escolhida || t->liberacao_us + t->prazo_us < escolhida->liberacao_us + escolhida->prazo_us)
+                {
+                    escolhida = t;
+                }
+            }
+            else if (t->liberacao_us < proxima)
+            {
+                proxima = t->liberacao_us;
+            }
+        }
+
+        if (escolhida)
+        {
+            executar_tarefa(escolhida, agora);
+            continue;
+        }
+
+        // Nada pronto: dorme até a próxima liberação. Qualquer interrupção (Wi-Fi,
+        // botões, USB) também acorda o núcleo, e a escolha é refeita.
+        best_effort_wfe_or_timeout(from_us_since_boot(proxima));
+        ocioso_us += time_us_64() - agora;
+    }
+}
+
+size_t agendador_num_tarefas(void)
+{
+    return num_tarefas;
+}
+
+const agendador_tarefa_t *agendador_tarefa(size_t i)
+{
+    return i < num_tarefas ? &tarefas[i] : NULL;
+}
+
+uint64_t agendador_ocioso_us(void)
+{
+    return ocioso_us;
+}
@@ -0,0 +1,48 @@
+#ifndef AGENDADOR_H // Previne múltiplas inclusões do cabeçalho
+#define AGENDADOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Agendador cooperativo de tarefas periódicas para o laço principal.
+// Cada tarefa é liberada a cada 'periodo' e deve terminar até 'prazo' depois da
+// liberação. Entre as prontas, roda a de prazo mais próximo; sem nenhuma pronta, o
+// núcleo dorme em __wfe até a próxima liberação ou até uma interrupção.
+// As tarefas rodam até o fim (não há preempção), então nenhuma deve bloquear por
+// mais tempo que o menor prazo das demais.
+
+#define AGENDADOR_MAX_TAREFAS 8
+
+typedef void (*agendador_funcao_t)(void);
+
+typedef struct
+{
+    const char *nome; // String estática (usada também no rastro e nas métricas)
+    agendador_funcao_t funcao;
+    uint32_t periodo_us;
+    uint32_t prazo_us;     // Relativo à liberação
+    uint64_t liberacao_us; // Próxima liberação (µs desde o boot)
+    uint64_t ultimo_fim_us; // Fim da última execução: o batimento visto por supervisor.h
+
+    // Estatísticas
+    uint32_t execucoes;
+    uint32_t prazos_perdidos; // Execuções que terminaram após o prazo ou foram descartadas
+    uint32_t maior_duracao_us;
+} agendador_tarefa_t;
+
+// Registra uma tarefa; a primeira liberação é imediata.
+// Retorna false se já houver AGENDADOR_MAX_TAREFAS tarefas.
+bool agendador_adicionar(const char *nome, agendador_funcao_t funcao, uint32_t periodo_ms, uint32_t prazo_ms);
+
+// Executa as tarefas para sempre (substitui o laço principal)
+void agendador_executar(void);
+
+// Consulta das tarefas registradas, para exportação das estatísticas
+size_t agendador_num_tarefas(void);
+const agendador_tarefa_t *agendador_tarefa(size_t i);
+
+// Tempo total dormindo em __wfe desde o boot (µs)
+uint64_t agendador_ocioso_us(void);
+
+#endif // AGENDADOR_H
@@ -0,0 +1,483 @@
+#include "alertas.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hardware/sync.h"
+#include "servidor_http.h"
+
+// Estado de avaliação de uma regra
+typedef struct
+{
+    bool condicao;          // Condição (já com histerese) na última avaliação
+    bool ativa;             // Alerta disparado
+    uint32_t condicao_desde; // Instante em que 'condicao' mudou pela última vez
+    uint32_t ativa_desde;
+    bool tem_referencia;    // VARIACAO: ponto inicial da janela atual
+    float referencia;
+    uint32_t referencia_ms;
+} regra_estado_t;
+
+// As regras são publicadas em 'regras' por alertas_configurar, que roda no callback do
+// lwIP, com as interrupções mascaradas. O laço principal avalia uma cópia tirada no início
+// de cada avaliação, também com elas mascaradas, e só ele mexe em 'estados': o estado de
+// uma regra alterada recomeça na avaliação seguinte (bit em 'reiniciar').
+static regra_t regras[ALERTAS_MAX_REGRAS];
+static regra_t em_avaliacao[ALERTAS_MAX_REGRAS];
+static volatile uint32_t reiniciar;
+static regra_estado_t estados[ALERTAS_MAX_REGRAS];
+
+static const char *const nomes_tipo[] = {"desligada", "acima", "abaixo", "variacao", "falha"};
+static const char *const nomes_saida[] = {"vermelho", "verde", "azul", "buzzer", "matriz"};
+
+#define NUM_TIPOS (sizeof(nomes_tipo) / sizeof(nomes_tipo[0]))
+#define NUM_SAIDAS (sizeof(nomes_saida) / sizeof(nomes_saida[0]))
+
+void alertas_iniciar(void)
+{
+    // Mesmo mapeamento de LEDs de antes; a histerese e os tempos evitam que o buzzer
+    // fique alternando com a leitura parada em cima do limite
+    const regra_t padrao[] = {
+        {REGRA_ACIMA, GRANDEZA_TEMPERATURA, 0, 0.5f, 2000, 5000, 3, SAIDA_LED_VERMELHO | SAIDA_BUZZER, LIMITE_MAX},
+        {REGRA_ABAIXO, GRANDEZA_TEMPERATURA, 0, 0.5f, 2000, 5000, 3, SAIDA_LED_VERMELHO | SAIDA_BUZZER, LIMITE_MIN},
+        {REGRA_ACIMA, GRANDEZA_UMIDADE, 0, 2.0f, 2000, 5000, 2, SAIDA_LED_AZUL | SAIDA_BUZZER, LIMITE_MAX},
+        {REGRA_ABAIXO, GRANDEZA_UMIDADE, 0, 2.0f, 2000, 5000, 2, SAIDA_LED_AZUL | SAIDA_BUZZER, LIMITE_MIN},
+        {REGRA_ACIMA, GRANDEZA_PRESSAO, 0, 1.0f, 2000, 5000, 1, SAIDA_LED_VERDE | SAIDA_BUZZER, LIMITE_MAX},
+        {REGRA_ABAIXO, GRANDEZA_PRESSAO, 0, 1.0f, 2000, 5000, 1, SAIDA_LED_VERDE | SAIDA_BUZZER, LIMITE_MIN},
+    };
+
+    memset(regras, 0, sizeof(regras));
+    memset(estados, 0, sizeof(estados));
+    memcpy(regras, padrao, sizeof(padrao));
+    memcpy(em_avaliacao, regras, sizeof(regras));
+    reiniciar = 0;
+}
+
+// ============================================================================
+// === Avaliação ===
+
+// Valor da grandeza na amostra; false se o sensor correspondente falhou
+static bool valor_grandeza(const amostra_t *a, grandeza_t g, float *valor)
+{
+    switch (g)
+    {
+    case GRANDEZA_TEMPERATURA:
+        *valor = a->temperatura;
+        return a->temperatura_valida; // média dos sensores que responderam
+    case GRANDEZA_PRESSAO:
+        *valor = a->pressao;
+        return a->pressao_valida;
+    default:
+        *valor = a->umidade;
+        return a->umidade_valida;
+    }
+}
+
+// Limiar em vigor: o da regra ou, se ela segue a configuração, o min/max da grandeza
+static float limiar_regra(const regra_t *r, const configuracao_t *c)
+{
+    if (r->limite == LIMITE_NENHUM)
+    {
+        return r->limiar;
+    }
+    bool maximo = r->limite == LIMITE_MAX;
+    switch (r->grandeza)
+    {
+    case GRANDEZA_TEMPERATURA:
+        return maximo ? c->max_temp : c->min_temp;
+    case GRANDEZA_PRESSAO:
+        return maximo ? c->max_pressao : c->min_pressao;
+    default:
+        return maximo ? c->max_umidade : c->min_umidade;
+    }
+}
+
+// Condição da regra nesta amostra. Retorna false se a amostra não permite avaliar
+// (leitura inválida ou janela de variação incompleta); a condição anterior é mantida.
+static bool calcular_condicao(const regra_t *r, regra_estado_t *e, const amostra_t *a,
+                              const configuracao_t *c, bool *condicao)
+{
+    float v;
+    bool valido = valor_grandeza(a, r->grandeza, &v);
+    float limiar = limiar_regra(r, c);
+
+    if (r->tipo == REGRA_FALHA)
+    {
+        *condicao = !valido;
+        return true;
+    }
+    if (!valido)
+    {
+        return false;
+    }
+
+    switch (r->tipo)
+    {
+    case REGRA_ACIMA:
+        *condicao = e->condicao ? v > limiar - r->histerese : v > limiar;
+        return true;
+    case REGRA_ABAIXO:
+        *condicao = e->condicao ? v < limiar + r->histerese : v < limiar;
+        return true;
+    case REGRA_VARIACAO:
+    {
+        if (!e->tem_referencia)
+        {
+            e->tem_referencia = true;
+            e->referencia = v;
+            e->referencia_ms = a->instante_ms;
+            return false;
+        }
+        uint32_t dt = a->instante_ms - e->referencia_ms;
+        if (dt < ALERTAS_JANELA_VARIACAO_MS)
+        {
+            return false;
+        }
+        float por_minuto = fabsf(v - e->referencia) * 60000.0f / (float)dt;
+        e->referencia = v;
+        e->referencia_ms = a->instante_ms;
+        *condicao = e->condicao ? por_minuto > limiar - r->histerese : por_minuto > limiar;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void alertas_avaliar(const amostra_t *amostra, const configuracao_t *config)
+{
+    uint32_t agora = amostra->instante_ms;
+
+    uint32_t estado_irq = save_and_disable_interrupts();
+    memcpy(em_avaliacao, regras, sizeof(regras));
+    uint32_t alteradas = reiniciar;
+    reiniciar = 0;
+    restore_interrupts(estado_irq);
+
+    for (int i = 0; i < ALERTAS_MAX_REGRAS; i++)
+    {
+        const regra_t *r = &em_avaliacao[i];
+        regra_estado_t *e = &estados[i];
+        if (alteradas & (1u << i))
+        {
+            memset(e, 0, sizeof(*e)); // a regra recomeça do zero com os novos parâmetros
+        }
+        if (r->tipo == REGRA_DESLIGADA)
+        {
+            continue;
+        }
+
+        bool condicao;
+        if (calcular_condicao(r, e, amostra, config, &condicao) && condicao != e->condicao)
+        {
+            e->condicao = condicao;
+            e->condicao_desde = agora;
+        }
+
+        if (!e->ativa && e->condicao && agora - e->condicao_desde >= r->espera_ms)
+        {
+            e->ativa = true;
+            e->ativa_desde = agora;
+        }
+        else if (e->ativa && !e->condicao && agora - e->ativa_desde >= r->minimo_ms)
+        {
+            e->ativa = false;
+        }
+    }
+}
+
+uint8_t alertas_saidas(int *ativas)
+{
+    uint8_t saidas = 0;
+    int n = 0;
+    const regra_t *principal = NULL;
+
+    for (int i = 0; i < ALERTAS_MAX_REGRAS; i++)
+    {
+        const regra_t *r = &em_avaliacao[i];
+        if (r->tipo == REGRA_DESLIGADA || !estados[i].ativa)
+        {
+            continue;
+        }
+        n++;
+        saidas |= r->saidas & ~SAIDA_LEDS;
+        if (!principal || r->prioridade > principal->prioridade)
+        {
+            principal = r;
+        }
+    }
+
+    if (principal)
+    {
+        saidas |= principal->saidas & SAIDA_LEDS;
+    }
+    if (n > 1)
+    {
+        saidas |= SAIDA_MATRIZ;
+    }
+    if (ativas)
+    {
+        *ativas = n;
+    }
+    return saidas;
+}
+
+// ============================================================================
+// === Configuração ===
+
+static int buscar_nome(const char *valor, size_t tam, const char *const *nomes, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        if (strlen(nomes[i]) == tam && strncmp(valor, nomes[i], tam) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Grandeza pelo nome de grandeza_nome, ou -1
+static int buscar_grandeza(const char *valor, size_t tam)
+{
+    for (int g = 0; g < NUM_GRANDEZAS; g++)
+    {
+        const char *nome = grandeza_nome((grandeza_t)g);
+        if (strlen(nome) == tam && strncmp(valor, nome, tam) == 0)
+        {
+            return g;
+        }
+    }
+    return -1;
+}
+
+// Lista "vermelho,buzzer" -> máscara SAIDA_*; "nenhuma" -> 0
+static bool ler_saidas(const char *valor, size_t tam, uint8_t *saidas)
+{
+    *saidas = 0;
+    if (tam == 7 && strncmp(valor, "nenhuma", 7) == 0)
+    {
+        return true;
+    }
+    while (tam > 0)
+    {
+        size_t n = 0;
+        while (n < tam && valor[n] != ',')
+        {
+            n++;
+        }
+        int s = buscar_nome(valor, n, nomes_saida, NUM_SAIDAS);
+        if (s < 0)
+        {
+            return false;
+        }
+        *saidas |= (uint8_t)(1u << s);
+        valor += n;
+        tam -= n;
+        if (tam > 0)
+        {
+            valor++; // vírgula
+            tam--;
+        }
+    }
+    return true;
+}
+
+// Número inteiro ocupando todo o valor
+static bool ler_inteiro(const char *valor, size_t tam, unsigned long maximo, unsigned long *saida)
+{
+    char *fim;
+    *saida = strtoul(valor, &fim, 10);
+    return tam > 0 && fim == valor + tam && *saida <= maximo;
+}
+
+bool alertas_configurar(int indice, const char *parametros)
+{
+    if (indice < 0 || indice >= ALERTAS_MAX_REGRAS)
+    {
+        return false;
+    }
+
+    regra_t nova = regras[indice];
+    const char *p = parametros;
+
+    // Pares "chave=valor" separados por '&', até o fim da URL
+    while (*p && *p != ' ' && *p != '\r' && *p != '\n')
+    {
+        const char *chave = p;
+        const char *igual = strchr(p, '=');
+        if (!igual)
+        {
+            return false;
+        }
+        const char *valor = igual + 1;
+        size_t tam = strcspn(valor, "& \r\n");
+        size_t tam_chave = (size_t)(igual - chave);
+        unsigned long u;
+        char *fim;
+
+#define CHAVE(nome) (tam_chave == sizeof(nome) - 1 && strncmp(chave, nome, tam_chave) == 0)
+        if (CHAVE("tipo"))
+        {
+            int t = buscar_nome(valor, tam, nomes_tipo, NUM_TIPOS);
+            if (t < 0)
+            {
+                return false;
+            }
+            nova.tipo = (regra_tipo_t)t;
+        }
+        else if (CHAVE("grandeza"))
+        {
+            int g = buscar_grandeza(valor, tam);
+            if (g < 0)
+            {
+                return false;
+            }
+            nova.grandeza = (grandeza_t)g;
+        }
+        else if (CHAVE("limiar"))
+        {
+            nova.limiar = strtof(valor, &fim);
+            if (fim != valor + tam || tam == 0)
+            {
+                return false;
+            }
+            nova.limite = LIMITE_NENHUM; // limiar explícito deixa de seguir /limites
+        }
+        else if (CHAVE("histerese"))
+        {
+            nova.histerese = strtof(valor, &fim);
+            if (fim != valor + tam || tam == 0 || nova.histerese < 0)
+            {
+                return false;
+            }
+        }
+        else if (CHAVE("espera") && ler_inteiro(valor, tam, UINT32_MAX, &u))
+        {
+            nova.espera_ms = (uint32_t)u;
+        }
+        else if (CHAVE("minimo") && ler_inteiro(valor, tam, UINT32_MAX, &u))
+        {
+            nova.minimo_ms = (uint32_t)u;
+        }
+        else if (CHAVE("prioridade") && ler_inteiro(valor, tam, 255, &u))
+        {
+            nova.prioridade = (uint8_t)u;
+        }
+        else if (CHAVE("saidas"))
+        {
+            if (!ler_saidas(valor, tam, &nova.saidas))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false; // chave desconhecida ou valor numérico inválido
+        }
+#undef CHAVE
+
+        p = valor + tam;
+        if (*p == '&')
+        {
+            p++;
+        }
+    }
+
+    uint32_t estado_irq = save_and_disable_interrupts();
+    regras[indice] = nova;
+    reiniciar |= 1u << indice;
+    restore_interrupts(estado_irq);
+    return true;
+}
+
+void alertas_exportar(regra_t copia[ALERTAS_MAX_REGRAS])
+{
+    uint32_t estado_irq = save_and_disable_interrupts();
+    memcpy(copia, regras, sizeof(regras));
+    restore_interrupts(estado_irq);
+}
+
+void alertas_restaurar(const regra_t copia[ALERTAS_MAX_REGRAS])
+{
+    memcpy(regras, copia, sizeof(regras));
+    memset(estados, 0, sizeof(estados));
+    reiniciar = 0;
+    for (int i = 0; i < ALERTAS_MAX_REGRAS; i++)
+    {
+        // Índices dos nomes usados na exportação precisam continuar válidos
+        if ((unsigned)regras[i].tipo >= NUM_TIPOS || (unsigned)regras[i].grandeza >= NUM_GRANDEZAS)
+        {
+            regras[i].tipo = REGRA_DESLIGADA;
+            regras[i].grandeza = GRANDEZA_TEMPERATURA;
+        }
+    }
+    memcpy(em_avaliacao, regras, sizeof(regras));
+}
+
+// ============================================================================
+// === Exportação ===
+// Itens: "[", uma regra por item (as desligadas não geram texto) e "]"
+
+static int gerar_regra(int i, char *buf, size_t tam, bool primeira)
+{
+    const regra_t *r = &regras[i];
+    configuracao_t config;
+    configuracao_ler(&config);
+    char saidas[48] = "";
+    for (size_t s = 0; s < NUM_SAIDAS; s++)
+    {
+        if (r->saidas & (1u << s))
+        {
+            if (saidas[0])
+            {
+                strcat(saidas, ",");
+            }
+            strcat(saidas, nomes_saida[s]);
+        }
+    }
+
+    return snprintf(buf, tam,
+                    "%s{\"indice\":%d,\"tipo\":\"%s\",\"grandeza\":\"%s\",\"limiar\":%.2f,\"histerese\":%.2f,"
+                    "\"espera\":%lu,\"minimo\":%lu,\"prioridade\":%u,\"saidas\":\"%s\",\"ativa\":%s}",
+                    primeira ? "" : ",", i, nomes_tipo[r->tipo], grandeza_nome(r->grandeza),
+                    limiar_regra(r, &config), r->histerese,
+                    (unsigned long)r->espera_ms, (unsigned long)r->minimo_ms, r->prioridade,
+                    saidas[0] ? saidas : "nenhuma", estados[i].ativa ? "true" : "false");
+}
+
+// Escreve o item 'item'. Retorna o tamanho ou -1 depois do último item.
+static int gerar_item(uint32_t item, char *buf, size_t tam)
+{
+    if (item == 0)
+    {
+        return snprintf(buf, tam, "[");
+    }
+    if (item > ALERTAS_MAX_REGRAS + 1)
+    {
+        return -1;
+    }
+    if (item == ALERTAS_MAX_REGRAS + 1)
+    {
+        return snprintf(buf, tam, "]\n");
+    }
+
+    int i = (int)item - 1;
+    if (regras[i].tipo == REGRA_DESLIGADA)
+    {
+        return 0;
+    }
+    bool primeira = true;
+    for (int j = 0; j < i; j++)
+    {
+        primeira = primeira && regras[j].tipo == REGRA_DESLIGADA;
+    }
+    return gerar_regra(i, buf, tam, primeira);
+}
+
+size_t alertas_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    return http_gerar_itens(cursor, buf, tam, gerar_item);
+}
@@ -0,0 +1,87 @@
+#ifndef ALERTAS_H // Previne múltiplas inclusões do cabeçalho
+#define ALERTAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "amostra.h"
+#include "configuracao.h"
+
+// Motor de regras de alerta, avaliado uma vez por amostra em O(regras).
+// Cada regra observa uma grandeza e tem estado próprio:
+//  - ACIMA/ABAIXO: limiar com banda de histerese (só desarma ao voltar além dela);
+//  - VARIACAO: |variação| por minuto, medida a cada ALERTAS_JANELA_VARIACAO_MS;
+//  - FALHA: sensor da grandeza sem resposta.
+// A condição precisa durar 'espera_ms' para disparar, e o alerta fica ativo por pelo
+// menos 'minimo_ms'. Entre as regras ativas, a de maior prioridade escolhe a cor do
+// LED; buzzer e matriz são acionados por qualquer regra ativa que os peça, e a matriz
+// também acende com mais de uma regra ativa.
+// As regras são configuradas por HTTP (GET /regra/<n>?...) e listadas em GET /regras.
+
+#define ALERTAS_MAX_REGRAS 12
+#define ALERTAS_JANELA_VARIACAO_MS 10000
+
+typedef enum
+{
+    REGRA_DESLIGADA,
+    REGRA_ACIMA,
+    REGRA_ABAIXO,
+    REGRA_VARIACAO,
+    REGRA_FALHA,
+} regra_tipo_t;
+
+// Limite da configuração seguido por uma regra ACIMA/ABAIXO no lugar de 'limiar'
+typedef enum
+{
+    LIMITE_NENHUM,
+    LIMITE_MIN,
+    LIMITE_MAX,
+} regra_limite_t;
+
+// Saídas acionadas por uma regra (máscara de bits)
+#define SAIDA_LED_VERMELHO 0x01
+#define SAIDA_LED_VERDE 0x02
+#define SAIDA_LED_AZUL 0x04
+#define SAIDA_BUZZER 0x08
+#define SAIDA_MATRIZ 0x10
+#define SAIDA_LEDS (SAIDA_LED_VERMELHO | SAIDA_LED_VERDE | SAIDA_LED_AZUL)
+
+typedef struct
+{
+    regra_tipo_t tipo;
+    grandeza_t grandeza;
+    float limiar;        // ACIMA/ABAIXO: valor; VARIACAO: unidades por minuto
+    float histerese;     // Banda para desarmar, na unidade do limiar
+    uint32_t espera_ms;  // Tempo mínimo com a condição verdadeira antes de disparar
+    uint32_t minimo_ms;  // Tempo mínimo ativo depois de disparar
+    uint8_t prioridade;  // Maior vence na escolha do LED
+    uint8_t saidas;      // SAIDA_*
+    regra_limite_t limite; // Min/max da grandeza em configuracao_t (/limites e MQTT)
+} regra_t;
+
+// Carrega as regras equivalentes aos limites min/max de cada grandeza
+void alertas_iniciar(void);
+
+// Avalia todas as regras com a nova amostra e a configuração em vigor
+void alertas_avaliar(const amostra_t *amostra, const configuracao_t *config);
+
+// Saídas pedidas pelas regras ativas (SAIDA_*) e quantas estão ativas
+uint8_t alertas_saidas(int *ativas);
+
+// Aplica parâmetros "chave=valor&..." à regra 'indice'. Chaves: tipo, grandeza, limiar,
+// histerese, espera, minimo, prioridade, saidas (nomes separados por vírgula).
+// Retorna false se o índice ou algum parâmetro for inválido (a regra não é alterada).
+// Pode ser chamada no callback do lwIP: a regra vale, com o estado zerado, a partir da
+// próxima alertas_avaliar.
+bool alertas_configurar(int indice, const char *parametros);
+
+// Cópia das regras, guardada entre reinícios a quente (supervisor.h). A restauração
+// recomeça a avaliação de todas, como alertas_configurar faz com uma.
+void alertas_exportar(regra_t copia[ALERTAS_MAX_REGRAS]);
+void alertas_restaurar(const regra_t copia[ALERTAS_MAX_REGRAS]);
+
+// Gerador da lista de regras em JSON (http_gerador_t)
+size_t alertas_gerar(uint32_t *cursor, char *buf, size_t tam);
+
+#endif // ALERTAS_H
@@ -0,0 +1,36 @@
+#ifndef AMOSTRA_H // Previne múltiplas inclusões do cabeçalho
+#define AMOSTRA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Grandezas medidas pela estação, nas unidades de amostra_t
+typedef enum
+{
+    GRANDEZA_TEMPERATURA,
+    GRANDEZA_PRESSAO,
+    GRANDEZA_UMIDADE,
+    NUM_GRANDEZAS
+} grandeza_t;
+
+// Nome da grandeza em JSON e nas métricas
+static inline const char *grandeza_nome(grandeza_t grandeza)
+{
+    static const char *const nomes[NUM_GRANDEZAS] = {"temperatura", "pressao", "umidade"};
+    return nomes[grandeza];
+}
+
+// Uma leitura completa da estação, já com offsets aplicados.
+// É o formato entregue pelo laço principal aos canais de telemetria.
+typedef struct
+{
+    uint32_t instante_ms;    // Milissegundos desde o boot
+    float temperatura;       // °C
+    float pressao;           // hPa
+    float umidade;           // %
+    bool temperatura_valida; // false se nenhum sensor de temperatura respondeu
+    bool umidade_valida;     // false se o AHT20 não respondeu
+    bool pressao_valida;     // false se o BMP280 não respondeu (pressão é a última válida)
+} amostra_t;
+
+#endif // AMOSTRA_H
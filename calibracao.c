@@ -0,0 +1,192 @@
+#include "calibracao.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LIMITE_VALOR 100000.0f // Maior |valor| aceito num ponto, na unidade da grandeza
+#define UM_Q16 65536
+
+static int32_t em_centesimos(float valor)
+{
+    float v = valor * CALIBRACAO_ESCALA;
+    return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+bool calibracao_montar(calibracao_t *t, const float *medido, const float *referencia, int num)
+{
+    if (num < 0 || num > CALIBRACAO_MAX_PONTOS)
+    {
+        return false;
+    }
+
+    // Ordenação por inserção pelo valor medido (poucos pontos)
+    calibracao_t nova = {.num_pontos = (uint8_t)num};
+    for (int i = 0; i < num; i++)
+    {
+        if (!(medido[i] > -LIMITE_VALOR && medido[i] < LIMITE_VALOR) ||
+            !(referencia[i] > -LIMITE_VALOR && referencia[i] < LIMITE_VALOR))
+        {
+            return false; // também recusa NaN
+        }
+        int32_t m = em_centesimos(medido[i]);
+        int32_t r = em_centesimos(referencia[i]);
+        int j = i;
+        while (j > 0 && nova.medido[j - 1] > m)
+        {
+            nova.medido[j] = nova.medido[j - 1];
+            nova.referencia[j] = nova.referencia[j - 1];
+            j--;
+        }
+        if (j > 0 && nova.medido[j - 1] == m)
+        {
+            return false;
+        }
+        nova.medido[j] = m;
+        nova.referencia[j] = r;
+    }
+
+    // Inclinação de cada segmento; com um ponto só, 1 (deslocamento puro)
+    nova.inclinacao[0] = UM_Q16;
+    for (int i = 0; i + 1 < num; i++)
+    {
+        int64_t dy = (int64_t)(nova.referencia[i + 1] - nova.referencia[i]) * UM_Q16;
+        int64_t dx = nova.medido[i + 1] - nova.medido[i];
+        int64_t q = (dy + (dy >= 0 ? dx / 2 : -dx / 2)) / dx;
+        if (q > INT32_MAX || q < INT32_MIN)
+        {
+            return false;
+        }
+        nova.inclinacao[i] = (int32_t)q;
+        nova.inclinacao[i + 1] = (int32_t)q; // o último ponto repete o segmento anterior
+    }
+
+    *t = nova;
+    return true;
+}
+
+int32_t calibracao_aplicar_fixo(const calibracao_t *t, int32_t valor)
+{
+    if (t->num_pontos == 0)
+    {
+        return valor;
+    }
+
+    // Último ponto com medido <= valor, limitado aos segmentos que existem
+    int baixo = 0, alto = t->num_pontos - 1;
+    while (alto - baixo > 1)
+    {
+        int meio = (baixo + alto) / 2;
+        if (valor < t->medido[meio])
+        {
+            alto = meio;
+        }
+        else
+        {
+            baixo = meio;
+        }
+    }
+
+    int64_t delta = (int64_t)(valor - t->medido[baixo]) * t->inclinacao[baixo];
+    return t->referencia[baixo] + (int32_t)((delta + UM_Q16 / 2) >> 16);
+}
+
+float calibracao_aplicar(const calibracao_t *t, float valor)
+{
+    if (t->num_pontos == 0)
+    {
+        return valor; // sem conversão: sem calibração, a leitura sai como antes
+    }
+    return (float)calibracao_aplicar_fixo(t, em_centesimos(valor)) / CALIBRACAO_ESCALA;
+}
+
+// Lê a lista "a,b,c" de 'tam' caracteres. Retorna quantos valores leu, ou -1 se a
+// lista for inválida ou tiver mais de CALIBRACAO_MAX_PONTOS valores.
+static int ler_lista(const char *texto, size_t tam, float *valores)
+{
+    int n = 0;
+    const char *p = texto, *fim_lista = texto + tam;
+    while (p < fim_lista)
+    {
+        if (n == CALIBRACAO_MAX_PONTOS)
+        {
+            return -1;
+        }
+        char *fim;
+        valores[n++] = strtof(p, &fim);
+        if (fim == p || fim > fim_lista)
+        {
+            return -1;
+        }
+        if (fim == fim_lista)
+        {
+            break;
+        }
+        if (*fim != ',' || fim + 1 == fim_lista)
+        {
+            return -1; // separador inválido ou vírgula no fim
+        }
+        p = fim + 1;
+    }
+    return n;
+}
+
+bool calibracao_configurar(calibracao_t *t, const char *parametros)
+{
+    float medido[CALIBRACAO_MAX_PONTOS], referencia[CALIBRACAO_MAX_PONTOS];
+    int num_medido = -1, num_referencia = -1;
+    const char *p = parametros;
+
+    // Pares "chave=valor" separados por '&', até o fim da URL
+    while (*p && *p != ' ' && *p != '\r' && *p != '\n')
+    {
+        const char *chave = p;
+        const char *igual = strchr(p, '=');
+        if (!igual)
+        {
+            return false;
+        }
+        const char *valor = igual + 1;
+        size_t tam = strcspn(valor, "& \r\n");
+        size_t tam_chave = (size_t)(igual - chave);
+
+#define CHAVE(nome) (tam_chave == sizeof(nome) - 1 && strncmp(chave, nome, tam_chave) == 0)
+        if (CHAVE("medido"))
+        {
+            num_medido = ler_lista(valor, tam, medido);
+        }
+        else if (CHAVE("referencia"))
+        {
+            num_referencia = ler_lista(valor, tam, referencia);
+        }
+        else
+        {
+            return false;
+        }
+#undef CHAVE
+
+        p = valor + tam;
+        if (*p == '&')
+        {
+            p++;
+        }
+    }
+
+    return num_medido >= 0 && num_medido == num_referencia &&
+           calibracao_montar(t, medido, referencia, num_medido);
+}
+
+int calibracao_json(const calibracao_t *t, char *buf, size_t tam)
+{
+    int n = snprintf(buf, tam, "[");
+    for (int i = 0; i < t->num_pontos && n >= 0 && (size_t)n < tam; i++)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "%s[%.2f,%.2f]", i == 0 ? "" : ",",
+                      (double)t->medido[i] / CALIBRACAO_ESCALA, (double)t->referencia[i] / CALIBRACAO_ESCALA);
+    }
+    if (n >= 0 && (size_t)n < tam)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "]");
+    }
+    return n;
+}
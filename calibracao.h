@@ -0,0 +1,47 @@
+#ifndef CALIBRACAO_H // Previne múltiplas inclusões do cabeçalho
+#define CALIBRACAO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Calibração em vários pontos de um canal: correção linear por partes entre pares
+// (medido, referência), para erros que um offset só não corrige (como a umidade do
+// AHT20 perto de 0 e de 100 %).
+//
+// A tabela é montada uma vez, quando os pares chegam: pontos ordenados pelo valor
+// medido, em centésimos da unidade, com a inclinação de cada segmento já calculada
+// em Q16. Cada amostra custa uma busca binária pelo segmento e uma multiplicação, em
+// ponto fixo. Abaixo do primeiro ponto e acima do último valem as retas dos segmentos
+// das pontas. Com um ponto só, a correção é um deslocamento; sem pontos, nenhuma.
+
+#define CALIBRACAO_MAX_PONTOS 8
+#define CALIBRACAO_ESCALA 100 // Pontos em centésimos (0,01 °C, 0,01 hPa, 0,01 %)
+
+typedef struct
+{
+    uint8_t num_pontos;
+    int32_t medido[CALIBRACAO_MAX_PONTOS];     // Crescente, sem repetição
+    int32_t referencia[CALIBRACAO_MAX_PONTOS]; // Valor verdadeiro em cada ponto
+    int32_t inclinacao[CALIBRACAO_MAX_PONTOS]; // Q16 do segmento que começa no ponto
+} calibracao_t;
+
+// Monta a tabela com 'num' pares nas unidades da grandeza, em qualquer ordem.
+// Retorna false (sem alterar 't') se houver mais de CALIBRACAO_MAX_PONTOS pares,
+// dois pares com o mesmo valor medido ou valores fora da faixa.
+bool calibracao_montar(calibracao_t *t, const float *medido, const float *referencia, int num);
+
+// Lê "medido=a,b,c&referencia=x,y,z" (query de uma URL, até o fim da linha) e monta
+// a tabela. Listas vazias removem a calibração.
+bool calibracao_configurar(calibracao_t *t, const char *parametros);
+
+// Valor corrigido, em centésimos
+int32_t calibracao_aplicar_fixo(const calibracao_t *t, int32_t valor);
+
+// Valor corrigido na unidade da grandeza (converte para centésimos e de volta)
+float calibracao_aplicar(const calibracao_t *t, float valor);
+
+// Pontos em JSON: [[medido,referencia],...]. Retorna o tamanho escrito, como snprintf.
+int calibracao_json(const calibracao_t *t, char *buf, size_t tam);
+
+#endif // CALIBRACAO_H
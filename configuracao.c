@@ -0,0 +1,238 @@
+#include "configuracao.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+static const configuracao_t padrao = {
+    .offset_temp = 0.0f,
+    .offset_pressao = 0.0f,
+    .offset_umidade = 0.0f,
+    .min_temp = -50.0f,
+    .max_temp = 50.0f,
+    .min_pressao = 100.0f,
+    .max_pressao = 1100.0f,
+    .min_umidade = 0.0f,
+    .max_umidade = 100.0f,
+};
+
+static configuracao_t atual = padrao;
+static volatile uint32_t sequencia;  // Ímpar durante uma alteração
+static uint32_t estado_interrupcoes; // Salvo por configuracao_alterar
+
+// Nome de cada campo nos comandos MQTT e no JSON de /estado
+static const struct
+{
+    const char *chave;
+    size_t deslocamento;
+} campos[] = {
+    {"offset_temp", offsetof(configuracao_t, offset_temp)},
+    {"offset_pressao", offsetof(configuracao_t, offset_pressao)},
+    {"offset_umidade", offsetof(configuracao_t, offset_umidade)},
+    {"min_temp", offsetof(configuracao_t, min_temp)},
+    {"max_temp", offsetof(configuracao_t, max_temp)},
+    {"min_press", offsetof(configuracao_t, min_pressao)},
+    {"max_press", offsetof(configuracao_t, max_pressao)},
+    {"min_umid", offsetof(configuracao_t, min_umidade)},
+    {"max_umid", offsetof(configuracao_t, max_umidade)},
+};
+
+#define NUM_CAMPOS (sizeof(campos) / sizeof(campos[0]))
+
+// Pares mínimo/máximo conferidos por configuracao_definir_lote
+static const struct
+{
+    size_t min, max;
+} pares_limite[] = {
+    {offsetof(configuracao_t, min_temp), offsetof(configuracao_t, max_temp)},
+    {offsetof(configuracao_t, min_pressao), offsetof(configuracao_t, max_pressao)},
+    {offsetof(configuracao_t, min_umidade), offsetof(configuracao_t, max_umidade)},
+};
+
+static float *campo(configuracao_t *c, size_t deslocamento)
+{
+    return (float *)((char *)c + deslocamento);
+}
+
+// Índice em 'campos' da chave de 'tam' caracteres, ou -1
+static int buscar_campo(const char *chave, size_t tam)
+{
+    for (size_t i = 0; i < NUM_CAMPOS; i++)
+    {
+        if (strlen(campos[i].chave) == tam && strncmp(chave, campos[i].chave, tam) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+uint32_t configuracao_ler(configuracao_t *copia)
+{
+    uint32_t antes, depois;
+    do
+    {
+        // Um escritor no mesmo núcleo nunca é interrompido pelo leitor, então só se
+        // espera aqui por uma alteração em andamento vista do outro núcleo
+        while ((antes = sequencia) & 1u)
+        {
+            tight_loop_contents();
+        }
+        __dmb(); // campos lidos depois do contador
+        *copia = atual;
+        __dmb();
+        depois = sequencia;
+    } while (antes != depois);
+    return antes >> 1;
+}
+
+uint32_t configuracao_versao(void)
+{
+    return sequencia >> 1;
+}
+
+configuracao_t *configuracao_alterar(void)
+{
+    uint32_t estado = save_and_disable_interrupts();
+    estado_interrupcoes = estado;
+    sequencia++;
+    __dmb(); // contador ímpar visível antes de qualquer campo
+    return &atual;
+}
+
+void configuracao_publicar(void)
+{
+    __dmb(); // campos completos antes de o contador voltar a ser par
+    sequencia++;
+    restore_interrupts(estado_interrupcoes);
+}
+
+bool configuracao_definir(const char *chave, float valor)
+{
+    int i = buscar_campo(chave, strlen(chave));
+    if (i < 0)
+    {
+        return false;
+    }
+    *campo(configuracao_alterar(), campos[i].deslocamento) = valor;
+    configuracao_publicar();
+    return true;
+}
+
+bool configuracao_definir_limites(const char *sufixo, float min, float max)
+{
+    char chave_min[16], chave_max[16];
+    snprintf(chave_min, sizeof(chave_min), "min_%s", sufixo);
+    snprintf(chave_max, sizeof(chave_max), "max_%s", sufixo);
+    int i_min = buscar_campo(chave_min, strlen(chave_min));
+    int i_max = buscar_campo(chave_max, strlen(chave_max));
+    if (i_min < 0 || i_max < 0)
+    {
+        return false;
+    }
+    configuracao_t *c = configuracao_alterar();
+    *campo(c, campos[i_min].deslocamento) = min;
+    *campo(c, campos[i_max].deslocamento) = max;
+    configuracao_publicar();
+    return true;
+}
+
+bool configuracao_definir_lote(const char *texto, size_t tam)
+{
+    float valores[NUM_CAMPOS];
+    uint32_t presentes = 0; // Bit i: campos[i] aparece no lote
+    const char *p = texto, *fim = texto + tam;
+
+    // Itens "chave=valor"; separadores repetidos (como "\r\n") geram itens vazios
+    while (p < fim)
+    {
+        size_t tam_item = 0;
+        while (p + tam_item < fim && !strchr("&;\r\n", p[tam_item]))
+        {
+            tam_item++;
+        }
+        if (tam_item > 0)
+        {
+            const char *igual = memchr(p, '=', tam_item);
+            int i = igual ? buscar_campo(p, (size_t)(igual - p)) : -1;
+            size_t tam_valor = igual ? tam_item - (size_t)(igual - p) - 1 : 0;
+            char numero[24], *fim_numero;
+            if (i < 0 || tam_valor == 0 || tam_valor >= sizeof(numero))
+            {
+                return false;
+            }
+            memcpy(numero, igual + 1, tam_valor);
+            numero[tam_valor] = '\0';
+            valores[i] = strtof(numero, &fim_numero);
+            if (*fim_numero != '\0' || !isfinite(valores[i]))
+            {
+                return false;
+            }
+            presentes |= 1u << i;
+        }
+        p += tam_item + 1;
+    }
+    if (!presentes)
+    {
+        return false;
+    }
+
+    // Mescla e validação sobre a configuração atual com as interrupções mascaradas: os
+    // outros escritores (botão A, MQTT) ficam no núcleo 0 e não entram no meio
+    uint32_t estado = save_and_disable_interrupts();
+    configuracao_t nova = atual;
+    for (size_t i = 0; i < NUM_CAMPOS; i++)
+    {
+        if (presentes & (1u << i))
+        {
+            *campo(&nova, campos[i].deslocamento) = valores[i];
+        }
+    }
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(pares_limite) / sizeof(pares_limite[0]); i++)
+    {
+        float min = *campo(&nova, pares_limite[i].min);
+        float max = *campo(&nova, pares_limite[i].max);
+        bool alterado = min != *campo(&atual, pares_limite[i].min) || max != *campo(&atual, pares_limite[i].max);
+        if (alterado && min > max)
+        {
+            ok = false;
+        }
+    }
+    if (ok)
+    {
+        *configuracao_alterar() = nova;
+        configuracao_publicar();
+    }
+    restore_interrupts(estado);
+    return ok;
+}
+
+int configuracao_json(char *buf, size_t tam)
+{
+    configuracao_t c;
+    uint32_t versao = configuracao_ler(&c);
+    int n = snprintf(buf, tam, "{");
+    for (size_t i = 0; i < NUM_CAMPOS && n >= 0 && (size_t)n < tam; i++)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "\"%s\":%.2f,", campos[i].chave,
+                      (double)*campo(&c, campos[i].deslocamento));
+    }
+    if (n >= 0 && (size_t)n < tam)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "\"versao\":%lu}\n", (unsigned long)versao);
+    }
+    return n;
+}
+
+void configuracao_restaurar(void)
+{
+    configuracao_t *c = configuracao_alterar();
+    *c = padrao;
+    configuracao_publicar();
+}
@@ -0,0 +1,74 @@
+#ifndef CONFIGURACAO_H // Previne múltiplas inclusões do cabeçalho
+#define CONFIGURACAO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "amostra.h"
+#include "calibracao.h"
+
+// Offsets e tabelas de calibração e limites aceitáveis, alterados pelo botão A
+// (interrupção de GPIO), pelas rotas HTTP e pelo MQTT (callbacks do lwIP) e lidos pelo
+// laço principal.
+//
+// A configuração é publicada com um seqlock: o escritor torna o contador ímpar, altera
+// os campos e o torna par de novo, tudo com as interrupções mascaradas; o leitor copia
+// a estrutura e repete a cópia se o contador mudou no meio. Assim o leitor sempre vê
+// um conjunto coerente (min e max do mesmo pedido) sem mascarar interrupções.
+// A versão (contador / 2) muda a cada alteração publicada, e é exposta em /estado para
+// que os clientes detectem mudanças sem comparar os valores.
+//
+// Os escritores ficam no núcleo 0; a leitura vale em qualquer núcleo.
+
+typedef struct
+{
+    // Offsets de calibração para temperatura, pressão e umidade
+    float offset_temp, offset_pressao, offset_umidade;
+
+    // Limites aceitáveis para temperatura, pressão e umidade
+    float min_temp, max_temp;
+    float min_pressao, max_pressao;
+    float min_umidade, max_umidade;
+
+    // Calibração em vários pontos de cada grandeza, aplicada antes do offset
+    calibracao_t calibracao[NUM_GRANDEZAS];
+} configuracao_t;
+
+// Copia a configuração atual para 'copia' e retorna a versão correspondente
+uint32_t configuracao_ler(configuracao_t *copia);
+
+// Versão da configuração atual, sem copiar os valores
+uint32_t configuracao_versao(void);
+
+// Abre uma alteração e retorna a configuração para ser modificada no lugar.
+// Precisa ser seguida de configuracao_publicar, sem nada demorado entre as duas:
+// as interrupções ficam mascaradas até lá.
+configuracao_t *configuracao_alterar(void);
+
+// Conclui a alteração aberta por configuracao_alterar, gerando uma nova versão
+void configuracao_publicar(void);
+
+// Altera um campo pelo nome usado no JSON de /estado e nos comandos MQTT
+// (offset_temp, min_press, max_umid, ...). Retorna false se o nome não existir.
+bool configuracao_definir(const char *chave, float valor);
+
+// Altera o par min_<sufixo>/max_<sufixo> ("temp", "press" ou "umid") numa única versão,
+// para nenhum leitor ver só um dos dois. Retorna false se o sufixo não existir.
+bool configuracao_definir_limites(const char *sufixo, float min, float max);
+
+// Aplica de uma vez um lote "chave=valor" com qualquer subconjunto das chaves de
+// configuracao_definir, separados por '&', ';' ou nova linha (corpo de POST /config).
+// O lote é validado inteiro antes: chaves conhecidas, números finitos e min <= max nos
+// pares que ele altera. Só então é publicado, numa única versão. Retorna false, sem
+// alterar nada, se alguma parte for inválida.
+bool configuracao_definir_lote(const char *texto, size_t tam);
+
+// Offsets e limites atuais em JSON (chaves de configuracao_definir e a versão).
+// Retorna o tamanho, como snprintf.
+int configuracao_json(char *buf, size_t tam);
+
+// Volta aos valores de fábrica (nova versão)
+void configuracao_restaurar(void);
+
+#endif // CONFIGURACAO_H
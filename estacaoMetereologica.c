@@ -1,12 +1,7 @@
 #include "estacaoMetereologica.h"
 
-// Offsets de calibração para temperatura, pressão e umidade
-float offset_temp = 0.0f, offset_pressao = 0.0f, offset_umidade = 0.0f;
-
-// Limites aceitáveis para temperatura, pressão e umidade
-float min_temp = -50.0f, max_temp = 50.0f;
-float min_pressao = 100.0f, max_pressao = 1100.0f;
-float min_umidade = 0.0f, max_umidade = 100.0f;
+// Barramento dos sensores, compartilhado com a captura em rajada no núcleo 1
+auto_init_mutex(mutex_i2c);
 
 // Função que extrai um valor float da URL para o offset, com base no tipo (temp, pressao, umidade)
 // req: string da requisição HTTP recebida
@@ -54,221 +49,362 @@ int extrair_valores_limite(const char *req, const char *tipo, float *min, float
     return 0;
 }
 
-// Estrutura para manter o estado da resposta HTTP enquanto é enviada via TCP
-struct http_state
-{
-    char response[12000]; // buffer da resposta HTTP a ser enviada
-    size_t len;           // comprimento total da resposta
-    size_t sent;          // quantidade já enviada
-};
-
-// Callback chamado quando dados HTTP foram enviados pela TCP
-// arg: ponteiro para o estado HTTP
-// tpcb: ponteiro para o PCB TCP (controle da conexão)
-// len: quantidade de bytes enviados nessa chamada
-// Retorna ERR_OK para indicar sucesso
-static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+// Procura a rota na requisição e lê os parâmetros que a seguem, no formato do sscanf
+// Retorna o número de campos lidos (0 se a rota não foi encontrada)
+int extrair_parametros(const char *req, const char *rota, const char *formato, ...)
 {
-    struct http_state *hs = (struct http_state *)arg;
-    // Atualiza quantos bytes já foram enviados
-    hs->sent += len;
-    // Se enviou toda a resposta, fecha conexão e libera memória do estado
-    if (hs->sent >= hs->len)
+    const char *p = strstr(req, rota);
+    if (!p)
     {
-        tcp_close(tpcb);
-        free(hs);
+        return 0;
     }
-    return ERR_OK;
+
+    va_list args;
+    va_start(args, formato);
+    int lidos = vsscanf(p + strlen(rota), formato, args);
+    va_end(args);
+    return lidos > 0 ? lidos : 0;
 }
 
-static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+// Leituras atuais e configuração publicada, como aparecem em GET /estado
+static estado_t montar_estado(void)
 {
-    // Se não recebeu dados (p == NULL), fecha a conexão TCP
-    if (!p)
+    configuracao_t c;
+    uint32_t versao = configuracao_ler(&c);
+    return (estado_t){
+        .temperatura = leitura_temp,
+        .pressao = leitura_pressao,
+        .umidade = leitura_umidade,
+        .offset_temp = c.offset_temp,
+        .offset_pressao = c.offset_pressao,
+        .offset_umidade = c.offset_umidade,
+        .min_temp = c.min_temp,
+        .max_temp = c.max_temp,
+        .min_pressao = c.min_pressao,
+        .max_pressao = c.max_pressao,
+        .min_umidade = c.min_umidade,
+        .max_umidade = c.max_umidade,
+        .versao = versao,
+    };
+}
+
+// Grandeza pelo nome usado nas rotas (grandeza_nome), ou -1
+static int buscar_grandeza(const char *nome)
+{
+    for (int g = 0; g < NUM_GRANDEZAS; g++)
     {
-        tcp_close(tpcb);
-        return ERR_OK;
+        if (strcmp(nome, grandeza_nome((grandeza_t)g)) == 0)
+        {
+            return g;
+        }
     }
+    return -1;
+}
 
-    // Ponteiro para o payload da requisição HTTP
-    char *req = (char *)p->payload;
-
-    // Aloca memória para o estado HTTP da resposta
-    struct http_state *hs = malloc(sizeof(struct http_state));
-    if (!hs)
+// JSON de GET /calibracao: pontos (medido, referência) de cada grandeza e a versão
+static int calibracao_estado_json(char *buf, size_t tam)
+{
+    configuracao_t c;
+    uint32_t versao = configuracao_ler(&c);
+    int n = snprintf(buf, tam, "{\"versao\":%lu", (unsigned long)versao);
+    for (int g = 0; g < NUM_GRANDEZAS && n >= 0 && (size_t)n < tam; g++)
     {
-        // Falha na alocação, libera o pbuf e fecha conexão
-        pbuf_free(p);
-        tcp_close(tpcb);
-        return ERR_MEM;
+        n += snprintf(buf + n, tam - (size_t)n, ",\"%s\":", grandeza_nome((grandeza_t)g));
+        if (n >= 0 && (size_t)n < tam)
+        {
+            n += calibracao_json(&c.calibracao[g], buf + n, tam - (size_t)n);
+        }
+    }
+    if (n >= 0 && (size_t)n < tam)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "}\n");
     }
-    hs->sent = 0; // Inicializa bytes enviados com zero
+    return n;
+}
+
+// Tratador de rotas do servidor HTTP: interpreta a requisição e monta a resposta
+// requisicao: requisição HTTP completa (cabeçalhos e corpo)
+// resp: resposta a ser preenchida (o servidor cuida dos cabeçalhos e do envio)
+void tratar_requisicao_http(const http_requisicao_t *requisicao, http_resposta_t *resp)
+{
+    // Linha de requisição e cabeçalhos, onde estão a rota e os parâmetros
+    const char *req = requisicao->texto;
 
     // Ponteiro para mensagem de texto de resposta (se aplicável)
     const char *txt = NULL;
 
     // Variáveis auxiliares para capturar valores extraídos da URL
     float val1, val2;
+    long i1;
+    unsigned long u1, u2;
+    char nome[16];
 
+    // Lote de offsets e limites no corpo ("chave=valor" separados por '&', ';' ou nova
+    // linha), validado inteiro e aplicado numa única versão; responde com o resultado
+    if (strncmp(req, "POST /config ", 13) == 0)
+    {
+        if (!configuracao_definir_lote(requisicao->corpo, requisicao->tam_corpo))
+        {
+            http_resposta_texto(resp, 400, "Lote invalido: chave desconhecida, valor nao numerico ou min > max");
+            return;
+        }
+        int n = configuracao_json(resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = n > 0 && n < HTTP_TAM_CORPO_DINAMICO ? (size_t)n : 0;
+        return;
+    }
     // Verifica se a requisição atualiza o offset de temperatura
-    if (extrair_valor_offset(req, "temp", &val1))
+    else if (extrair_valor_offset(req, "temp", &val1))
     {
-        offset_temp = val1;
+        configuracao_alterar()->offset_temp = val1;
+        configuracao_publicar();
         txt = "Offset de temperatura atualizado";
     }
     // Atualiza offset de pressão
     else if (extrair_valor_offset(req, "pressao", &val1))
     {
-        offset_pressao = val1;
+        configuracao_alterar()->offset_pressao = val1;
+        configuracao_publicar();
         txt = "Offset de pressão atualizado";
     }
     // Atualiza offset de umidade
     else if (extrair_valor_offset(req, "umidade", &val1))
     {
-        offset_umidade = val1;
+        configuracao_alterar()->offset_umidade = val1;
+        configuracao_publicar();
         txt = "Offset de umidade atualizado";
     }
     // Atualiza limites de temperatura
     else if (extrair_valores_limite(req, "temp", &val1, &val2))
     {
-        min_temp = val1;
-        max_temp = val2;
+        configuracao_definir_limites("temp", val1, val2);
         txt = "Limites de temperatura atualizados";
     }
     // Atualiza limites de pressão (note que na extração usa "press")
     else if (extrair_valores_limite(req, "press", &val1, &val2))
     {
-        min_pressao = val1;
-        max_pressao = val2;
+        configuracao_definir_limites("press", val1, val2);
         txt = "Limites de pressão atualizados";
     }
     // Atualiza limites de umidade (usa "umid")
     else if (extrair_valores_limite(req, "umid", &val1, &val2))
     {
-        min_umidade = val1;
-        max_umidade = val2;
+        configuracao_definir_limites("umid", val1, val2);
         txt = "Limites de umidade atualizados";
     }
-    // Se a requisição for para consultar o estado atual (JSON)
-    else if (strstr(req, "GET /estado"))
+    // Captura em rajada: janela a partir de agora. Comandos de captura são recusados
+    // (409) enquanto a captura anterior estiver em download.
+    else if (extrair_parametros(req, "GET /rajada/janela/", "%lu", &u1) == 1)
     {
-        // Monta payload JSON com os dados atuais das leituras e configurações
-        char json_payload[512];
-        int json_len = snprintf(json_payload, sizeof(json_payload),
-                                "{"
-                                "\"x\":%.2f,"
-                                "\"y\":%.2f,"
-                                "\"z\":%.2f,"
-                                "\"offset_temp\":%.2f,"
-                                "\"offset_pressao\":%.2f,"
-                                "\"offset_umidade\":%.2f,"
-                                "\"min_temp\":%.2f,"
-                                "\"max_temp\":%.2f,"
-                                "\"min_press\":%.2f,"
-                                "\"max_press\":%.2f,"
-                                "\"min_umid\":%.2f,"
-                                "\"max_umid\":%.2f"
-                                "}",
-                                leitura_temp,
-                                leitura_pressao,
-                                leitura_umidade,
-                                offset_temp,
-                                offset_pressao,
-                                offset_umidade,
-                                min_temp,
-                                max_temp,
-                                min_pressao,
-                                max_pressao,
-                                min_umidade,
-                                max_umidade);
-
-        // Prepara cabeçalho HTTP e payload JSON para resposta
-        hs->len = snprintf(hs->response, sizeof(hs->response),
-                           "HTTP/1.1 200 OK\r\n"
-                           "Content-Type: application/json\r\n"
-                           "Content-Length: %d\r\n"
-                           "Connection: close\r\n"
-                           "\r\n"
-                           "%s",
-                           json_len, json_payload);
-
-        // Vai direto para o envio da resposta
-        goto send_response;
+        bool ok = rajada_janela(u1);
+        http_resposta_texto(resp, ok ? 200 : 409, ok ? "Captura iniciada" : "Captura ocupada");
+        return;
     }
-    else
+    // Captura em rajada: gatilho por variação de pressão (Pa/s), com histórico anterior
+    else if (extrair_parametros(req, "GET /rajada/armar/", "%ld/pre/%lu/pos/%lu", &i1, &u1, &u2) == 3)
     {
-        // Se não for nenhuma das rotas acima, retorna a página HTML padrão
-        hs->len = snprintf(hs->response, sizeof(hs->response),
-                           "HTTP/1.1 200 OK\r\n"
-                           "Content-Type: text/html\r\n"
-                           "Content-Length: %d\r\n"
-                           "Connection: close\r\n"
-                           "\r\n"
-                           "%s",
-                           (int)strlen(HTML_BODY), HTML_BODY);
-
-        // Envia resposta HTML
-        goto send_response;
+        bool ok = rajada_armar((int32_t)i1, u1, u2);
+        http_resposta_texto(resp, ok ? 200 : 409, ok ? "Captura armada" : "Captura ocupada");
+        return;
     }
-
-    // Se txt foi definido (para rotas de atualização de offset/limite), responde texto simples
-    if (txt)
+    else if (strstr(req, "GET /rajada/disparar"))
     {
-        hs->len = snprintf(hs->response, sizeof(hs->response),
-                           "HTTP/1.1 200 OK\r\n"
-                           "Content-Type: text/plain\r\n"
-                           "Content-Length: %d\r\n"
-                           "Connection: close\r\n"
-                           "\r\n"
-                           "%s",
-                           (int)strlen(txt), txt);
+        bool ok = rajada_disparar();
+        http_resposta_texto(resp, ok ? 200 : 409, ok ? "Gatilho disparado" : "Captura ocupada");
+        return;
     }
+    else if (strstr(req, "GET /rajada/parar"))
+    {
+        bool ok = rajada_parar();
+        http_resposta_texto(resp, ok ? 200 : 409, ok ? "Captura interrompida" : "Captura ocupada");
+        return;
+    }
+    // Última captura concluída, como bloco binário (rajada_formato.h), enviada sem cópia
+    // com uma reserva que o servidor devolve quando o cliente confirmar tudo
+    else if (strstr(req, "GET /rajada.bin"))
+    {
+        size_t tam;
+        const uint8_t *blob = rajada_blob_reservar(&tam);
+        if (!blob)
+        {
+            http_resposta_texto(resp, 404, "Nenhuma captura concluida");
+            return;
+        }
+        resp->tipo = "application/octet-stream";
+        resp->corpo = (const char *)blob;
+        resp->tam_corpo = tam;
+        resp->cabecalhos = "Content-Disposition: attachment; filename=\"rajada.bin\"\r\n";
+        resp->liberar = rajada_blob_soltar;
+        return;
+    }
+    // Estado da captura em rajada (JSON)
+    else if (strstr(req, "GET /rajada"))
+    {
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = rajada_estado_json(resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+        return;
+    }
+    // Gravação crua dos sensores para reprodução no host (gravacao.h)
+    else if (strstr(req, "GET /gravacao/iniciar"))
+    {
+        bool ok = gravacao_iniciar();
+        http_resposta_texto(resp, ok ? 200 : 409, ok ? "Gravacao iniciada" : "Gravacao anterior em download");
+        return;
+    }
+    else if (strstr(req, "GET /gravacao/parar"))
+    {
+        gravacao_parar();
+        txt = "Gravacao concluida";
+    }
+    // Última gravação concluída, como bloco binário (gravacao_formato.h), enviada sem
+    // cópia como /rajada.bin
+    else if (strstr(req, "GET /gravacao.bin"))
+    {
+        size_t tam;
+        const uint8_t *blob = gravacao_blob_reservar(&tam);
+        if (!blob)
+        {
+            http_resposta_texto(resp, 404, "Nenhuma gravacao concluida");
+            return;
+        }
+        resp->tipo = "application/octet-stream";
+        resp->corpo = (const char *)blob;
+        resp->tam_corpo = tam;
+        resp->cabecalhos = "Content-Disposition: attachment; filename=\"gravacao.bin\"\r\n";
+        resp->liberar = gravacao_blob_soltar;
+        return;
+    }
+    // Estado da gravação (JSON)
+    else if (strstr(req, "GET /gravacao"))
+    {
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = gravacao_estado_json(resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+        return;
+    }
+    // Regras de alerta: parâmetros "chave=valor" na query (veja alertas.h)
+    else if (extrair_parametros(req, "GET /regra/", "%lu", &u1) == 1)
+    {
+        const char *parametros = strchr(req, '?');
+        const char *fim_linha = strchr(req, '\r');
+        bool ok = parametros && (!fim_linha || parametros < fim_linha) && u1 < ALERTAS_MAX_REGRAS &&
+                  alertas_configurar((int)u1, parametros + 1);
+        http_resposta_texto(resp, ok ? 200 : 400, ok ? "Regra atualizada" : "Regra invalida");
+        return;
+    }
+    // Calibração em vários pontos de uma grandeza: "medido=a,b&referencia=x,y" na query
+    // (veja calibracao.h); listas vazias removem a calibração
+    else if (extrair_parametros(req, "GET /calibracao/", "%15[a-z]", nome) == 1)
+    {
+        const char *parametros = strchr(req, '?');
+        const char *fim_linha = strchr(req, '\r');
+        int g = buscar_grandeza(nome);
+        calibracao_t tabela;
+        bool ok = parametros && (!fim_linha || parametros < fim_linha) && g >= 0 &&
+                  calibracao_configurar(&tabela, parametros + 1);
+        if (ok)
+        {
+            // Tabela montada fora da alteração, que mascara as interrupções
+            configuracao_alterar()->calibracao[g] = tabela;
+            configuracao_publicar();
+        }
+        http_resposta_texto(resp, ok ? 200 : 400, ok ? "Calibracao atualizada" : "Calibracao invalida");
+        return;
+    }
+    // Pontos de calibração de todas as grandezas em JSON
+    else if (strstr(req, "GET /calibracao"))
+    {
+        int n = calibracao_estado_json(resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = n > 0 && n < HTTP_TAM_CORPO_DINAMICO ? (size_t)n : 0;
+        return;
+    }
+    // Lista das regras de alerta em JSON
+    else if (strstr(req, "GET /regras"))
+    {
+        resp->tipo = "application/json";
+        resp->gerador = alertas_gerar;
+        return;
+    }
+    // Sensores encontrados no boot, com local no barramento e última leitura de cada canal
+    else if (strstr(req, "GET /sensores"))
+    {
+        resp->tipo = "application/json";
+        resp->gerador = sensores_gerar;
+        return;
+    }
+    // Se a requisição for para consultar o estado atual (JSON)
+    else if (strstr(req, "GET /estado"))
+    {
+        // Resposta da última amostra, compartilhada sem cópia (ou 304 pelo ETag)
+        if (estado_resposta_preencher(requisicao, resp))
+        {
+            return;
+        }
 
-send_response:
-    // Associa o estado HTTP à conexão TCP para callbacks
-    tcp_arg(tpcb, hs);
-    // Registra callback para envio de dados TCP
-    tcp_sent(tpcb, http_sent);
-
-    // Envia os dados da resposta pela conexão TCP
-    tcp_write(tpcb, hs->response, hs->len, TCP_WRITE_FLAG_COPY);
-    tcp_output(tpcb);
-
-    // Libera buffer da requisição
-    pbuf_free(p);
-
-    return ERR_OK;
-}
-
-// Callback chamado quando uma nova conexão TCP é aceita
-static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err)
-{
-    // Define a função de callback para receber dados dessa conexão TCP
-    tcp_recv(newpcb, http_recv);
-    return ERR_OK;
-}
+        // Configuração alterada depois da amostra: monta o JSON atual nesta conexão
+        estado_t estado = montar_estado();
+        int json_len = estado_json(&estado, resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
 
-// Função que inicia o servidor HTTP na porta 80
-static void start_http_server(void)
-{
-    // Cria um novo PCB TCP (Protocolo Control Block)
-    struct tcp_pcb *pcb = tcp_new();
-    if (!pcb)
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = json_len;
+        return;
+    }
+#if RASTRO_HABILITADO
+    // Rastro de eventos em JSON para chrome://tracing ou ui.perfetto.dev
+    else if (strstr(req, "GET /rastro"))
+    {
+        resp->tipo = "application/json";
+        resp->gerador = rastro_gerar;
+        return;
+    }
+#endif
+    // Marcas d'água das pilhas, do heap e dos pools do lwIP em JSON
+    else if (strstr(req, "GET /memoria"))
+    {
+        resp->tipo = "application/json";
+        resp->gerador = memoria_gerar;
+        return;
+    }
+    // Métricas no formato texto do Prometheus, geradas em partes durante o envio
+    else if (strstr(req, "GET /metrics"))
     {
-        printf("Erro ao criar PCB TCP\n");
+        resp->tipo = "text/plain; version=0.0.4";
+        resp->gerador = metricas_gerar;
         return;
     }
-    // Vincula o PCB TCP à porta 80, qualquer IP
-    if (tcp_bind(pcb, IP_ADDR_ANY, 80) != ERR_OK)
+    // Renderizador de gráficos: conteúdo fixo, versionado na URL, com cache longo no navegador
+    else if (strstr(req, "GET /grafico.js"))
     {
-        printf("Erro ao ligar o servidor na porta 80\n");
+        resp->tipo = "application/javascript";
+        resp->corpo = GRAFICO_JS;
+        resp->tam_corpo = sizeof(GRAFICO_JS) - 1;
+        resp->cabecalhos = "Cache-Control: public, max-age=31536000, immutable\r\n";
         return;
     }
-    // Coloca o PCB para escutar conexões entrantes
-    pcb = tcp_listen(pcb);
-    // Define o callback para aceitar novas conexões TCP
-    tcp_accept(pcb, connection_callback);
-    printf("Servidor HTTP rodando na porta 80...\n");
+    else
+    {
+        // Se não for nenhuma das rotas acima, retorna a página HTML padrão (sem cópia)
+        resp->tipo = "text/html";
+        resp->corpo = HTML_BODY;
+        resp->tam_corpo = sizeof(HTML_BODY) - 1;
+        return;
+    }
+
+    // Rotas de atualização de offset/limite respondem texto simples
+    http_resposta_texto(resp, 200, txt);
+}
+
+// Aplica um comando "chave=valor" recebido no tópico MQTT de comandos.
+// As chaves são as mesmas usadas no JSON de /estado.
+// Retorna true se a chave foi reconhecida
+bool aplicar_comando_mqtt(const char *chave, float valor)
+{
+    return configuracao_definir(chave, valor);
 }
 
 #include "pico/bootrom.h"
@@ -284,13 +420,8 @@ void gpio_irq_handler(uint gpio, uint32_t events)
         if (absolute_time_diff_us(last_interrupt_time_botao_a, now) > DEBOUNCE_MS * 1000)
         {
             last_interrupt_time_botao_a = now;
-            // Offsets de calibração para temperatura, pressão e umidade
-            offset_temp = 0.0f, offset_pressao = 0.0f, offset_umidade = 0.0f;
-
-            // Limites aceitáveis para temperatura, pressão e umidade
-            min_temp = -50.0f, max_temp = 50.0f;
-            min_pressao = 100.0f, max_pressao = 1100.0f;
-            min_umidade = 0.0f, max_umidade = 100.0f;
+            // Volta offsets e limites aos valores de fábrica
+            configuracao_restaurar();
         }
     }
     else if (gpio == BOTAO_B)
@@ -303,6 +434,15 @@ void gpio_irq_handler(uint gpio, uint32_t events)
             reset_usb_boot(0, 0);
         }
     }
+    else if (gpio == BOTAO_JOYSTICK)
+    {
+        if (absolute_time_diff_us(last_interrupt_time_botao_joystick, now) > DEBOUNCE_MS * 1000)
+        {
+            last_interrupt_time_botao_joystick = now;
+            // Só escolhe a página; o desenho fica com tarefa_display
+            pagina_display = (pagina_display + 1) % NUM_PAGINAS;
+        }
+    }
 }
 
 // Configura o PIO para uso com matriz de LEDs 5x5
@@ -409,7 +549,14 @@ void desenha_fig(uint32_t *_matriz, uint8_t _intensidade, PIO pio, uint sm) // F
     }
 }
 
-// Função para tocar o buzzer com PWM por uma duração determinada e acender um LED associado
+// Estado do aviso sonoro/luminoso em andamento (o buzzer é desligado por atualizar_buzzer)
+static absolute_time_t fim_buzzer;
+static bool buzzer_ligado = false;
+static int led_buzzer = -1;
+static bool matriz_acesa = false;
+
+// Liga o buzzer com PWM e acende um LED associado, sem bloquear: o desligamento
+// acontece em atualizar_buzzer, chamada periodicamente pela tarefa de manutenção
 // duracao_ms: tempo em milissegundos para buzzer tocar
 // led_gpio: pino GPIO do LED a acender; -1 para nenhum LED
 void tocar_pwm_buzzer(uint duracao_ms, int led_gpio)
@@ -417,69 +564,58 @@ void tocar_pwm_buzzer(uint duracao_ms, int led_gpio)
     uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
     pwm_set_enabled(slice_num, true); // Liga o PWM do buzzer
 
-    // Inicializa e acende o LED se led_gpio válido
-    gpio_init(led_gpio);
-    gpio_set_dir(led_gpio, GPIO_OUT);
-    gpio_put(led_gpio, 1); // Acende o LED
-
-    sleep_ms(duracao_ms); // Aguarda o tempo determinado
+    // Acende o LED se led_gpio válido (já configurado como saída em inicializar_leds)
+    if (led_gpio >= 0)
+    {
+        gpio_put(led_gpio, 1);
+    }
 
-    // Desliga o buzzer e apaga o LED
-    pwm_set_enabled(slice_num, false);
-    gpio_put(led_gpio, 0); // Apaga o LED
+    led_buzzer = led_gpio;
+    buzzer_ligado = true;
+    fim_buzzer = make_timeout_time_ms(duracao_ms);
 }
 
-// Função que monitora os alertas baseados nas leituras e limites definidos
-void monitorar_alertas()
+// Desliga buzzer e LED quando o tempo do aviso termina
+void atualizar_buzzer(void)
 {
-    alerta = false;         // Inicializa flag de alerta
-    int alertas_ativos = 0; // Contador de alertas ativos
-    int led_alerta = -1;    // Pino do LED que será acionado (inicialmente nenhum)
-
-    // Verifica se temperatura está fora dos limites
-    if (leitura_temp < min_temp || leitura_temp > max_temp)
+    if (!buzzer_ligado || absolute_time_diff_us(get_absolute_time(), fim_buzzer) > 0)
     {
-        alerta = true;
-        alertas_ativos++;
-        led_alerta = LED_RED_PIN; // LED vermelho para temperatura
+        return;
     }
 
-    // Verifica se pressão está fora dos limites
-    if (leitura_pressao < min_pressao || leitura_pressao > max_pressao)
+    pwm_set_enabled(pwm_gpio_to_slice_num(BUZZER_PIN), false);
+    if (led_buzzer >= 0)
     {
-        alerta = true;
-        alertas_ativos++;
-        led_alerta = LED_GREEN_PIN; // LED verde para pressão
+        gpio_put(led_buzzer, 0); // Apaga o LED
     }
+    buzzer_ligado = false;
+}
 
-    // Verifica se umidade está fora dos limites
-    if (leitura_umidade < min_umidade || leitura_umidade > max_umidade)
+// Aciona LEDs, buzzer e matriz conforme as regras de alerta ativas (alertas.c).
+// As regras são avaliadas a cada amostra em tarefa_aquisicao; aqui só as saídas.
+void monitorar_alertas()
+{
+    int ativas;
+    uint8_t saidas = alertas_saidas(&ativas);
+    alerta = ativas > 0;
+
+    // LED RGB na cor da regra ativa de maior prioridade, aceso enquanto ela durar
+    gpio_put(LED_RED_PIN, (saidas & SAIDA_LED_VERMELHO) != 0);
+    gpio_put(LED_GREEN_PIN, (saidas & SAIDA_LED_VERDE) != 0);
+    gpio_put(LED_BLUE_PIN, (saidas & SAIDA_LED_AZUL) != 0);
+
+    // Quadrado amarelo na matriz (redesenhada só quando muda)
+    bool matriz = (saidas & SAIDA_MATRIZ) != 0;
+    if (matriz != matriz_acesa)
     {
-        alerta = true;
-        alertas_ativos++;
-        led_alerta = LED_BLUE_PIN; // LED azul para umidade
+        desenha_fig(matriz ? alerta_matriz : matriz_apagada, BRILHO_PADRAO, pio, sm);
+        matriz_acesa = matriz;
     }
 
-    // Se algum alerta está ativo
-    if (alerta)
+    // Um bipe por execução da tarefa enquanto alguma regra pedir o buzzer
+    if (saidas & SAIDA_BUZZER)
     {
-        if (alertas_ativos == 1)
-        {
-            // Apenas 1 alerta: tocar buzzer e piscar LED correspondente
-            tocar_pwm_buzzer(500, led_alerta);
-        }
-        else
-        {
-            // Vários alertas: apenas tocar buzzer, sem LED
-            tocar_pwm_buzzer(500, -1);
-
-            // Acende matriz LED com um quadrado amarelo
-            desenha_fig(alerta_matriz, BRILHO_PADRAO, pio, sm);
-            sleep_ms(500);
-
-            // Apaga matriz LED
-            desenha_fig(matriz_apagada, BRILHO_PADRAO, pio, sm);
-        }
+        tocar_pwm_buzzer(500, -1);
     }
 }
 
@@ -513,90 +649,316 @@ void inicializar_botoes()
     gpio_set_dir(BOTAO_A, GPIO_IN);
     gpio_pull_up(BOTAO_A);
     gpio_set_irq_enabled(BOTAO_A, GPIO_IRQ_EDGE_FALL, true);
+
+    // Configura botão do joystick
+    gpio_init(BOTAO_JOYSTICK);
+    gpio_set_dir(BOTAO_JOYSTICK, GPIO_IN);
+    gpio_pull_up(BOTAO_JOYSTICK);
+    gpio_set_irq_enabled(BOTAO_JOYSTICK, GPIO_IRQ_EDGE_FALL, true);
 }
 
-// Inicializa o barramento I2C com frequência de 400kHz e configura os pinos SDA e SCL
+// Inicializa o barramento I2C com frequência de 400kHz e configura os pinos SDA e SCL.
+// Os pinos ficam registrados em i2c_bus para a recuperação de barramento preso.
 void inicializar_i2c(i2c_inst_t *i2c_port, uint sda, uint scl)
 {
-    i2c_init(i2c_port, 400 * 1000);
-    gpio_set_function(sda, GPIO_FUNC_I2C);
-    gpio_set_function(scl, GPIO_FUNC_I2C);
-    gpio_pull_up(sda);
-    gpio_pull_up(scl);
+    i2c_bus_init(i2c_port, sda, scl, 400 * 1000);
 }
 
-// Inicializa o display OLED SSD1306 e mostra mensagem inicial
+// Inicializa o display OLED SSD1306. A tela não é apagada: numa partida a quente ela
+// continua com a última página até a primeira execução de tarefa_display.
 void inicializar_display(ssd1306_t *ssd)
 {
     ssd1306_init(ssd, WIDTH, HEIGHT, false, endereco, I2C_PORT_DISP);
     ssd1306_config(ssd);
-    ssd1306_fill(ssd, false); // Limpa tela
-    ssd1306_draw_string(ssd, "Iniciando Wi-Fi", 0, 0);
-    ssd1306_draw_string(ssd, "Aguarde...", 0, 30);
-    ssd1306_send_data(ssd);
 }
 
-// Inicializa sensores BMP280 e AHT20 na interface I2C
-void inicializar_sensores(struct bmp280_calib_param *params)
+// Avisada por rede.c a cada mudança de IP (0 quando a conexão cai). Atualiza o texto
+// do display e, numa troca de endereço, reabre o servidor HTTP: as conexões do IP
+// antigo não têm mais volta.
+void ao_mudar_ip(uint32_t ip)
 {
-    bmp280_init(I2C_PORT);
-    bmp280_get_calib_params(I2C_PORT, params);
+    static uint32_t ip_anterior = 0;
+    if (ip == 0)
+    {
+        snprintf(ip_str, sizeof(ip_str), "Sem Wi-Fi");
+        return;
+    }
 
-    aht20_reset(I2C_PORT);
-    aht20_init(I2C_PORT);
+    // Converte endereço IP binário para string decimal com pontos
+    uint8_t *b = (uint8_t *)&ip;
+    snprintf(ip_str, sizeof(ip_str), "%d.%d.%d.%d", b[0], b[1], b[2], b[3]);
+    printf("Wi-Fi conectado: %s\n", ip_str);
+    if (ip_anterior != 0 && ip != ip_anterior)
+    {
+        servidor_http_reiniciar();
+    }
+    ip_anterior = ip;
 }
 
-// Função para conectar à rede Wi-Fi utilizando o chip CYW43 e exibir status no display SSD1306
-// Parâmetro: ponteiro para estrutura do display SSD1306 onde as mensagens serão exibidas
-// Retorna true se a conexão foi bem sucedida, false caso contrário
-bool conectar_wifi(ssd1306_t *ssd)
+// ============================================================================
+// === Tarefas periódicas (agendador.h) ===
+
+// Última amostra, compartilhada entre aquisição, display e estado retido
+static float temp_bmp, temp_aht;
+static bool aht_ok = false;
+static amostra_t ultima_amostra;
+
+// Coleta os sensores, atualiza as leituras e entrega a amostra à telemetria
+void tarefa_aquisicao(void)
 {
-    // Inicializa o driver/arquitetura CYW43 responsável pela interface Wi-Fi
-    // Retorna diferente de zero em caso de falha
-    if (cyw43_arch_init())
+    // Offsets e limites desta amostra, lidos uma vez para valerem juntos
+    configuracao_t config;
+    configuracao_ler(&config);
+
+    // Busca as medições disparadas na execução anterior e dispara as próximas
+    sensores_coletar();
+    uint32_t instante_ms = to_ms_since_boot(get_absolute_time());
+    gravacao_ciclo(instante_ms);
+
+    // Na primeira execução ainda não havia medição disparada: as leituras continuam
+    // as de antes (zeradas, ou as retidas numa partida a quente)
+    static bool disparadas = false;
+    if (!disparadas)
     {
-        // Se falhar na inicialização do Wi-Fi, limpa a tela do display e exibe mensagem de falha
-        ssd1306_fill(ssd, false);
-        ssd1306_draw_string(ssd, "WiFi => FALHA", 0, 0);
-        ssd1306_send_data(ssd);
-        return false; // Indica falha
+        disparadas = true;
+        return;
     }
 
-    // Configura o chip Wi-Fi para o modo estação (modo cliente)
-    cyw43_arch_enable_sta_mode();
+    // Temperatura de cada sensor principal, mostradas separadas no display
+    const sensor_t *bmp = sensores_buscar(&SENSOR_BMP280, false);
+    const sensor_t *aht = sensores_buscar(&SENSOR_AHT20, false);
+    temp_bmp = bmp ? bmp->valores[0] : 0.0f; // Mantém a última leitura válida se o BMP280 falhar
+    aht_ok = aht && aht->valido;
+    temp_aht = aht_ok ? aht->valores[0] : 0.0f;
+
+    // Média dos sensores principais de cada grandeza, com o offset configurado
+    amostra_t amostra = sensores_amostra(&config, instante_ms);
+    leitura_temp = amostra.temperatura;
+    leitura_pressao = amostra.pressao;
+    leitura_umidade = amostra.umidade;
+
+    // Entrega a amostra à telemetria (fila MQTT e beacon UDP)
+    telemetria_mqtt_amostra(&amostra);
+    telemetria_udp_amostra(&amostra);
+    grafico_amostra(&amostra);
+    ultima_amostra = amostra;
+
+    // Resposta de /estado desta amostra, formatada uma vez para todos os clientes
+    estado_t estado = montar_estado();
+    estado_resposta_atualizar(&estado);
+
+    // Regras de alerta avaliadas uma vez por amostra (as saídas ficam com tarefa_alertas)
+    uint32_t inicio = metricas_inicio();
+    alertas_avaliar(&amostra, &config);
+    metricas_registrar(METRICA_ALERTAS_AVALIAR, inicio);
+}
+
+// Envia o buffer inteiro ao display, com a transferência registrada nas métricas
+static bool enviar_display(void)
+{
+    uint32_t inicio = metricas_inicio();
+    bool ok = ssd1306_send_data(&ssd);
+    metricas_registrar(METRICA_DISPLAY_ENVIO, inicio);
+    return ok;
+}
+
+// Página de leituras: IP e última amostra de cada sensor
+static bool desenhar_leituras(void)
+{
+    char str_tmp1[8], str_tmp2[8];
+    char str_umi[8];
+    char str_alt[8];
+    bool cor = true; // Usado para inversão de cores no display
+
+    // Formata strings para mostrar no display
+    snprintf(str_tmp1, sizeof(str_tmp1), "%.1fC", temp_bmp);                        // Temperatura BMP280
+    snprintf(str_alt, sizeof(str_alt), "%.0fhPa", leitura_pressao);                 // Pressão atmosférica
+    snprintf(str_tmp2, sizeof(str_tmp2), aht_ok ? "%.1fC" : "--", temp_aht);        // Temperatura AHT20 ou "--"
+    snprintf(str_umi, sizeof(str_umi), aht_ok ? "%.1f%%" : "--", leitura_umidade); // Umidade ou "--"
+
+    // Atualiza display OLED com informações formatadas
+    ssd1306_fill(&ssd, !cor);                     // Preenche fundo com cor invertida
+    ssd1306_rect(&ssd, 3, 3, 122, 60, cor, !cor); // Desenha retângulo
+    ssd1306_line(&ssd, 3, 25, 123, 25, cor);      // Linhas divisórias
+    ssd1306_line(&ssd, 3, 37, 123, 37, cor);
+
+    ssd1306_draw_string(&ssd, ip_str, 15, 12);          // IP da rede Wi-Fi
+    ssd1306_draw_string(&ssd, "BMP280  AHT10", 10, 28); // Cabeçalho sensores
+    ssd1306_line(&ssd, 63, 25, 63, 60, cor);            // Linha vertical divisória
+    ssd1306_draw_string(&ssd, str_tmp1, 14, 41);        // Temp BMP280
+    ssd1306_draw_string(&ssd, str_alt, 14, 52);         // Pressão
+    ssd1306_draw_string(&ssd, str_tmp2, 73, 41);        // Temp AHT20
+    ssd1306_draw_string(&ssd, str_umi, 73, 52);         // Umidade
+
+    return enviar_display(); // Envia dados para o display
+}
+
+// Página de destaque: temperatura em dígitos de 32 linhas, umidade em 16 e pressão
+// em 8. O texto fica alinhado às páginas do display, então cada coluna de glifo é
+// copiada direto para o buffer.
+static bool desenhar_destaque(void)
+{
+    char str_temp[8], str_umi[8], str_pressao[16];
+    snprintf(str_temp, sizeof(str_temp), "%.1f", leitura_temp);
+    snprintf(str_umi, sizeof(str_umi), aht_ok ? "%.1f%%" : "--", leitura_umidade);
+    snprintf(str_pressao, sizeof(str_pressao), "%.0fhPa", leitura_pressao);
+
+    ssd1306_fill(&ssd, false);
+
+    // Número alinhado à direita, encostado na unidade
+    const ssd1306_font_t *digitos = &ssd1306_font_digits_24x32;
+    uint8_t largura = ssd1306_text_width(digitos, str_temp);
+    uint8_t x_unidade = WIDTH - ssd1306_font_16x16.width - 4;
+    ssd1306_draw_text(&ssd, digitos, str_temp, largura < x_unidade ? x_unidade - largura : 0, 0);
+    ssd1306_draw_text(&ssd, &ssd1306_font_16x16, "C", x_unidade, 0);
+
+    ssd1306_draw_text(&ssd, &ssd1306_font_16x16, str_umi, 0, 40);
+    ssd1306_draw_text(&ssd, &ssd1306_font_8x8, str_pressao, WIDTH - ssd1306_text_width(&ssd1306_font_8x8, str_pressao), 56);
 
-    // Tenta conectar na rede Wi-Fi usando SSID e senha, com timeout de 10 segundos
-    // Retorna diferente de zero em caso de erro na conexão
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, 10000))
+    return enviar_display();
+}
+
+// Atualiza a página escolhida pelo botão do joystick. As de leituras e destaque são
+// redesenhadas a cada execução; a de tendência só quando entra na tela, e depois
+// recebe uma coluna por ponto novo.
+//
+// Se um envio falha (display ausente ou barramento preso), o display é deixado em
+// paz por um recuo que dobra a cada falha, para não ocupar o núcleo com timeouts; a
+// volta passa por ssd1306_config, porque o display pode ter reiniciado.
+void tarefa_display(void)
+{
+    static pagina_display_t pagina_desenhada = NUM_PAGINAS;
+    static bool reconfigurar = false;
+    static uint16_t espera = 0, recuo = 0;
+
+    if (espera > 0)
     {
-        // Se falhar na conexão, limpa tela e exibe mensagem de erro
-        ssd1306_fill(ssd, false);
-        ssd1306_draw_string(ssd, "WiFi => ERRO", 0, 0);
-        ssd1306_send_data(ssd);
-        return false; // Indica falha
+        espera--;
+        return;
     }
 
-    // Recupera o endereço IP atribuído à interface após conexão bem sucedida
-    uint8_t *ip = (uint8_t *)&(cyw43_state.netif[0].ip_addr.addr);
+    pagina_display_t pagina = pagina_display;
+    if (pagina == PAGINA_TENDENCIA && pagina == pagina_desenhada && !grafico_pendente())
+    {
+        return; // Nenhum ponto novo: nada a enviar
+    }
 
-    // Converte endereço IP binário para string decimal com pontos
-    snprintf(ip_str, sizeof(ip_str), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+    uint32_t inicio = metricas_inicio();
+    bool ok = !reconfigurar || ssd1306_config(&ssd);
+    if (ok && pagina == PAGINA_LEITURAS)
+    {
+        ok = desenhar_leituras();
+    }
+    else if (ok && pagina == PAGINA_DESTAQUE)
+    {
+        ok = desenhar_destaque();
+    }
+    else if (ok)
+    {
+        ok = pagina == pagina_desenhada ? grafico_atualizar(&ssd) : grafico_desenhar(&ssd);
+    }
+    metricas_registrar(METRICA_DISPLAY_PAGINA, inicio);
 
-    // Limpa o display e mostra mensagem de sucesso com o IP obtido
-    ssd1306_fill(ssd, false);
-    ssd1306_draw_string(ssd, "WiFi => OK", 0, 0);
-    ssd1306_draw_string(ssd, ip_str, 0, 10);
-    ssd1306_send_data(ssd);
+    if (!ok)
+    {
+        recuo = recuo == 0 ? 1 : (recuo * 2 > DISPLAY_RECUO_MAX ? DISPLAY_RECUO_MAX : recuo * 2);
+        espera = recuo;
+        reconfigurar = true;
+        pagina_desenhada = NUM_PAGINAS; // Conteúdo incerto: a próxima vez desenha tudo
+        return;
+    }
+    recuo = 0;
+    reconfigurar = false;
+    pagina_desenhada = pagina;
+}
 
-    // Retorna true indicando que conexão foi estabelecida com sucesso
-    return true;
+// Monitora os alertas baseados nos limites e aciona buzzer/LEDs se necessário
+void tarefa_alertas(void)
+{
+    uint32_t inicio = metricas_inicio();
+    monitorar_alertas();
+    metricas_registrar(METRICA_ALERTAS_SAIDAS, inicio);
+}
+
+// Serviços de fundo: pilha Wi-Fi, publicação MQTT, fim dos avisos e console
+void tarefa_manutencao(void)
+{
+    // Processa eventos da pilha Wi-Fi CYW43 (necessário para manter conexão)
+    cyw43_arch_poll();
+
+    // Conexão Wi-Fi: tentativas com recuo, quedas e troca de IP
+    rede_processar();
+
+    // Conecta ao broker e publica as amostras enfileiradas; sem rede, elas esperam
+    // na fila (as mais antigas são descartadas se ela encher)
+    if (rede_estado() == REDE_CONECTADA)
+    {
+        telemetria_mqtt_processar();
+    }
+
+    // Desliga buzzer/LED/matriz quando o aviso termina
+    atualizar_buzzer();
+
+#if RASTRO_HABILITADO
+    // Tecla 't' no terminal USB despeja o rastro em JSON
+    if (getchar_timeout_us(0) == 't')
+    {
+        rastro_imprimir();
+    }
+#endif
+}
+
+// Guarda o estado para uma partida a quente e alimenta o watchdog se todas as
+// tarefas rodaram há pouco (supervisor.h). Copia ~1,5 KB por execução.
+void tarefa_supervisor(void)
+{
+    estado_retido_t *retido = supervisor_alterar();
+    configuracao_ler(&retido->config);
+    retido->amostra = ultima_amostra;
+    alertas_exportar(retido->regras);
+    grafico_exportar(&retido->grafico);
+    supervisor_publicar();
+
+    supervisor_verificar();
+}
+
+// Retoma o estado de antes de um reset do watchdog
+static void restaurar_estado(const estado_retido_t *retido)
+{
+    *configuracao_alterar() = retido->config;
+    configuracao_publicar();
+    alertas_restaurar(retido->regras);
+    grafico_restaurar(&retido->grafico);
+
+    // Leituras mostradas no display e em /estado até a primeira coleta
+    ultima_amostra = retido->amostra;
+    leitura_temp = temp_bmp = temp_aht = retido->amostra.temperatura;
+    leitura_pressao = retido->amostra.pressao;
+    leitura_umidade = retido->amostra.umidade;
+    aht_ok = retido->amostra.umidade_valida;
 }
 
 int main()
 {
+    // Pinta as pilhas antes de qualquer outra chamada, para as marcas d'água de /memoria
+    memoria_iniciar();
+
+    // Estado guardado antes de um reset do watchdog (NULL na partida a frio); precisa
+    // ser lido antes de a primeira tarefa_supervisor reaproveitar os blocos
+    const estado_retido_t *retido = supervisor_partida();
+
     // Inicializa stdio (UART) para debug/console
     stdio_init_all();
-    sleep_ms(2000); // Aguarda 2 segundos para estabilidade
+    if (retido)
+    {
+        restaurar_estado(retido);
+        printf("Partida a quente: %lu reinicio(s) pelo watchdog, causa: %s\n",
+               (unsigned long)supervisor_reinicios(), supervisor_causa());
+    }
+    else
+    {
+        sleep_ms(2000); // Aguarda 2 segundos para estabilidade (terminal USB)
+    }
 
     // Inicializa botões, barramentos I2C para display e sensores
     inicializar_botoes();
@@ -609,96 +971,60 @@ int main()
     inicializar_leds(); // LEDs indicadoras
 
     // Inicializa display OLED SSD1306
-    ssd1306_t ssd;
     inicializar_display(&ssd);
 
-    // Inicializa sensores BMP280 e AHT20 (sensor de temperatura/pressão e umidade)
-    struct bmp280_calib_param params;
-    inicializar_sensores(&params);
+    // Procura sensores nas duas portas I2C e atrás de multiplexadores TCA9548A
+    i2c_inst_t *const portas_i2c[] = {I2C_PORT, I2C_PORT_DISP};
+    sensores_iniciar(portas_i2c, 2, &mutex_i2c);
 
-    // Conecta à rede Wi-Fi, mostra status no display; aborta se falhar
-    if (!conectar_wifi(&ssd))
+    // Regras de alerta padrão, acompanhando os limites min/max configuráveis; na
+    // partida a quente, as que estavam em uso
+    if (!retido)
     {
-        return 1;
+        alertas_iniciar();
     }
 
-    // Inicia servidor HTTP para receber comandos e enviar estado
-    start_http_server();
-
-    // Variáveis auxiliares para leitura dos sensores e formatação de strings
-    AHT20_Data data;
-    int32_t raw_temp_bmp;
-    int32_t raw_pressure;
-
-    char str_tmp1[5], str_tmp2[5];
-    char str_umi[5];
-    char str_alt[5];
-    char str_x[5], str_y[5];
-    bool cor = true; // Usado para inversão de cores no display para piscar
-
-    // Apaga matriz de LEDs ao iniciar
-    desenha_fig(matriz_apagada, BRILHO_PADRAO, pio, sm);
-
-    // Loop principal infinito
-    while (true)
+    // Captura em rajada no núcleo 1 (parada até receber um comando), com o primeiro
+    // BMP280 ligado direto: o núcleo 1 não mexe nos multiplexadores
+    sensor_t *bmp_rajada = sensores_buscar(&SENSOR_BMP280, true);
+    if (bmp_rajada)
     {
-        // Processa eventos da pilha Wi-Fi CYW43 (necessário para manter conexão)
-        cyw43_arch_poll();
-
-        // Lê valores brutos do BMP280 (temperatura e pressão)
-        int32_t raw_temp_bmp, raw_pressure;
-        bmp280_read_raw(I2C_PORT, &raw_temp_bmp, &raw_pressure);
-
-        // Converte valores brutos para temperatura em centésimos de grau e pressão em Pa
-        int32_t temperature_bmp = bmp280_convert_temp(raw_temp_bmp, &params);
-        int32_t pressure = bmp280_convert_pressure(raw_pressure, raw_temp_bmp, &params);
-
-        // Lê dados do sensor AHT20 (temperatura e umidade)
-        AHT20_Data data;
-        bool aht_ok = aht20_read(I2C_PORT, &data);
-
-        // Extrai temperatura do AHT20 (0 se erro)
-        float temp_aht = aht_ok ? data.temperature : 0.0f;
-
-        // Converte temperatura BMP280 para graus Celsius
-        float temp_bmp = temperature_bmp / 100.0f;
-
-        // Calcula a média das temperaturas dos dois sensores, aplica offset configurado
-        leitura_temp = ((temp_bmp + temp_aht) / 2.0f) + offset_temp;
-
-        // Atualiza pressão e aplica offset configurado
-        leitura_pressao = (pressure / 100.0f) + offset_pressao;
-
-        // Atualiza umidade (0 se erro no sensor), aplica offset configurado
-        leitura_umidade = aht_ok ? data.humidity + offset_umidade : 0.0f;
+        rajada_iniciar(bmp_rajada->i2c, &bmp_rajada->bruto.bmp280.calib, &mutex_i2c);
+    }
 
-        // Formata strings para mostrar no display
-        sprintf(str_tmp1, "%.1fC", temp_bmp);                        // Temperatura BMP280
-        sprintf(str_alt, "%.0fhPa", leitura_pressao);                // Pressão atmosférica
-        sprintf(str_tmp2, aht_ok ? "%.1fC" : "--", temp_aht);        // Temperatura AHT20 ou "--"
-        sprintf(str_umi, aht_ok ? "%.1f%%" : "--", leitura_umidade); // Umidade ou "--"
+    // Wi-Fi em segundo plano (rede.h): medição, display e alertas começam já e seguem
+    // com ou sem rede; o IP aparece no display quando o enlace subir
+    snprintf(ip_str, sizeof(ip_str), "Conectando...");
+    if (rede_iniciar(WIFI_SSID, WIFI_PASS, ao_mudar_ip))
+    {
+        // Inicia servidor HTTP para receber comandos e enviar estado (escuta em
+        // qualquer IP, então pode começar antes da conexão)
+        servidor_http_iniciar(HTTP_PORTA, tratar_requisicao_http);
 
-        // Atualiza display OLED com informações formatadas
-        ssd1306_fill(&ssd, !cor);                     // Preenche fundo com cor invertida
-        ssd1306_rect(&ssd, 3, 3, 122, 60, cor, !cor); // Desenha retângulo
-        ssd1306_line(&ssd, 3, 25, 123, 25, cor);      // Linhas divisórias
-        ssd1306_line(&ssd, 3, 37, 123, 37, cor);
+        // Prepara o publicador MQTT (a conexão com o broker é feita em segundo plano)
+        telemetria_mqtt_iniciar(aplicar_comando_mqtt);
 
-        ssd1306_draw_string(&ssd, ip_str, 15, 12);          // IP da rede Wi-Fi
-        ssd1306_draw_string(&ssd, "BMP280  AHT10", 10, 28); // Cabeçalho sensores
-        ssd1306_line(&ssd, 63, 25, 63, 60, cor);            // Linha vertical divisória
-        ssd1306_draw_string(&ssd, str_tmp1, 14, 41);        // Temp BMP280
-        ssd1306_draw_string(&ssd, str_alt, 14, 52);         // Pressão
-        ssd1306_draw_string(&ssd, str_tmp2, 73, 41);        // Temp AHT20
-        ssd1306_draw_string(&ssd, str_umi, 73, 52);         // Umidade
+        // Beacon UDP binário para coleta em frota (destino em telemetria_udp.h)
+        telemetria_udp_iniciar();
+    }
+    else
+    {
+        snprintf(ip_str, sizeof(ip_str), "Wi-Fi falhou"); // Sem driver, sem pilha de rede
+    }
 
-        ssd1306_send_data(&ssd); // Envia dados para o display
+    // Apaga matriz de LEDs ao iniciar
+    desenha_fig(matriz_apagada, BRILHO_PADRAO, pio, sm);
 
-        // Monitora os alertas baseados nos limites e aciona buzzer/LEDs se necessário
-        monitorar_alertas();
+    // Cada subsistema roda no seu próprio ritmo; entre as tarefas o núcleo dorme
+    agendador_adicionar("aquisicao", tarefa_aquisicao, PERIODO_AQUISICAO_MS, PRAZO_AQUISICAO_MS);
+    agendador_adicionar("display", tarefa_display, PERIODO_DISPLAY_MS, PRAZO_DISPLAY_MS);
+    agendador_adicionar("alertas", tarefa_alertas, PERIODO_ALERTAS_MS, PRAZO_ALERTAS_MS);
+    agendador_adicionar("manutencao", tarefa_manutencao, PERIODO_MANUTENCAO_MS, PRAZO_MANUTENCAO_MS);
+    agendador_adicionar("supervisor", tarefa_supervisor, PERIODO_SUPERVISOR_MS, PRAZO_SUPERVISOR_MS);
 
-        sleep_ms(500); // Espera 500ms antes de nova leitura
-    }
+    // Daqui em diante, uma tarefa presa ou atrasada reinicia a placa (a quente)
+    supervisor_iniciar();
+    agendador_executar(); // Não retorna
 
     // Finaliza o driver Wi-Fi (não alcançado neste código)
     cyw43_arch_deinit();
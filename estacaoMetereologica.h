@@ -5,6 +5,7 @@
 // === Bibliotecas do SDK do Raspberry Pi Pico ===
 #include "pico/stdlib.h"
 #include "pico/cyw43_arch.h"
+#include "pico/mutex.h"
 
 // === Bibliotecas de hardware ===
 #include "hardware/i2c.h"
@@ -16,20 +17,39 @@
 
 // === Biblioteca de rede (TCP/IP via LWIP) ===
 #include "lwip/tcp.h"
+#include "servidor_http.h"   // Conexões HTTP persistentes (keep-alive)
+#include "telemetria_mqtt.h" // Publicação de amostras via MQTT
+#include "telemetria_udp.h"  // Beacon UDP binário para coleta em frota
+#include "metricas.h"        // Contadores e histogramas exportados em /metrics
+#include "memoria.h"         // Marcas d'água de pilhas, heap e lwIP em /memoria
+#include "rastro.h"          // Rastro de eventos (cmake -DRASTRO=ON)
+#include "estado_json.h"     // JSON de GET /estado
+#include "estado_resposta.h" // Resposta de GET /estado montada uma vez por amostra
+#include "agendador.h"       // Tarefas periódicas do laço principal
+#include "rajada.h"          // Captura em rajada do BMP280 (núcleo 1)
+#include "alertas.h"         // Regras de alerta
+#include "configuracao.h"     // Offsets e limites publicados com versão
+#include "sensores.h"         // Registro dos sensores I2C (com multiplexador)
+#include "grafico.h"          // Página de tendência do display
+#include "supervisor.h"       // Watchdog e estado retido para a partida a quente
+#include "rede.h"             // Conexão Wi-Fi em segundo plano
+#include "gravacao.h"         // Gravação crua dos sensores para reprodução no host
 
 // === Bibliotecas padrão da linguagem C ===
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <stdarg.h>
 
 // === Bibliotecas de dispositivos externos ===
 #include "ssd1306.h" // Display OLED
+#include "i2c_bus.h" // I2C com timeout e recuperação do barramento
 #include "aht20.h"   // Sensor de umidade e temperatura
 #include "bmp280.h"  // Sensor de pressão e temperatura
 
 // === Bibliotecas auxiliares do projeto ===
-#include "font.h"           // Fonte do display
+#include "ssd1306_font.h"    // Fontes do display (8x8, 16x16 e dígitos 24x32)
 #include "index.h"          // Página HTML para o servidor web
 #include "lib/matriz_5X5.h" // Matriz de LEDs 5x5 WS2812
 #include "pio_wave.pio.h"   // Programa PIO para buzzer
@@ -38,6 +58,7 @@
 // === Definições de pinos e periféricos ===
 #define LED_PIN 12 // LED de status
 #define BOTAO_A 5  // Botão A
+#define BOTAO_JOYSTICK 22 // Botão do joystick: troca a página do display
 #define MATRIZ_PIN 7
 #define NUM_PIXELS 25
 #define BRILHO_PADRAO 50
@@ -62,6 +83,21 @@
 #define I2C_SCL_DISP 15
 #define endereco 0x3C // Endereço I2C do SSD1306
 
+// === Períodos e prazos das tarefas (ms) ===
+// O prazo conta a partir da liberação; execuções que terminam depois dele são
+// contadas em estacao_agendador_prazos_perdidos_total (/metrics).
+#define PERIODO_AQUISICAO_MS 500 // Leitura dos sensores e envio da amostra
+#define PRAZO_AQUISICAO_MS 200   // A conversão do AHT20 sozinha leva ~80 ms
+#define PERIODO_DISPLAY_MS 250
+#define PRAZO_DISPLAY_MS 100
+#define DISPLAY_RECUO_MAX 64     // Execuções puladas, no máximo, após falhas seguidas do display (16 s)
+#define PERIODO_ALERTAS_MS 1000
+#define PRAZO_ALERTAS_MS 200
+#define PERIODO_MANUTENCAO_MS 50 // Wi-Fi, MQTT, fim do buzzer e console
+#define PRAZO_MANUTENCAO_MS 100 // Tolera uma aquisição inteira na frente
+#define PERIODO_SUPERVISOR_MS 250 // Cópia do estado retido e alimentação do watchdog
+#define PRAZO_SUPERVISOR_MS 100
+
 // === Parâmetro de referência para altitude ===
 #define SEA_LEVEL_PRESSURE 101325.0 // em Pascal
 
@@ -71,8 +107,7 @@
 
 // ============================================================================
 // === Variáveis globais ===
-ssd1306_t ssd;                    // Instância do display OLED
-struct bmp280_calib_param params; // Parâmetros de calibração do BMP280
+ssd1306_t ssd; // Instância do display OLED
 
 float leitura_temp;    // Temperatura (°C)
 float leitura_pressao; // Pressão (Pa)
@@ -83,11 +118,23 @@ PIO pio;        // Instância do PIO
 int sm;         // Máquina de estado PIO
 uint slice_num; // Canal PWM usado
 
-char ip_str[24]; // IP da rede em formato string
+char ip_str[24]; // IP da rede em formato string, ou o estado da conexão
 
 // Variáveis para armazenar o último tempo da interrupção para debounce
 static absolute_time_t last_interrupt_time_botao_a = {0};
 static absolute_time_t last_interrupt_time_botao_b = {0};
+static absolute_time_t last_interrupt_time_botao_joystick = {0};
+
+// Páginas do display, trocadas em sequência pelo botão do joystick
+typedef enum
+{
+    PAGINA_LEITURAS,  // IP e últimas leituras de cada sensor
+    PAGINA_DESTAQUE,  // Temperatura e umidade em fonte grande, legíveis de longe
+    PAGINA_TENDENCIA, // Gráficos de temperatura e pressão (grafico.h)
+    NUM_PAGINAS
+} pagina_display_t;
+
+static volatile pagina_display_t pagina_display = PAGINA_LEITURAS;
 
 // ============================================================================
 // === Protótipos de funções utilitárias ===
@@ -96,6 +143,9 @@ static absolute_time_t last_interrupt_time_botao_b = {0};
 double calculate_altitude(double pressure); // Calcula altitude com base na pressão
 int extrair_valor_offset(const char *req, const char *tipo, float *valor);
 int extrair_valores_limite(const char *req, const char *tipo, float *min, float *max);
+int extrair_parametros(const char *req, const char *rota, const char *formato, ...);
+void tratar_requisicao_http(const http_requisicao_t *requisicao, http_resposta_t *resp);
+bool aplicar_comando_mqtt(const char *chave, float valor);
 
 // === Inicializações gerais ===
 void configurar_matriz_leds(void);
@@ -104,15 +154,22 @@ void inicializar_leds(void);
 void inicializar_botoes(void);
 void inicializar_i2c(i2c_inst_t *i2c_port, uint sda, uint scl);
 void inicializar_display(ssd1306_t *ssd);
-void inicializar_sensores(struct bmp280_calib_param *params);
-bool conectar_wifi(ssd1306_t *ssd);
 
 // === Lógica da estação ===
 void monitorar_alertas(void);
+void ao_mudar_ip(uint32_t ip); // Callback de rede.h
+
+// === Tarefas periódicas ===
+void tarefa_aquisicao(void);
+void tarefa_display(void);
+void tarefa_alertas(void);
+void tarefa_manutencao(void);
+void tarefa_supervisor(void);
 
 // === Controle de dispositivos ===
 void desenha_fig(uint32_t *_matriz, uint8_t _intensidade, PIO pio, uint sm);
 void tocar_pwm_buzzer(uint duracao_ms, int led_gpio);
+void atualizar_buzzer(void);
 
 // === Interrupções ===
 void gpio_irq_handler(uint gpio, uint32_t events);
@@ -0,0 +1,38 @@
+#include "estado_json.h"
+
+#include <stdio.h>
+
+// Monta o JSON de /estado em 'buf'. Retorna o tamanho, como snprintf.
+// As chaves x/y/z são as leituras usadas pelos gráficos da página.
+int estado_json(const estado_t *e, char *buf, size_t tam)
+{
+    return snprintf(buf, tam,
+                    "{"
+                    "\"x\":%.2f,"
+                    "\"y\":%.2f,"
+                    "\"z\":%.2f,"
+                    "\"offset_temp\":%.2f,"
+                    "\"offset_pressao\":%.2f,"
+                    "\"offset_umidade\":%.2f,"
+                    "\"min_temp\":%.2f,"
+                    "\"max_temp\":%.2f,"
+                    "\"min_press\":%.2f,"
+                    "\"max_press\":%.2f,"
+                    "\"min_umid\":%.2f,"
+                    "\"max_umid\":%.2f,"
+                    "\"versao\":%lu"
+                    "}",
+                    e->temperatura,
+                    e->pressao,
+                    e->umidade,
+                    e->offset_temp,
+                    e->offset_pressao,
+                    e->offset_umidade,
+                    e->min_temp,
+                    e->max_temp,
+                    e->min_pressao,
+                    e->max_pressao,
+                    e->min_umidade,
+                    e->max_umidade,
+                    (unsigned long)e->versao);
+}
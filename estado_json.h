@@ -0,0 +1,21 @@
+#ifndef ESTADO_JSON_H // Previne múltiplas inclusões do cabeçalho
+#define ESTADO_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Leituras atuais e configuração publicadas em GET /estado
+typedef struct
+{
+    float temperatura, pressao, umidade;
+    float offset_temp, offset_pressao, offset_umidade;
+    float min_temp, max_temp;
+    float min_pressao, max_pressao;
+    float min_umidade, max_umidade;
+    uint32_t versao; // Versão da configuração (configuracao.h)
+} estado_t;
+
+// Monta o JSON de /estado em 'buf'. Retorna o tamanho, como snprintf.
+int estado_json(const estado_t *e, char *buf, size_t tam);
+
+#endif // ESTADO_JSON_H
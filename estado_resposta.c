@@ -0,0 +1,132 @@
+#include "estado_resposta.h"
+#include "http_requisicao.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/cyw43_arch.h"
+#include "configuracao.h"
+
+_Static_assert(ESTADO_RESPOSTA_TAM <= HTTP_TAM_CORPO_DINAMICO, "corpo compartilhado precisa caber em 'dinamico'");
+
+// Resposta pronta de uma amostra. Imutável enquanto for a atual ou tiver referências.
+typedef struct
+{
+    volatile uint16_t refs; // Conexões cujo envio ainda aponta para o corpo
+    uint32_t versao;        // Versão da configuração usada no JSON
+    char etag[11];          // "xxxxxxxx", com as aspas
+    char cabecalhos[64];    // ETag e Cache-Control, prontos para servidor_http
+    size_t tam;
+    char corpo[ESTADO_RESPOSTA_TAM];
+} versao_estado_t;
+
+static versao_estado_t versoes[ESTADO_RESPOSTA_VERSOES];
+static volatile int atual = -1; // Índice publicado (-1: nenhum ainda)
+
+// Hash FNV-1a do corpo: o ETag muda com o conteúdo e não se repete após um reboot
+static uint32_t hash_corpo(const char *dados, size_t tam)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tam; i++)
+    {
+        h = (h ^ (uint8_t)dados[i]) * 16777619u;
+    }
+    return h;
+}
+
+// Devolve a referência tomada em estado_resposta_preencher (contexto do lwIP)
+static void soltar(void *ref)
+{
+    ((versao_estado_t *)ref)->refs--;
+}
+
+// O ETag atual aparece na lista do If-None-Match (ou ela é "*")
+static bool etag_confere(const char *lista, size_t tam, const char *etag)
+{
+    size_t tam_etag = strlen(etag);
+    if (tam == 1 && lista[0] == '*')
+    {
+        return true;
+    }
+    for (size_t i = 0; i + tam_etag <= tam; i++)
+    {
+        if (memcmp(lista + i, etag, tam_etag) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void estado_resposta_atualizar(const estado_t *e)
+{
+    // Só o laço principal troca 'atual', e um buffer fora dele não ganha referências:
+    // o escolhido pode ser escrito sem segurar o lwIP
+    int livre = -1;
+    for (int i = 0; i < ESTADO_RESPOSTA_VERSOES; i++)
+    {
+        if (i != atual && versoes[i].refs == 0)
+        {
+            livre = i;
+            break;
+        }
+    }
+    if (livre < 0)
+    {
+        return;
+    }
+
+    versao_estado_t *v = &versoes[livre];
+    int tam = estado_json(e, v->corpo, sizeof(v->corpo));
+    if (tam <= 0 || (size_t)tam >= sizeof(v->corpo))
+    {
+        return;
+    }
+    v->tam = (size_t)tam;
+    v->versao = e->versao;
+
+    // Mesmo JSON da versão publicada: ela continua valendo, com o mesmo ETag
+    if (atual >= 0 && versoes[atual].tam == v->tam && memcmp(versoes[atual].corpo, v->corpo, v->tam) == 0)
+    {
+        return;
+    }
+
+    char etag[sizeof(v->etag)];
+    snprintf(etag, sizeof(etag), "\"%08lx\"", (unsigned long)hash_corpo(v->corpo, v->tam));
+    memcpy(v->etag, etag, sizeof(etag));
+    snprintf(v->cabecalhos, sizeof(v->cabecalhos), "ETag: %s\r\nCache-Control: no-cache\r\n", etag);
+
+    cyw43_arch_lwip_begin();
+    atual = livre;
+    cyw43_arch_lwip_end();
+}
+
+bool estado_resposta_preencher(const http_requisicao_t *req, http_resposta_t *resp)
+{
+    int i = atual;
+    if (i < 0 || versoes[i].versao != configuracao_versao())
+    {
+        return false;
+    }
+    versao_estado_t *v = &versoes[i];
+
+    resp->tipo = "application/json";
+    resp->cabecalhos = v->cabecalhos;
+
+    size_t tam;
+    const char *lista = http_cabecalho_valor(req->texto, "If-None-Match", &tam);
+    if (lista && etag_confere(lista, tam, v->etag))
+    {
+        resp->status = 304;
+        resp->corpo = "";
+        resp->tam_corpo = 0;
+        return true;
+    }
+
+    v->refs++;
+    resp->corpo = v->corpo;
+    resp->tam_corpo = v->tam;
+    resp->liberar = soltar;
+    resp->ref = v;
+    return true;
+}
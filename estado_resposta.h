@@ -0,0 +1,36 @@
+#ifndef ESTADO_RESPOSTA_H // Previne múltiplas inclusões do cabeçalho
+#define ESTADO_RESPOSTA_H
+
+#include <stdbool.h>
+
+#include "estado_json.h"
+#include "servidor_http.h"
+
+// Resposta de GET /estado montada uma vez por amostra, e não uma vez por requisição.
+//
+// O JSON de cada amostra (ou nova versão da configuração) é escrito num dos
+// ESTADO_RESPOSTA_VERSOES buffers, junto com o ETag (hash do corpo). Uma vez
+// publicado o buffer não muda: todas as conexões o enviam sem cópia, cada uma
+// segurando uma referência até o cliente confirmar os bytes (servidor_http.h). A
+// próxima amostra vai para um buffer sem referências; se o JSON não mudou, a versão
+// atual continua valendo e o ETag também.
+//
+// Com "If-None-Match" igual ao ETag atual a resposta é 304, sem corpo. A página
+// consulta /estado a cada segundo; "Cache-Control: no-cache" faz o navegador
+// revalidar cada consulta em vez de reaproveitar a resposta guardada.
+
+#define ESTADO_RESPOSTA_VERSOES 4 // Versão atual + anteriores ainda em envio
+#define ESTADO_RESPOSTA_TAM 512   // JSON de /estado (~330 bytes)
+
+// Monta e publica a resposta para 'e', se o JSON mudou. Chamar fora dos callbacks do
+// lwIP (laço principal). Se todos os buffers ainda estiverem em envio, a amostra é
+// ignorada e a versão anterior continua publicada.
+void estado_resposta_atualizar(const estado_t *e);
+
+// Preenche 'resp' para GET /estado: 304 se o If-None-Match da requisição é o ETag
+// atual, senão o corpo publicado. Retorna false se não há versão publicada para a
+// configuração atual (antes da primeira amostra ou logo após uma alteração); o
+// chamador então monta o JSON em 'dinamico', como nas demais rotas.
+bool estado_resposta_preencher(const http_requisicao_t *req, http_resposta_t *resp);
+
+#endif // ESTADO_RESPOSTA_H
@@ -0,0 +1,244 @@
+#include "grafico.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "metricas.h"
+
+#define PAGINAS_GRAFICO 3 // Altura de cada gráfico, em páginas
+#define ALTURA_GRAFICO (PAGINAS_GRAFICO * 8)
+
+// Uma grandeza na página: histórico circular, acumulador do ponto em formação e
+// escala vertical do desenho atual
+typedef struct
+{
+    const char *formato;  // Valor atual na linha de cima
+    float faixa_minima;   // Menor faixa vertical, para não ampliar ruído
+    uint8_t pagina_texto; // O gráfico ocupa as PAGINAS_GRAFICO páginas seguintes
+    float valores[GRAFICO_COLUNAS];
+    float soma;
+    float min, max;
+} traco_t;
+
+static traco_t tracos[] = {
+    {.formato = "T %.1fC", .faixa_minima = 1.0f, .pagina_texto = 0},
+    {.formato = "P %.1fhPa", .faixa_minima = 1.0f, .pagina_texto = 4},
+};
+#define NUM_TRACOS (sizeof(tracos) / sizeof(tracos[0]))
+_Static_assert(NUM_TRACOS == GRAFICO_NUM_TRACOS, "grafico_historico_t fora de sincronia com tracos[]");
+
+static uint8_t proximo;      // Posição do próximo ponto no histórico
+static uint8_t quantidade;   // Pontos no histórico
+static uint8_t acumuladas;   // Amostras no ponto em formação
+static uint8_t pontos_novos; // Pontos fechados que ainda não estão na tela
+
+// i-ésimo ponto mais antigo dos 'quantidade' guardados
+static float ponto(const traco_t *t, uint8_t i)
+{
+    return t->valores[(proximo + GRAFICO_COLUNAS - quantidade + i) % GRAFICO_COLUNAS];
+}
+
+void grafico_amostra(const amostra_t *amostra)
+{
+    tracos[0].soma += amostra->temperatura;
+    tracos[1].soma += amostra->pressao;
+    if (++acumuladas < GRAFICO_AMOSTRAS_POR_COLUNA)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < NUM_TRACOS; i++)
+    {
+        tracos[i].valores[proximo] = tracos[i].soma / GRAFICO_AMOSTRAS_POR_COLUNA;
+        tracos[i].soma = 0.0f;
+    }
+    proximo = (proximo + 1) % GRAFICO_COLUNAS;
+    if (quantidade < GRAFICO_COLUNAS)
+    {
+        quantidade++;
+    }
+    if (pontos_novos < GRAFICO_COLUNAS)
+    {
+        pontos_novos++;
+    }
+    acumuladas = 0;
+}
+
+// Linha do display (0 = topo) do valor na escala atual do traço
+static uint8_t linha(const traco_t *t, float valor)
+{
+    uint8_t base = (t->pagina_texto + 1 + PAGINAS_GRAFICO) * 8 - 1;
+    float fracao = (valor - t->min) / (t->max - t->min);
+    if (fracao < 0.0f)
+    {
+        fracao = 0.0f;
+    }
+    else if (fracao > 1.0f)
+    {
+        fracao = 1.0f;
+    }
+    return base - (uint8_t)(fracao * (ALTURA_GRAFICO - 1) + 0.5f);
+}
+
+// Desenha o ponto i na coluna x, ligado ao ponto anterior por um segmento vertical
+static void desenhar_coluna(ssd1306_t *ssd, const traco_t *t, uint8_t x, uint8_t i)
+{
+    uint8_t y = linha(t, ponto(t, i));
+    uint8_t y_anterior = i > 0 ? linha(t, ponto(t, i - 1)) : y;
+    if (y <= y_anterior)
+    {
+        ssd1306_vline(ssd, x, y, y_anterior, true);
+    }
+    else
+    {
+        ssd1306_vline(ssd, x, y_anterior, y, true);
+    }
+}
+
+// Valor atual sobre a linha do texto; os espaços apagam o texto anterior
+// (ssd1306_draw_string quebra a linha depois de 15 caracteres)
+static void desenhar_texto(ssd1306_t *ssd, const traco_t *t)
+{
+    char texto[16] = "--";
+    char linha_texto[16];
+    if (quantidade > 0)
+    {
+        snprintf(texto, sizeof(texto), t->formato, ponto(t, quantidade - 1));
+    }
+    snprintf(linha_texto, sizeof(linha_texto), "%-15s", texto);
+    ssd1306_draw_string(ssd, linha_texto, 0, t->pagina_texto * 8);
+}
+
+// Escala que cobre o histórico com uma folga de 10% em cada lado
+static void ajustar_escala(traco_t *t)
+{
+    float min = quantidade > 0 ? ponto(t, 0) : 0.0f;
+    float max = min;
+    for (uint8_t i = 1; i < quantidade; i++)
+    {
+        float v = ponto(t, i);
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+    }
+
+    float folga = (max - min) * 0.1f;
+    if (max - min + 2.0f * folga < t->faixa_minima)
+    {
+        folga = (t->faixa_minima - (max - min)) / 2.0f;
+    }
+    t->min = min - folga;
+    t->max = max + folga;
+}
+
+bool grafico_desenhar(ssd1306_t *ssd)
+{
+    ssd1306_fill(ssd, false);
+    for (size_t k = 0; k < NUM_TRACOS; k++)
+    {
+        traco_t *t = &tracos[k];
+        ajustar_escala(t);
+        desenhar_texto(ssd, t);
+        for (uint8_t i = 0; i < quantidade; i++)
+        {
+            desenhar_coluna(ssd, t, ssd->width - quantidade + i, i);
+        }
+    }
+    uint32_t inicio = metricas_inicio();
+    bool ok = ssd1306_send_data(ssd);
+    metricas_registrar(METRICA_DISPLAY_ENVIO, inicio);
+    if (!ok)
+    {
+        return false;
+    }
+    pontos_novos = 0;
+    return true;
+}
+
+bool grafico_pendente(void)
+{
+    return pontos_novos > 0;
+}
+
+bool grafico_atualizar(ssd1306_t *ssd)
+{
+    if (pontos_novos == 0)
+    {
+        return true;
+    }
+
+    // Vários pontos de uma vez (página recém-trocada) ou ponto fora da escala:
+    // redesenha tudo, com a escala refeita
+    bool redesenhar = pontos_novos > 1;
+    for (size_t k = 0; k < NUM_TRACOS && !redesenhar; k++)
+    {
+        float v = ponto(&tracos[k], quantidade - 1);
+        redesenhar = v < tracos[k].min || v > tracos[k].max;
+    }
+    if (redesenhar)
+    {
+        return grafico_desenhar(ssd);
+    }
+
+    // Os dois gráficos e a linha de texto entre eles rolam juntos, num comando só
+#if GRAFICO_ROLAGEM_HARDWARE
+    if (!ssd1306_scroll_content_left(ssd, 1, ssd->pages - 1))
+    {
+        return false;
+    }
+#else
+    ssd1306_shift_left(ssd, 1, ssd->pages - 1);
+#endif
+
+    uint8_t x = ssd->width - 1;
+    for (size_t k = 0; k < NUM_TRACOS; k++)
+    {
+        desenhar_texto(ssd, &tracos[k]);
+        desenhar_coluna(ssd, &tracos[k], x, quantidade - 1);
+    }
+
+    uint32_t inicio = metricas_inicio();
+#if GRAFICO_ROLAGEM_HARDWARE
+    // Só a coluna nova e as linhas de texto; o resto já rolou na RAM do display
+    bool ok = ssd1306_send_region(ssd, 1, ssd->pages - 1, x, x);
+    for (size_t k = 0; k < NUM_TRACOS && ok; k++)
+    {
+        uint8_t p = tracos[k].pagina_texto;
+        ok = ssd1306_send_region(ssd, p, p, 0, x);
+    }
+#else
+    bool ok = ssd1306_send_data(ssd);
+#endif
+    metricas_registrar(METRICA_DISPLAY_ENVIO, inicio);
+    if (!ok)
+    {
+        return false;
+    }
+    pontos_novos = 0;
+    return true;
+}
+
+void grafico_exportar(grafico_historico_t *historico)
+{
+    for (size_t k = 0; k < NUM_TRACOS; k++)
+    {
+        memcpy(historico->valores[k], tracos[k].valores, sizeof(tracos[k].valores));
+        historico->soma[k] = tracos[k].soma;
+    }
+    historico->proximo = proximo;
+    historico->quantidade = quantidade;
+    historico->acumuladas = acumuladas;
+}
+
+void grafico_restaurar(const grafico_historico_t *historico)
+{
+    for (size_t k = 0; k < NUM_TRACOS; k++)
+    {
+        memcpy(tracos[k].valores, historico->valores[k], sizeof(tracos[k].valores));
+        tracos[k].soma = historico->soma[k];
+    }
+    proximo = historico->proximo % GRAFICO_COLUNAS;
+    quantidade = historico->quantidade <= GRAFICO_COLUNAS ? historico->quantidade : GRAFICO_COLUNAS;
+    acumuladas = historico->acumuladas < GRAFICO_AMOSTRAS_POR_COLUNA ? historico->acumuladas : 0;
+    pontos_novos = 0;
+}
@@ -0,0 +1,65 @@
+#ifndef GRAFICO_H // Previne múltiplas inclusões do cabeçalho
+#define GRAFICO_H
+
+#include <stdbool.h>
+
+#include "ssd1306.h"
+#include "amostra.h"
+
+// Página de tendência do display: temperatura e pressão recentes em dois gráficos
+// de linha que rolam da direita para a esquerda, uma coluna por ponto.
+//
+// Cada ponto é a média de GRAFICO_AMOSTRAS_POR_COLUNA amostras. Com a página na
+// tela, um ponto novo não redesenha o display: o conteúdo rola uma coluna (pelo
+// próprio SSD1306, ou só no ram_buffer sem GRAFICO_ROLAGEM_HARDWARE), a nova
+// coluna é desenhada e só ela e as linhas dos valores atuais são enviadas. O
+// desenho completo fica para a troca de página e para quando um ponto sai da
+// escala vertical em uso.
+//
+// Layout (páginas de 8 linhas do SSD1306):
+//   0      valor atual da temperatura
+//   1..3   gráfico da temperatura
+//   4      valor atual da pressão
+//   5..7   gráfico da pressão
+
+#define GRAFICO_COLUNAS 128           // Pontos guardados = largura do display
+#define GRAFICO_AMOSTRAS_POR_COLUNA 10 // Com aquisição a 500 ms: 5 s por coluna, ~10 min na tela
+#define GRAFICO_NUM_TRACOS 2           // Temperatura e pressão
+
+// Rolagem pelo comando content scroll (2Dh) do SSD1306. Alguns controladores
+// compatíveis não o implementam: com 0, o deslocamento é feito no ram_buffer e a
+// tela inteira é reenviada a cada ponto.
+#ifndef GRAFICO_ROLAGEM_HARDWARE
+#define GRAFICO_ROLAGEM_HARDWARE 1
+#endif
+
+// Acumula uma amostra; a cada GRAFICO_AMOSTRAS_POR_COLUNA fecha um ponto
+void grafico_amostra(const amostra_t *amostra);
+
+// Desenha a página inteira e a envia ao display. Retorna false se o envio falhar;
+// nesse caso o conteúdo do display é incerto e a página deve ser redesenhada.
+bool grafico_desenhar(ssd1306_t *ssd);
+
+// Há pontos fechados desde o último desenho
+bool grafico_pendente(void);
+
+// Acrescenta ao display os pontos fechados desde o último desenho.
+// Retorna false se o envio falhar, como grafico_desenhar.
+bool grafico_atualizar(ssd1306_t *ssd);
+
+// Histórico circular e ponto em formação, copiados para a RAM retida entre
+// reinícios (supervisor.h)
+typedef struct
+{
+    float valores[GRAFICO_NUM_TRACOS][GRAFICO_COLUNAS];
+    float soma[GRAFICO_NUM_TRACOS];
+    uint8_t proximo, quantidade, acumuladas;
+} grafico_historico_t;
+
+void grafico_exportar(grafico_historico_t *historico);
+
+// Retoma o histórico exportado antes de um reinício. A tela só mostra os pontos no
+// próximo grafico_desenhar.
+void grafico_restaurar(const grafico_historico_t *historico);
+
+#endif // GRAFICO_H
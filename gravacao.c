@@ -0,0 +1,176 @@
+#include "gravacao.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "sensores.h"
+#include "configuracao.h"
+
+_Static_assert(SENSORES_MAX <= GRAVACAO_MAX_SENSORES, "gravacao_formato.h não comporta todos os sensores");
+_Static_assert(offsetof(configuracao_t, calibracao) == GRAVACAO_NUM_CONFIG * sizeof(float), "configuração fora do formato");
+_Static_assert(NUM_GRANDEZAS == GRAVACAO_NUM_CALIBRACOES && CALIBRACAO_MAX_PONTOS <= GRAVACAO_MAX_PONTOS,
+               "calibração fora do formato");
+
+typedef enum
+{
+    PEDIDO_NENHUM,
+    PEDIDO_INICIAR,
+    PEDIDO_PARAR,
+} pedido_t;
+
+static volatile pedido_t pedido;
+static volatile gravacao_estado_t estado = GRAVACAO_PARADA;
+
+static uint8_t buffer[GRAVACAO_TAM_MAX];
+static size_t usado; // Bytes já escritos em 'buffer'
+static gravacao_cabecalho_t cabecalho;
+static uint32_t versao_config;        // Versão da última configuração gravada
+static uint32_t falhas[SENSORES_MAX]; // Falhas de cada sensor até o ciclo anterior
+static uint16_t leitores;             // Downloads que apontam para 'buffer' (contexto do lwIP)
+
+bool gravacao_iniciar(void)
+{
+    if (leitores > 0)
+    {
+        return false; // comecar() reescreveria o buffer ainda em envio
+    }
+    pedido = PEDIDO_INICIAR;
+    return true;
+}
+
+void gravacao_parar(void)
+{
+    pedido = PEDIDO_PARAR;
+}
+
+// Cabeçalho provisório e tabela de sensores com a calibração de cada BMP280
+static void comecar(void)
+{
+    cabecalho.num_sensores = (uint8_t)sensores_quantidade();
+    cabecalho.num_ciclos = 0;
+    cabecalho.tam_ciclos = 0;
+    usado = GRAVACAO_TAM_CABECALHO + (size_t)cabecalho.num_sensores * GRAVACAO_TAM_SENSOR;
+
+    for (int i = 0; i < cabecalho.num_sensores; i++)
+    {
+        const sensor_t *s = sensores_obter(i);
+        gravacao_sensor_t g = {
+            .modelo = s->driver == &SENSOR_BMP280 ? GRAVACAO_MODELO_BMP280 : GRAVACAO_MODELO_AHT20,
+            .porta = (uint8_t)i2c_hw_index(s->i2c),
+            .mux = s->mux,
+            .canal_mux = s->canal_mux,
+        };
+        if (g.modelo == GRAVACAO_MODELO_BMP280)
+        {
+            memcpy(g.calibracao, s->bruto.bmp280.calibracao, GRAVACAO_TAM_CALIBRACAO);
+        }
+        gravacao_codificar_sensor(&g, buffer + GRAVACAO_TAM_CABECALHO + i * GRAVACAO_TAM_SENSOR);
+        falhas[i] = s->falhas;
+    }
+    estado = GRAVACAO_GRAVANDO;
+}
+
+static void concluir(void)
+{
+    gravacao_codificar_cabecalho(&cabecalho, buffer);
+    estado = GRAVACAO_CONCLUIDA;
+}
+
+void gravacao_ciclo(uint32_t instante_ms)
+{
+    pedido_t p = pedido;
+    if (p != PEDIDO_NENHUM)
+    {
+        if (p == PEDIDO_INICIAR)
+        {
+            estado = GRAVACAO_PARADA; // sem reservas novas antes de o pedido sair da fila
+        }
+        pedido = PEDIDO_NENHUM;
+        if (p == PEDIDO_INICIAR)
+        {
+            comecar();
+        }
+        else if (estado == GRAVACAO_GRAVANDO)
+        {
+            concluir();
+        }
+    }
+    if (estado != GRAVACAO_GRAVANDO)
+    {
+        return;
+    }
+    if (usado + GRAVACAO_TAM_CICLO_MAX > sizeof(buffer))
+    {
+        concluir();
+        return;
+    }
+
+    gravacao_ciclo_t c = {.instante_ms = instante_ms};
+
+    // Configuração no primeiro ciclo e a cada versão nova (offsets e limites mudam a saída)
+    configuracao_t config;
+    uint32_t versao = configuracao_ler(&config);
+    if (cabecalho.num_ciclos == 0 || versao != versao_config)
+    {
+        c.flags |= GRAVACAO_CICLO_CONFIG;
+        memcpy(c.config, &config, sizeof(c.config));
+        for (int g = 0; g < NUM_GRANDEZAS; g++)
+        {
+            c.num_pontos[g] = config.calibracao[g].num_pontos;
+            for (int i = 0; i < c.num_pontos[g]; i++)
+            {
+                c.pontos[g][i][0] = config.calibracao[g].medido[i];
+                c.pontos[g][i][1] = config.calibracao[g].referencia[i];
+            }
+        }
+        versao_config = versao;
+    }
+
+    // O que cada sensor leu neste ciclo; uma falha aparece como aumento de s->falhas
+    for (int i = 0; i < cabecalho.num_sensores; i++)
+    {
+        const sensor_t *s = sensores_obter(i);
+        c.estado[i] = (s->valido ? GRAVACAO_VALIDO : 0) | (s->falhas != falhas[i] ? GRAVACAO_FALHA : 0);
+        falhas[i] = s->falhas;
+        memcpy(c.quadro[i], s->driver == &SENSOR_BMP280 ? s->bruto.bmp280.medicao : s->bruto.aht20.quadro,
+               GRAVACAO_TAM_QUADRO);
+    }
+
+    size_t tam = gravacao_codificar_ciclo(&c, cabecalho.num_sensores, buffer + usado);
+    usado += tam;
+    cabecalho.tam_ciclos += tam;
+    cabecalho.num_ciclos++;
+}
+
+gravacao_estado_t gravacao_estado(void)
+{
+    return estado;
+}
+
+const uint8_t *gravacao_blob_reservar(size_t *tam)
+{
+    // Com uma nova gravação pedida, a concluída já não é entregue
+    if (estado != GRAVACAO_CONCLUIDA || pedido == PEDIDO_INICIAR)
+    {
+        *tam = 0;
+        return NULL;
+    }
+    leitores++;
+    *tam = usado;
+    return buffer;
+}
+
+void gravacao_blob_soltar(void *ref)
+{
+    (void)ref;
+    leitores--;
+}
+
+int gravacao_estado_json(char *buf, size_t tam)
+{
+    static const char *const nomes[] = {"parada", "gravando", "concluida"};
+    return snprintf(buf, tam, "{\"estado\":\"%s\",\"ciclos\":%lu,\"bytes\":%u,\"max_bytes\":%u}", nomes[estado],
+                    (unsigned long)cabecalho.num_ciclos, (unsigned)usado, (unsigned)GRAVACAO_TAM_MAX);
+}
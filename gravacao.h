@@ -0,0 +1,54 @@
+#ifndef GRAVACAO_H // Previne múltiplas inclusões do cabeçalho
+#define GRAVACAO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gravacao_formato.h"
+
+// Gravação crua dos sensores, para reproduzir no host o que a estação viu em campo.
+// Enquanto ligada, cada execução de tarefa_aquisicao grava, para cada sensor do
+// registro, o que foi lido do barramento (registradores do BMP280, quadro do AHT20)
+// e se houve leitura nova ou falha; no início vão a calibração de cada BMP280 e a
+// configuração, e a configuração de novo a cada versão nova. Nada é convertido aqui:
+// host/reproduzir.c passa a gravação pelo mesmo código de compensação, média, alertas
+// e formatação do firmware (formato em gravacao_formato.h).
+//
+// A gravação vai para um buffer estático e termina com gravacao_parar ou quando ele
+// enche. Os comandos só registram o pedido, atendido no próximo ciclo, e são chamados
+// dos callbacks do lwIP, assim como as reservas do bloco concluído.
+
+#define GRAVACAO_TAM_MAX 16384 // Com um BMP280 e um AHT20, 19 bytes por ciclo: ~7 min a 2 Hz
+
+typedef enum
+{
+    GRAVACAO_PARADA,
+    GRAVACAO_GRAVANDO,
+    GRAVACAO_CONCLUIDA, // Pronta para download
+} gravacao_estado_t;
+
+// Descarta a gravação anterior e começa outra no próximo ciclo. Retorna false, sem
+// nada mudar, enquanto a gravação anterior estiver reservada por um download.
+bool gravacao_iniciar(void);
+
+// Conclui a gravação em andamento no próximo ciclo
+void gravacao_parar(void);
+
+// Grava o ciclo, se houver gravação em andamento. Chamar em tarefa_aquisicao logo
+// depois de sensores_coletar.
+void gravacao_ciclo(uint32_t instante_ms);
+
+gravacao_estado_t gravacao_estado(void);
+
+// Bloco binário da gravação concluída, ou NULL se não houver. É enviado sem cópia:
+// cada bloco devolvido é uma reserva, e o conteúdo não muda até gravacao_blob_soltar.
+const uint8_t *gravacao_blob_reservar(size_t *tam);
+
+// Devolve uma reserva. Tem a assinatura de http_liberar_t ('ref' não é usado).
+void gravacao_blob_soltar(void *ref);
+
+// Estado em JSON para GET /gravacao. Retorna o tamanho escrito.
+int gravacao_estado_json(char *buf, size_t tam);
+
+#endif // GRAVACAO_H
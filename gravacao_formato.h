@@ -0,0 +1,234 @@
+#ifndef GRAVACAO_FORMATO_H // Previne múltiplas inclusões do cabeçalho
+#define GRAVACAO_FORMATO_H
+
+// Formato binário da gravação dos sensores (GET /gravacao.bin).
+// Compartilhado entre o firmware e a reprodução no host (host/reproduzir.c),
+// por isso usa apenas C padrão. Todos os campos são little-endian.
+//
+// Cabeçalho (12 bytes):
+//   0  u16 magico        'G','V' (0x5647)
+//   2  u8  versao        GRAVACAO_VERSAO
+//   3  u8  num_sensores  sensores do registro, na ordem de sensores_obter
+//   4  u32 num_ciclos    aquisições gravadas
+//   8  u32 tam_ciclos    bytes de ciclos depois da tabela de sensores
+// Sensores (28 bytes cada):
+//   0  u8  modelo        GRAVACAO_MODELO_*
+//   1  u8  porta         porta I2C (0 ou 1)
+//   2  u8  mux           endereço do TCA9548A, ou 0 se ligado direto
+//   3  u8  canal_mux
+//   4  u8  calibracao[24] BMP280: registradores 0x88..0x9F como lidos; AHT20: zeros
+// Ciclos (um por execução de tarefa_aquisicao, tamanho variável):
+//   0  u32 instante_ms   ms desde o boot
+//   4  u8  flags         GRAVACAO_CICLO_*
+//   5  f32 config[9]     só com GRAVACAO_CICLO_CONFIG: offsets e limites, na ordem de
+//                        configuracao_t (no primeiro ciclo e a cada versão nova),
+//                        seguidos da calibração de cada grandeza (temperatura, pressão,
+//                        umidade):
+//      u8  num_pontos
+//      i32 pontos[num_pontos][2]  medido e referência em centésimos (calibracao.h)
+//   e, para cada sensor (7 bytes):
+//      u8  estado        GRAVACAO_VALIDO | GRAVACAO_FALHA
+//      u8  quadro[6]     BMP280: registradores 0xF7..0xFC; AHT20: status + dados,
+//                        exatamente como lidos do barramento
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define GRAVACAO_MAGICO 0x5647
+#define GRAVACAO_VERSAO 2
+#define GRAVACAO_TAM_CABECALHO 12
+#define GRAVACAO_TAM_SENSOR 28
+#define GRAVACAO_TAM_CALIBRACAO 24
+#define GRAVACAO_TAM_QUADRO 6
+#define GRAVACAO_NUM_CONFIG 9
+#define GRAVACAO_NUM_CALIBRACOES 3
+#define GRAVACAO_MAX_PONTOS 8
+#define GRAVACAO_MAX_SENSORES 8
+
+#define GRAVACAO_MODELO_BMP280 0
+#define GRAVACAO_MODELO_AHT20 1
+
+#define GRAVACAO_CICLO_CONFIG 0x01
+
+// Resultado de cada sensor no ciclo (máscara; 0: sem falha e sem leitura nova, como
+// num sensor suspenso ou sem medição pendente)
+#define GRAVACAO_VALIDO 0x01 // Leitura nova em 'quadro'
+#define GRAVACAO_FALHA 0x02  // Alguma transação falhou; com VALIDO, só o disparo da próxima medição
+
+// Maior ciclo possível, para quem grava saber se ainda cabe
+#define GRAVACAO_TAM_CALIBRACOES_MAX (GRAVACAO_NUM_CALIBRACOES * (1 + GRAVACAO_MAX_PONTOS * 8))
+#define GRAVACAO_TAM_CICLO_MAX \
+    (5 + GRAVACAO_NUM_CONFIG * 4 + GRAVACAO_TAM_CALIBRACOES_MAX + GRAVACAO_MAX_SENSORES * (1 + GRAVACAO_TAM_QUADRO))
+
+typedef struct
+{
+    uint8_t num_sensores;
+    uint32_t num_ciclos;
+    uint32_t tam_ciclos;
+} gravacao_cabecalho_t;
+
+typedef struct
+{
+    uint8_t modelo;
+    uint8_t porta;
+    uint8_t mux;
+    uint8_t canal_mux;
+    uint8_t calibracao[GRAVACAO_TAM_CALIBRACAO];
+} gravacao_sensor_t;
+
+typedef struct
+{
+    uint32_t instante_ms;
+    uint8_t flags;
+    float config[GRAVACAO_NUM_CONFIG]; // Só com GRAVACAO_CICLO_CONFIG, como a calibração
+    uint8_t num_pontos[GRAVACAO_NUM_CALIBRACOES];
+    int32_t pontos[GRAVACAO_NUM_CALIBRACOES][GRAVACAO_MAX_PONTOS][2];
+    uint8_t estado[GRAVACAO_MAX_SENSORES];
+    uint8_t quadro[GRAVACAO_MAX_SENSORES][GRAVACAO_TAM_QUADRO];
+} gravacao_ciclo_t;
+
+static inline void gravacao_escrever32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t gravacao_ler32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void gravacao_codificar_cabecalho(const gravacao_cabecalho_t *c, uint8_t *buf)
+{
+    buf[0] = (uint8_t)GRAVACAO_MAGICO;
+    buf[1] = (uint8_t)(GRAVACAO_MAGICO >> 8);
+    buf[2] = GRAVACAO_VERSAO;
+    buf[3] = c->num_sensores;
+    gravacao_escrever32(buf + 4, c->num_ciclos);
+    gravacao_escrever32(buf + 8, c->tam_ciclos);
+}
+
+// Valida e decodifica o cabeçalho. Retorna false se o tamanho total não confere.
+static inline bool gravacao_decodificar_cabecalho(const uint8_t *buf, size_t tam, gravacao_cabecalho_t *c)
+{
+    if (tam < GRAVACAO_TAM_CABECALHO || (buf[0] | buf[1] << 8) != GRAVACAO_MAGICO || buf[2] != GRAVACAO_VERSAO ||
+        buf[3] > GRAVACAO_MAX_SENSORES)
+    {
+        return false;
+    }
+    c->num_sensores = buf[3];
+    c->num_ciclos = gravacao_ler32(buf + 4);
+    c->tam_ciclos = gravacao_ler32(buf + 8);
+    return tam == GRAVACAO_TAM_CABECALHO + (size_t)c->num_sensores * GRAVACAO_TAM_SENSOR + c->tam_ciclos;
+}
+
+static inline void gravacao_codificar_sensor(const gravacao_sensor_t *s, uint8_t *buf)
+{
+    buf[0] = s->modelo;
+    buf[1] = s->porta;
+    buf[2] = s->mux;
+    buf[3] = s->canal_mux;
+    memcpy(buf + 4, s->calibracao, GRAVACAO_TAM_CALIBRACAO);
+}
+
+static inline void gravacao_decodificar_sensor(const uint8_t *buf, gravacao_sensor_t *s)
+{
+    s->modelo = buf[0];
+    s->porta = buf[1];
+    s->mux = buf[2];
+    s->canal_mux = buf[3];
+    memcpy(s->calibracao, buf + 4, GRAVACAO_TAM_CALIBRACAO);
+}
+
+// Serializa o ciclo em 'buf' (até GRAVACAO_TAM_CICLO_MAX bytes). Retorna o tamanho.
+static inline size_t gravacao_codificar_ciclo(const gravacao_ciclo_t *c, uint8_t num_sensores, uint8_t *buf)
+{
+    uint8_t *p = buf;
+    gravacao_escrever32(p, c->instante_ms);
+    p[4] = c->flags;
+    p += 5;
+    if (c->flags & GRAVACAO_CICLO_CONFIG)
+    {
+        for (int i = 0; i < GRAVACAO_NUM_CONFIG; i++, p += 4)
+        {
+            uint32_t bits;
+            memcpy(&bits, &c->config[i], 4);
+            gravacao_escrever32(p, bits);
+        }
+        for (int g = 0; g < GRAVACAO_NUM_CALIBRACOES; g++)
+        {
+            *p++ = c->num_pontos[g];
+            for (int i = 0; i < c->num_pontos[g]; i++, p += 8)
+            {
+                gravacao_escrever32(p, (uint32_t)c->pontos[g][i][0]);
+                gravacao_escrever32(p + 4, (uint32_t)c->pontos[g][i][1]);
+            }
+        }
+    }
+    for (int i = 0; i < num_sensores; i++)
+    {
+        *p++ = c->estado[i];
+        memcpy(p, c->quadro[i], GRAVACAO_TAM_QUADRO);
+        p += GRAVACAO_TAM_QUADRO;
+    }
+    return (size_t)(p - buf);
+}
+
+// Decodifica o ciclo no início de 'buf'. Retorna os bytes consumidos, ou 0 se os
+// 'tam' bytes restantes não contêm um ciclo inteiro.
+static inline size_t gravacao_decodificar_ciclo(const uint8_t *buf, size_t tam, uint8_t num_sensores,
+                                                gravacao_ciclo_t *c)
+{
+    if (tam < 5)
+    {
+        return 0;
+    }
+    c->instante_ms = gravacao_ler32(buf);
+    c->flags = buf[4];
+    const uint8_t *p = buf + 5;
+    const uint8_t *fim = buf + tam;
+    if (c->flags & GRAVACAO_CICLO_CONFIG)
+    {
+        if (fim - p < GRAVACAO_NUM_CONFIG * 4)
+        {
+            return 0;
+        }
+        for (int i = 0; i < GRAVACAO_NUM_CONFIG; i++, p += 4)
+        {
+            uint32_t bits = gravacao_ler32(p);
+            memcpy(&c->config[i], &bits, 4);
+        }
+        for (int g = 0; g < GRAVACAO_NUM_CALIBRACOES; g++)
+        {
+            if (fim - p < 1 || p[0] > GRAVACAO_MAX_PONTOS || fim - p < 1 + p[0] * 8)
+            {
+                return 0;
+            }
+            c->num_pontos[g] = *p++;
+            for (int i = 0; i < c->num_pontos[g]; i++, p += 8)
+            {
+                c->pontos[g][i][0] = (int32_t)gravacao_ler32(p);
+                c->pontos[g][i][1] = (int32_t)gravacao_ler32(p + 4);
+            }
+        }
+    }
+    size_t usado = (size_t)(p - buf) + (size_t)num_sensores * (1 + GRAVACAO_TAM_QUADRO);
+    if (tam < usado)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < num_sensores; i++)
+    {
+        c->estado[i] = *p++;
+        memcpy(c->quadro[i], p, GRAVACAO_TAM_QUADRO);
+        p += GRAVACAO_TAM_QUADRO;
+    }
+    return usado;
+}
+
+#endif // GRAVACAO_FORMATO_H
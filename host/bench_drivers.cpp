@@ -0,0 +1,45 @@
+// Núcleos dos drivers em C++ (lib/bmp280.hpp) sobre o barramento simulado, medidos
+// pelo bench_estacao ao lado dos equivalentes em C de lib/bmp280.c.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "barramento_simulado.hpp"
+#include "bmp280.hpp"
+
+using Bmp280Simulado = Bmp280<BarramentoSimulado>;
+
+static volatile uint32_t sumidouro;
+
+extern "C" void k_bmp280_hpp_convert_pressure(uint32_t n)
+{
+    const bmp280::Calibracao &calib = bmp280::exemplo::calibracao;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        acc += (uint32_t)bmp280::converter_pressao(415148 + (int32_t)(i & 1023), 519888, calib);
+    }
+    sumidouro = acc;
+}
+
+// Leitura bruta pelo barramento + compensação, o caminho de cada aquisição
+extern "C" void k_bmp280_hpp_ler(uint32_t n)
+{
+    memcpy(&BarramentoSimulado::registradores[0x76][REG_DIG_T1_LSB], bmp280::exemplo::registradores,
+           NUM_CALIB_PARAMS);
+    const uint8_t medicao[6] = {0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00}; // 415148 e 519888
+    memcpy(&BarramentoSimulado::registradores[0x76][REG_PRESSURE_MSB], medicao, sizeof(medicao));
+
+    bmp280::Calibracao calib;
+    Bmp280Simulado::ler_calibracao(calib);
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // O "sensor" muda a medição a cada leitura
+        BarramentoSimulado::registradores[0x76][REG_PRESSURE_MSB + 1] = (uint8_t)i;
+        int32_t temp, pressao;
+        Bmp280Simulado::ler_bruto(temp, pressao);
+        acc += (uint32_t)bmp280::converter_pressao(pressao, temp, calib);
+    }
+    sumidouro = acc;
+}
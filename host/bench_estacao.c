@@ -0,0 +1,459 @@
+// Microbenchmarks dos núcleos de processamento da estação, compilados no host.
+//
+// Uso: bench_estacao [--baseline arq.json] [--tolerancia pct] [--saida arq.json] [--filtro texto]
+//
+// Cada núcleo roda em lotes de ~BENCH_LOTE_MS; o resultado é o menor tempo por operação
+// (ns) entre BENCH_REPETICOES lotes, o que descarta a maior parte do ruído do sistema.
+// Com --baseline, o programa termina com código 1 se algum núcleo ficar mais de
+// 'tolerancia' % acima do valor de referência. --saida grava os resultados no mesmo
+// formato JSON da referência (usado pelo alvo bench_update).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "aht20.h" // depende dos tipos acima, como em lib/aht20.c
+#include "bmp280.h"
+#include "calibracao.h"
+#include "configuracao.h"
+#include "estado_json.h"
+#include "estado_resposta.h"
+#include "http_requisicao.h"
+#include "ssd1306.h"
+
+#define BENCH_REPETICOES 11
+#define BENCH_LOTE_MS 10
+#define BENCH_TOLERANCIA_PADRAO 25.0
+
+// Impede que o compilador descarte resultados não usados
+static volatile uint32_t sumidouro;
+
+// Parâmetros de calibração do exemplo do datasheet do BMP280
+static struct bmp280_calib_param calib = {
+    .dig_t1 = 27504, .dig_t2 = 26435, .dig_t3 = -1000,
+    .dig_p1 = 36477, .dig_p2 = -10685, .dig_p3 = 3024,
+    .dig_p4 = 2855, .dig_p5 = 140, .dig_p6 = -7,
+    .dig_p7 = 15500, .dig_p8 = -14600, .dig_p9 = 6000,
+};
+
+static ssd1306_t ssd;
+
+// ============================================================================
+// === Núcleos medidos ===
+// Cada um executa 'n' operações variando a entrada com o índice, para que o
+// compilador não reaproveite resultados entre iterações.
+
+static void k_bmp280_convert_temp(uint32_t n)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        acc += (uint32_t)bmp280_convert_temp(519888 + (int32_t)(i & 1023), &calib);
+    }
+    sumidouro = acc;
+}
+
+static void k_bmp280_convert_pressure(uint32_t n)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        acc += (uint32_t)bmp280_convert_pressure(415148 + (int32_t)(i & 1023), 519888, &calib);
+    }
+    sumidouro = acc;
+}
+
+static void k_aht20_convert(uint32_t n)
+{
+    uint8_t buffer[6] = {0x1C, 0x6E, 0x1B, 0x45, 0x93, 0x2A};
+    AHT20_Data dados;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        buffer[5] = (uint8_t)i;
+        aht20_convert(buffer, &dados);
+        acc += (uint32_t)(dados.temperature + dados.humidity);
+    }
+    sumidouro = acc;
+}
+
+static void k_ssd1306_fill(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_fill(&ssd, i & 1);
+    }
+    sumidouro = ssd.ram_buffer[1];
+}
+
+static void k_ssd1306_rect(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_rect(&ssd, 3, 3, 122, 60, i & 1, !(i & 1));
+    }
+    sumidouro = ssd.ram_buffer[100];
+}
+
+static void k_ssd1306_line(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_line(&ssd, 0, (uint8_t)(i & 63), 127, (uint8_t)(63 - (i & 63)), true);
+    }
+    sumidouro = ssd.ram_buffer[200];
+}
+
+static void k_ssd1306_draw_string(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_draw_string(&ssd, "BMP280  AHT10", (uint8_t)(i & 7), 28);
+    }
+    sumidouro = ssd.ram_buffer[300];
+}
+
+// Dígitos grandes alinhados às páginas (cópia direta) e fora delas (deslocamento)
+static void k_ssd1306_draw_text_alinhado(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_draw_text(&ssd, &ssd1306_font_digits_24x32, "25.3", (uint8_t)(i & 7), 0);
+    }
+    sumidouro = ssd.ram_buffer[300];
+}
+
+static void k_ssd1306_draw_text_deslocado(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ssd1306_draw_text(&ssd, &ssd1306_font_digits_24x32, "25.3", (uint8_t)(i & 7), 3);
+    }
+    sumidouro = ssd.ram_buffer[300];
+}
+
+static void k_estado_json(uint32_t n)
+{
+    char buf[768];
+    estado_t e = {
+        .temperatura = 25.3f, .pressao = 1013.2f, .umidade = 55.1f,
+        .min_temp = -50, .max_temp = 50, .min_pressao = 100, .max_pressao = 1100,
+        .min_umidade = 0, .max_umidade = 100,
+    };
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        e.temperatura = 20.0f + (float)(i & 255) * 0.01f;
+        acc += (uint32_t)estado_json(&e, buf, sizeof(buf));
+    }
+    sumidouro = acc;
+}
+
+// Correção da umidade por uma tabela de CALIBRACAO_MAX_PONTOS pontos, como em cada amostra
+static void k_calibracao_aplicar(uint32_t n)
+{
+    static const float medido[CALIBRACAO_MAX_PONTOS] = {3.0f, 10.0f, 25.0f, 40.0f, 60.0f, 75.0f, 90.0f, 97.0f};
+    static const float referencia[CALIBRACAO_MAX_PONTOS] = {1.5f, 9.2f, 25.4f, 40.1f, 59.8f, 76.0f, 92.5f, 99.6f};
+    calibracao_t t;
+    calibracao_montar(&t, medido, referencia, CALIBRACAO_MAX_PONTOS);
+    float acc = 0.0f;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        acc += calibracao_aplicar(&t, (float)(i & 1023) * 0.1f);
+    }
+    sumidouro = (uint32_t)acc;
+}
+
+// GET /estado servido da resposta publicada na amostra, sem formatar de novo
+static void k_estado_resposta(uint32_t n)
+{
+    char buf[HTTP_TAM_CORPO_DINAMICO];
+    estado_t e = {
+        .temperatura = 25.3f, .pressao = 1013.2f, .umidade = 55.1f,
+        .min_temp = -50, .max_temp = 50, .min_pressao = 100, .max_pressao = 1100,
+        .min_umidade = 0, .max_umidade = 100, .versao = configuracao_versao(),
+    };
+    estado_resposta_atualizar(&e);
+    http_requisicao_t req = {.texto = "GET /estado HTTP/1.1\r\nHost: 192.168.0.50\r\nAccept: */*\r\n"};
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        http_resposta_t resp = {.status = 200, .dinamico = buf};
+        estado_resposta_preencher(&req, &resp);
+        acc += (uint32_t)resp.tam_corpo;
+        if (resp.liberar)
+        {
+            resp.liberar(resp.ref);
+        }
+    }
+    sumidouro = acc;
+}
+
+static void k_http_requisicao(uint32_t n)
+{
+    static const char modelo[] =
+        "GET /estado HTTP/1.1\r\n"
+        "Host: 192.168.0.50\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36\r\n"
+        "Accept: */*\r\n"
+        "Accept-Encoding: gzip, deflate\r\n"
+        "Accept-Language: pt-BR,pt;q=0.9\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n";
+    char req[sizeof(modelo) + 1];
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        memcpy(req, modelo, sizeof(modelo) - 1);
+        size_t tam_cabecalhos;
+        int tam = http_requisicao_completa(req, sizeof(modelo) - 1, 1024, &tam_cabecalhos);
+        req[tam_cabecalhos - 2] = '\0';
+        acc += (uint32_t)tam + http_requisicao_mantem_conexao(req);
+    }
+    sumidouro = acc;
+}
+
+// Leitura bruta pelo barramento simulado + compensação, para comparar com bmp280.hpp
+static void k_bmp280_ler(uint32_t n)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t temp = 519888, pressao = 415148;
+        bmp280_read_raw(NULL, &temp, &pressao);
+        acc += (uint32_t)bmp280_convert_pressure(pressao, temp, &calib);
+    }
+    sumidouro = acc;
+}
+
+// Drivers em C++ (bench_drivers.cpp)
+void k_bmp280_hpp_convert_pressure(uint32_t n);
+void k_bmp280_hpp_ler(uint32_t n);
+
+typedef struct
+{
+    const char *nome;
+    void (*rodar)(uint32_t n);
+} nucleo_t;
+
+static const nucleo_t nucleos[] = {
+    {"bmp280_convert_temp", k_bmp280_convert_temp},
+    {"bmp280_convert_pressure", k_bmp280_convert_pressure},
+    {"bmp280_hpp_convert_pressure", k_bmp280_hpp_convert_pressure},
+    {"bmp280_ler", k_bmp280_ler},
+    {"bmp280_hpp_ler", k_bmp280_hpp_ler},
+    {"aht20_convert", k_aht20_convert},
+    {"ssd1306_fill", k_ssd1306_fill},
+    {"ssd1306_rect", k_ssd1306_rect},
+    {"ssd1306_line", k_ssd1306_line},
+    {"ssd1306_draw_string", k_ssd1306_draw_string},
+    {"ssd1306_draw_text_alinhado", k_ssd1306_draw_text_alinhado},
+    {"ssd1306_draw_text_deslocado", k_ssd1306_draw_text_deslocado},
+    {"calibracao_aplicar", k_calibracao_aplicar},
+    {"estado_json", k_estado_json},
+    {"estado_resposta", k_estado_resposta},
+    {"http_requisicao", k_http_requisicao},
+};
+
+#define NUM_NUCLEOS (sizeof(nucleos) / sizeof(nucleos[0]))
+
+// ============================================================================
+// === Medição ===
+
+static double agora_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Menor tempo por operação (ns) entre as repetições
+static double medir(const nucleo_t *k)
+{
+    // Calibra o tamanho do lote para durar ao menos BENCH_LOTE_MS
+    uint32_t n = 1;
+    for (;;)
+    {
+        double inicio = agora_ns();
+        k->rodar(n);
+        if (agora_ns() - inicio >= BENCH_LOTE_MS * 1e6 || n >= (1u << 30))
+        {
+            break;
+        }
+        n *= 2;
+    }
+
+    double melhor = 0;
+    for (int r = 0; r < BENCH_REPETICOES; r++)
+    {
+        double inicio = agora_ns();
+        k->rodar(n);
+        double por_op = (agora_ns() - inicio) / n;
+        if (r == 0 || por_op < melhor)
+        {
+            melhor = por_op;
+        }
+    }
+    return melhor;
+}
+
+// ============================================================================
+// === Referência (JSON plano: {"nome": ns, ...}) ===
+
+static char *ler_arquivo(const char *caminho)
+{
+    FILE *f = fopen(caminho, "rb");
+    if (!f)
+    {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *texto = malloc((size_t)tam + 1);
+    if (texto && fread(texto, 1, (size_t)tam, f) != (size_t)tam)
+    {
+        free(texto);
+        texto = NULL;
+    }
+    if (texto)
+    {
+        texto[tam] = '\0';
+    }
+    fclose(f);
+    return texto;
+}
+
+// Procura "nome": valor no JSON de referência
+static int valor_referencia(const char *json, const char *nome, double *valor)
+{
+    char chave[96];
+    snprintf(chave, sizeof(chave), "\"%s\"", nome);
+    const char *p = strstr(json, chave);
+    if (!p)
+    {
+        return 0;
+    }
+    p = strchr(p + strlen(chave), ':');
+    if (!p)
+    {
+        return 0;
+    }
+    char *fim;
+    *valor = strtod(p + 1, &fim);
+    return fim != p + 1;
+}
+
+static int gravar_resultados(const char *caminho, const double *resultados, const int *medido)
+{
+    FILE *f = fopen(caminho, "w");
+    if (!f)
+    {
+        perror(caminho);
+        return 0;
+    }
+    fprintf(f, "{\n");
+    int primeiro = 1;
+    for (size_t i = 0; i < NUM_NUCLEOS; i++)
+    {
+        if (medido[i])
+        {
+            fprintf(f, "%s  \"%s\": %.2f", primeiro ? "" : ",\n", nucleos[i].nome, resultados[i]);
+            primeiro = 0;
+        }
+    }
+    fprintf(f, "\n}\n");
+    fclose(f);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *arq_referencia = NULL;
+    const char *arq_saida = NULL;
+    const char *filtro = NULL;
+    double tolerancia = BENCH_TOLERANCIA_PADRAO;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+        {
+            arq_referencia = argv[++i];
+        }
+        else if (strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc)
+        {
+            tolerancia = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc)
+        {
+            arq_saida = argv[++i];
+        }
+        else if (strcmp(argv[i], "--filtro") == 0 && i + 1 < argc)
+        {
+            filtro = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "uso: %s [--baseline arq] [--tolerancia pct] [--saida arq] [--filtro texto]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char *referencia = NULL;
+    if (arq_referencia)
+    {
+        referencia = ler_arquivo(arq_referencia);
+        if (!referencia)
+        {
+            perror(arq_referencia);
+            return 2;
+        }
+    }
+
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL); // barramento simulado
+
+    double resultados[NUM_NUCLEOS];
+    int medido[NUM_NUCLEOS] = {0};
+    int regressoes = 0;
+
+    printf("%-26s %12s %12s %9s\n", "nucleo", "ns/op", "referencia", "variacao");
+    for (size_t i = 0; i < NUM_NUCLEOS; i++)
+    {
+        if (filtro && !strstr(nucleos[i].nome, filtro))
+        {
+            continue;
+        }
+        resultados[i] = medir(&nucleos[i]);
+        medido[i] = 1;
+
+        double ref;
+        if (referencia && valor_referencia(referencia, nucleos[i].nome, &ref) && ref > 0)
+        {
+            double variacao = 100.0 * (resultados[i] - ref) / ref;
+            int regrediu = variacao > tolerancia;
+            regressoes += regrediu;
+            printf("%-26s %12.2f %12.2f %+8.1f%%%s\n", nucleos[i].nome, resultados[i], ref, variacao,
+                   regrediu ? "  REGRESSAO" : "");
+        }
+        else
+        {
+            printf("%-26s %12.2f %12s %9s\n", nucleos[i].nome, resultados[i], "-", "-");
+        }
+    }
+
+    if (arq_saida && !gravar_resultados(arq_saida, resultados, medido))
+    {
+        return 2;
+    }
+    free(referencia);
+
+    if (regressoes)
+    {
+        printf("%d nucleo(s) acima da tolerancia de %.0f%%\n", regressoes, tolerancia);
+        return 1;
+    }
+    return 0;
+}
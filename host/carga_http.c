@@ -0,0 +1,806 @@
+// Gerador de carga HTTP: N clientes simultâneos, cada um com sua conexão keep-alive,
+// pedindo as rotas em sequência, para medir a capacidade da estação (ou do
+// servidor_http_host). Relata requisições por segundo, latências p50/p99 e erros.
+//
+// Uso: carga_http [--host 192.168.0.20] [--porta 80] [--clientes 1,8,16,32]
+//                 [--duracao s] [--rotas /,/estado,...] [--intervalo ms]
+//                 [--timeout ms] [--fechar] [--condicional] [--sem-erros]
+//                 [--pipeline n]
+//
+// Com uma lista em --clientes, roda uma rodada por valor e imprime uma linha por rodada.
+// --intervalo é a pausa de cada cliente entre uma resposta e o próximo pedido (0: pede
+// de novo assim que a resposta chega); --fechar pede "Connection: close" a cada requisição;
+// --condicional reenvia o ETag recebido de cada rota em "If-None-Match", como o navegador
+// (as respostas 304 entram em "ok" e também na coluna "304").
+// A latência vai do início do pedido (incluindo a conexão, se nova) ao fim da resposta.
+// Erros: conexão recusada, conexão desfeita no meio da resposta, timeout, 503 e outros
+// códigos. Um pedido em uma conexão keep-alive que o servidor fechou por ociosidade
+// é refeito em uma conexão nova, como no navegador, e contado como reenvio. Com
+// --sem-erros, sai com 1 se alguma rodada teve erro ou reenvio.
+//
+// --pipeline n não mede: envia n pedidos de uma vez numa só conexão (o último com
+// "Connection: close"), confere se cada um recebeu sua resposta sem erro e sai com 1 se
+// não. Com n grande, um segmento TCP leva várias requisições e termina no meio de uma.
+
+#define _GNU_SOURCE // strcasestr, memmem
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_ROTAS 16
+#define MAX_RODADAS 16
+#define TAM_CABECALHO 2048
+#define TAM_REQUISICAO 512
+#define TAM_ETAG 64
+#define ESPERA_ERRO_MS 10 // pausa antes de tentar de novo depois de um erro
+
+typedef enum
+{
+    CLIENTE_PAUSA,      // esperando 'retomar_us' para o próximo pedido
+    CLIENTE_CONECTANDO,
+    CLIENTE_ENVIANDO,
+    CLIENTE_RECEBENDO,
+} fase_t;
+
+typedef enum
+{
+    CORPO_TAMANHO,    // Content-Length
+    CORPO_FRAGMENTOS, // Transfer-Encoding: chunked
+    CORPO_ATE_FECHAR, // sem tamanho: termina com a conexão
+} modo_corpo_t;
+
+typedef struct
+{
+    int fd;
+    fase_t fase;
+    int rota;
+    uint32_t atendidas; // respostas nesta conexão
+    uint64_t inicio_us; // início do pedido atual
+    uint64_t retomar_us;
+    size_t enviados;
+    bool recebeu; // algum byte da resposta já chegou
+    char pedido[TAM_REQUISICAO];
+    size_t tam_pedido;
+    char etags[MAX_ROTAS][TAM_ETAG]; // último ETag de cada rota (--condicional)
+
+    char cabecalho[TAM_CABECALHO + 1];
+    size_t tam_cabecalho;
+    bool cabecalho_completo;
+    int status;
+    bool fechar; // servidor respondeu com "Connection: close"
+    modo_corpo_t modo;
+    size_t restante;
+
+    // Corpo em chunks: 0 tamanho, 1 dados, 2 CRLF dos dados, 3 trailer
+    int etapa;
+    char linha[24];
+    size_t tam_linha;
+} cliente_t;
+
+typedef struct
+{
+    uint32_t *latencias_us;
+    size_t num, capacidade;
+    uint64_t erro_conexao, erro_reset, erro_timeout, erro_503, erro_status, reenvios, nao_modificadas;
+} resultado_t;
+
+static struct sockaddr_in destino;
+static char requisicoes[MAX_ROTAS][TAM_REQUISICAO];
+static size_t tam_requisicoes[MAX_ROTAS];
+static int num_rotas;
+static uint32_t intervalo_ms, timeout_ms = 5000;
+static bool condicional;
+static resultado_t resultado;
+
+static uint64_t agora_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static void fechar(cliente_t *c)
+{
+    if (c->fd >= 0)
+    {
+        close(c->fd);
+        c->fd = -1;
+    }
+    c->atendidas = 0;
+}
+
+static void pausar(cliente_t *c, uint32_t ms)
+{
+    c->fase = CLIENTE_PAUSA;
+    c->retomar_us = agora_us() + ms * 1000ull;
+}
+
+// Conta o erro, descarta a conexão e passa para a próxima rota depois de uma pausa
+static void falhar(cliente_t *c, uint64_t *contador)
+{
+    (*contador)++;
+    fechar(c);
+    c->rota = (c->rota + 1) % num_rotas;
+    pausar(c, intervalo_ms > ESPERA_ERRO_MS ? intervalo_ms : ESPERA_ERRO_MS);
+}
+
+static void enviar(cliente_t *c);
+
+// Começa o pedido da rota atual, abrindo uma conexão se preciso.
+// 'reenvio' mantém o instante de início do pedido original.
+static void iniciar(cliente_t *c, bool reenvio)
+{
+    if (!reenvio)
+    {
+        c->inicio_us = agora_us();
+    }
+    const char *etag = c->etags[c->rota];
+    int tam = snprintf(c->pedido, sizeof(c->pedido), "%.*s%s%s%s\r\n", (int)tam_requisicoes[c->rota] - 2,
+                       requisicoes[c->rota], etag[0] ? "If-None-Match: " : "", etag, etag[0] ? "\r\n" : "");
+    c->tam_pedido = tam > 0 && (size_t)tam < sizeof(c->pedido) ? (size_t)tam : 0;
+    c->enviados = 0;
+    c->recebeu = false;
+    c->tam_cabecalho = 0;
+    c->cabecalho_completo = false;
+
+    if (c->fd >= 0)
+    {
+        c->fase = CLIENTE_ENVIANDO;
+        enviar(c);
+        return;
+    }
+    c->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    int um = 1;
+    setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+    if (connect(c->fd, (struct sockaddr *)&destino, sizeof(destino)) == 0)
+    {
+        c->fase = CLIENTE_ENVIANDO;
+        enviar(c);
+    }
+    else if (errno == EINPROGRESS)
+    {
+        c->fase = CLIENTE_CONECTANDO;
+    }
+    else
+    {
+        falhar(c, &resultado.erro_conexao);
+    }
+}
+
+// A conexão caiu. Se ela já tinha sido usada e nada da resposta chegou, o servidor a
+// fechou por ociosidade antes de ver o pedido: refaz em uma conexão nova.
+static void conexao_perdida(cliente_t *c)
+{
+    if (c->atendidas > 0 && !c->recebeu)
+    {
+        resultado.reenvios++;
+        fechar(c);
+        iniciar(c, true);
+        return;
+    }
+    falhar(c, &resultado.erro_reset);
+}
+
+static void registrar_latencia(uint32_t us)
+{
+    if (resultado.num == resultado.capacidade)
+    {
+        resultado.capacidade = resultado.capacidade ? 2 * resultado.capacidade : 4096;
+        resultado.latencias_us = realloc(resultado.latencias_us, resultado.capacidade * sizeof(uint32_t));
+    }
+    resultado.latencias_us[resultado.num++] = us;
+}
+
+static void concluir(cliente_t *c)
+{
+    if (c->status == 503)
+    {
+        resultado.erro_503++;
+    }
+    else if (c->status < 200 || c->status >= 400)
+    {
+        resultado.erro_status++;
+    }
+    else
+    {
+        registrar_latencia((uint32_t)(agora_us() - c->inicio_us));
+        resultado.nao_modificadas += c->status == 304;
+    }
+
+    c->atendidas++;
+    if (c->fechar || c->modo == CORPO_ATE_FECHAR)
+    {
+        fechar(c);
+    }
+    c->rota = (c->rota + 1) % num_rotas;
+    if (intervalo_ms)
+    {
+        pausar(c, intervalo_ms);
+    }
+    else
+    {
+        iniciar(c, false);
+    }
+}
+
+static void enviar(cliente_t *c)
+{
+    const char *req = c->pedido;
+    size_t tam = c->tam_pedido;
+    while (c->enviados < tam)
+    {
+        ssize_t n = send(c->fd, req + c->enviados, tam - c->enviados, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                conexao_perdida(c);
+            }
+            return;
+        }
+        c->enviados += (size_t)n;
+    }
+    c->fase = CLIENTE_RECEBENDO;
+}
+
+// Lê uma linha do corpo em chunks. Retorna true quando ela terminou (sem o CRLF em 'linha').
+static bool ler_linha(cliente_t *c, const char **dados, size_t *tam)
+{
+    while (*tam > 0)
+    {
+        char ch = *(*dados)++;
+        (*tam)--;
+        if (ch == '\n')
+        {
+            c->linha[c->tam_linha] = '\0';
+            c->tam_linha = 0;
+            return true;
+        }
+        if (ch != '\r' && c->tam_linha < sizeof(c->linha) - 1)
+        {
+            c->linha[c->tam_linha++] = ch;
+        }
+    }
+    return false;
+}
+
+// Consome bytes do corpo, sem passar do fim da resposta (o que sobra em *dados já é da
+// próxima). Retorna true quando a resposta terminou.
+static bool consumir_corpo(cliente_t *c, const char **dados, size_t *tam)
+{
+    if (c->modo == CORPO_TAMANHO)
+    {
+        size_t n = *tam < c->restante ? *tam : c->restante;
+        *dados += n;
+        *tam -= n;
+        c->restante -= n;
+        return c->restante == 0;
+    }
+    if (c->modo == CORPO_ATE_FECHAR)
+    {
+        *tam = 0;
+        return false;
+    }
+
+    while (*tam > 0)
+    {
+        switch (c->etapa)
+        {
+        case 0:
+            if (ler_linha(c, dados, tam))
+            {
+                c->restante = strtoul(c->linha, NULL, 16);
+                c->etapa = c->restante ? 1 : 3;
+            }
+            break;
+        case 1:
+        {
+            size_t n = *tam < c->restante ? *tam : c->restante;
+            *dados += n;
+            *tam -= n;
+            c->restante -= n;
+            if (c->restante == 0)
+            {
+                c->etapa = 2;
+            }
+            break;
+        }
+        case 2:
+            if (ler_linha(c, dados, tam))
+            {
+                c->etapa = 0;
+            }
+            break;
+        default:
+            if (ler_linha(c, dados, tam) && c->linha[0] == '\0')
+            {
+                return true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+// Interpreta os cabeçalhos completos e prepara a leitura do corpo
+static void interpretar_cabecalho(cliente_t *c)
+{
+    const char *h = c->cabecalho;
+    c->status = strncmp(h, "HTTP/1.", 7) == 0 ? atoi(h + 9) : 0;
+    c->fechar = strcasestr(h, "\nConnection: close") != NULL;
+    c->etapa = 0;
+    c->tam_linha = 0;
+    const char *tamanho = strcasestr(h, "\nContent-Length:");
+    const char *etag = condicional ? strcasestr(h, "\nETag:") : NULL;
+    if (etag)
+    {
+        etag += 6;
+        etag += strspn(etag, " ");
+        size_t tam = strcspn(etag, "\r");
+        snprintf(c->etags[c->rota], TAM_ETAG, "%.*s", (int)(tam < TAM_ETAG ? tam : TAM_ETAG - 1), etag);
+    }
+    if (strcasestr(h, "\nTransfer-Encoding: chunked"))
+    {
+        c->modo = CORPO_FRAGMENTOS;
+    }
+    else if (tamanho)
+    {
+        c->modo = CORPO_TAMANHO;
+        c->restante = strtoul(tamanho + 16, NULL, 10);
+    }
+    else
+    {
+        c->modo = c->status == 204 || c->status == 304 ? CORPO_TAMANHO : CORPO_ATE_FECHAR;
+        c->restante = 0;
+    }
+}
+
+static void receber(cliente_t *c)
+{
+    char buf[16384];
+    ssize_t n = recv(c->fd, buf, sizeof(buf), 0);
+    if (n == 0 && c->cabecalho_completo && c->modo == CORPO_ATE_FECHAR)
+    {
+        concluir(c);
+        return;
+    }
+    if (n <= 0)
+    {
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            conexao_perdida(c);
+        }
+        return;
+    }
+    c->recebeu = true;
+
+    const char *corpo = buf;
+    size_t tam_corpo = (size_t)n;
+    if (!c->cabecalho_completo)
+    {
+        size_t copiar = TAM_CABECALHO - c->tam_cabecalho;
+        if (copiar > (size_t)n)
+        {
+            copiar = (size_t)n;
+        }
+        memcpy(c->cabecalho + c->tam_cabecalho, buf, copiar);
+        size_t anterior = c->tam_cabecalho;
+        c->tam_cabecalho += copiar;
+
+        char *fim = memmem(c->cabecalho, c->tam_cabecalho, "\r\n\r\n", 4);
+        if (!fim)
+        {
+            if (c->tam_cabecalho == TAM_CABECALHO)
+            {
+                falhar(c, &resultado.erro_status);
+            }
+            return;
+        }
+        size_t tam_cab = (size_t)(fim - c->cabecalho) + 4;
+        c->cabecalho[tam_cab] = '\0';
+        c->cabecalho_completo = true;
+        interpretar_cabecalho(c);
+
+        // O que veio depois dos cabeçalhos neste recv já é corpo
+        corpo = buf + (tam_cab - anterior);
+        tam_corpo = (size_t)n - (tam_cab - anterior);
+        if (c->modo == CORPO_TAMANHO && c->restante == 0)
+        {
+            concluir(c);
+            return;
+        }
+    }
+    if (tam_corpo > 0 && consumir_corpo(c, &corpo, &tam_corpo))
+    {
+        concluir(c);
+    }
+}
+
+// Consome uma parte do fluxo de respostas de --pipeline. Retorna quantos bytes usou;
+// *terminou indica que uma resposta chegou ao fim (o resto é da próxima).
+static size_t consumir_resposta(cliente_t *c, const char *dados, size_t tam, bool *terminou)
+{
+    *terminou = false;
+    size_t usados = 0;
+    if (!c->cabecalho_completo)
+    {
+        size_t copiar = TAM_CABECALHO - c->tam_cabecalho;
+        if (copiar > tam)
+        {
+            copiar = tam;
+        }
+        memcpy(c->cabecalho + c->tam_cabecalho, dados, copiar);
+        size_t anterior = c->tam_cabecalho;
+        c->tam_cabecalho += copiar;
+
+        char *fim = memmem(c->cabecalho, c->tam_cabecalho, "\r\n\r\n", 4);
+        if (!fim)
+        {
+            return copiar;
+        }
+        size_t tam_cab = (size_t)(fim - c->cabecalho) + 4;
+        c->cabecalho[tam_cab] = '\0';
+        c->cabecalho_completo = true;
+        interpretar_cabecalho(c);
+        usados = tam_cab - anterior;
+        if (c->modo == CORPO_TAMANHO && c->restante == 0)
+        {
+            *terminou = true;
+            return usados;
+        }
+    }
+    const char *corpo = dados + usados;
+    size_t resta = tam - usados;
+    *terminou = consumir_corpo(c, &corpo, &resta);
+    return tam - resta;
+}
+
+// --pipeline: 'num' pedidos num único envio e as respostas conferidas em ordem
+// Conexão bloqueante com o destino. O servidor pode estar subindo (testes do CTest):
+// tenta de novo até o timeout. Retorna -1 se não conectou.
+static int conectar_com_espera(void)
+{
+    uint64_t limite = agora_us() + timeout_ms * 1000ull;
+    for (;;)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr *)&destino, sizeof(destino)) == 0)
+        {
+            return fd;
+        }
+        close(fd);
+        if (agora_us() >= limite)
+        {
+            return -1;
+        }
+        usleep(50000);
+    }
+}
+
+static int verificar_pipeline(int num)
+{
+    size_t capacidade = (size_t)num * TAM_REQUISICAO, tam = 0;
+    char *pedidos = malloc(capacidade);
+    for (int i = 0; i < num; i++)
+    {
+        int r = i % num_rotas;
+        tam += (size_t)snprintf(pedidos + tam, capacidade - tam, "%.*s%s\r\n", (int)tam_requisicoes[r] - 2,
+                                requisicoes[r], i == num - 1 ? "Connection: close\r\n" : "");
+    }
+
+    int fd = conectar_com_espera();
+    if (fd < 0)
+    {
+        fprintf(stderr, "pipeline: sem conexao com o servidor\n");
+        free(pedidos);
+        return 1;
+    }
+    for (size_t enviados = 0; enviados < tam;)
+    {
+        ssize_t n = send(fd, pedidos + enviados, tam - enviados, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            break;
+        }
+        enviados += (size_t)n;
+    }
+
+    // Respostas até o servidor fechar (depois da última) ou o timeout
+    cliente_t *c = calloc(1, sizeof(cliente_t));
+    int respostas = 0, erros = 0;
+    char buf[16384];
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    ssize_t n = 0;
+    while (poll(&pfd, 1, (int)timeout_ms) > 0 && (n = recv(fd, buf, sizeof(buf), 0)) > 0)
+    {
+        for (size_t pos = 0; pos < (size_t)n;)
+        {
+            bool terminou;
+            pos += consumir_resposta(c, buf + pos, (size_t)n - pos, &terminou);
+            if (!terminou && !c->cabecalho_completo && c->tam_cabecalho == TAM_CABECALHO)
+            {
+                pos = (size_t)n; // cabeçalho grande demais: o que vier depois não tem como ser separado
+                erros++;
+            }
+            if (terminou)
+            {
+                respostas++;
+                erros += c->status < 200 || c->status >= 400;
+                c->tam_cabecalho = 0;
+                c->cabecalho_completo = false;
+            }
+        }
+    }
+    if (n == 0 && c->cabecalho_completo && c->modo == CORPO_ATE_FECHAR)
+    {
+        respostas++;
+        erros += c->status < 200 || c->status >= 400;
+    }
+    close(fd);
+    free(c);
+    free(pedidos);
+
+    bool ok = respostas == num && erros == 0;
+    printf("pipeline: %d pedidos (%zu bytes) em um envio, %d respostas, %d com erro: %s\n", num, tam, respostas,
+           erros, ok ? "OK" : "FALHOU");
+    return ok ? 0 : 1;
+}
+
+static int comparar(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Uma rodada com 'num' clientes durante 'duracao_s' segundos; devolve false se algum
+// pedido falhou ou precisou ser reenviado
+static bool rodar(int num, double duracao_s)
+{
+    cliente_t *clientes = calloc((size_t)num, sizeof(cliente_t));
+    struct pollfd *fds = calloc((size_t)num, sizeof(struct pollfd));
+    int *indices = calloc((size_t)num, sizeof(int));
+    free(resultado.latencias_us);
+    memset(&resultado, 0, sizeof(resultado));
+
+    for (int i = 0; i < num; i++)
+    {
+        clientes[i].fd = -1;
+        clientes[i].rota = i % num_rotas; // clientes começam em rotas diferentes
+    }
+
+    // Com --intervalo, os clientes começam espalhados pelo intervalo, como painéis
+    // abertos em momentos diferentes (todos juntos, pediriam sempre no mesmo instante)
+    uint64_t inicio = agora_us();
+    for (int i = 0; i < num; i++)
+    {
+        clientes[i].fase = CLIENTE_PAUSA;
+        clientes[i].retomar_us = inicio + (uint64_t)intervalo_ms * 1000u * (uint64_t)i / (uint64_t)num;
+    }
+    uint64_t fim = inicio + (uint64_t)(duracao_s * 1e6);
+    for (uint64_t agora = inicio; agora < fim; agora = agora_us())
+    {
+        int n = 0;
+        for (int i = 0; i < num; i++)
+        {
+            cliente_t *c = &clientes[i];
+            if (c->fase == CLIENTE_PAUSA && agora >= c->retomar_us)
+            {
+                iniciar(c, false);
+            }
+            if (c->fase != CLIENTE_PAUSA && agora > c->inicio_us + timeout_ms * 1000ull)
+            {
+                falhar(c, &resultado.erro_timeout);
+            }
+            if (c->fase == CLIENTE_PAUSA)
+            {
+                continue;
+            }
+            fds[n].fd = c->fd;
+            fds[n].events = c->fase == CLIENTE_RECEBENDO ? POLLIN : POLLOUT;
+            fds[n].revents = 0;
+            indices[n++] = i;
+        }
+
+        if (poll(fds, (nfds_t)n, 1) <= 0)
+        {
+            continue;
+        }
+        for (int k = 0; k < n; k++)
+        {
+            cliente_t *c = &clientes[indices[k]];
+            if (!fds[k].revents || c->fd != fds[k].fd)
+            {
+                continue;
+            }
+            if (c->fase == CLIENTE_CONECTANDO)
+            {
+                int erro = 0;
+                socklen_t tam = sizeof(erro);
+                getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &erro, &tam);
+                if (erro)
+                {
+                    falhar(c, &resultado.erro_conexao);
+                    continue;
+                }
+                c->fase = CLIENTE_ENVIANDO;
+            }
+            if (c->fase == CLIENTE_ENVIANDO)
+            {
+                enviar(c);
+            }
+            else if (c->fase == CLIENTE_RECEBENDO)
+            {
+                receber(c);
+            }
+        }
+    }
+    double decorrido = (agora_us() - inicio) / 1e6;
+
+    for (int i = 0; i < num; i++)
+    {
+        fechar(&clientes[i]);
+    }
+    free(clientes);
+    free(fds);
+    free(indices);
+
+    double p50 = 0, p99 = 0, max = 0;
+    if (resultado.num > 0)
+    {
+        uint32_t *l = resultado.latencias_us;
+        qsort(l, resultado.num, sizeof(uint32_t), comparar);
+        p50 = l[(resultado.num - 1) * 50 / 100] / 1e3;
+        p99 = l[(resultado.num - 1) * 99 / 100] / 1e3;
+        max = l[resultado.num - 1] / 1e3;
+    }
+    printf("%8d %9.1f %8.2f %8.2f %8.2f %9zu %8llu %8llu %8llu %8llu %8llu %8llu %8llu\n", num, resultado.num / decorrido,
+           p50, p99, max, resultado.num, (unsigned long long)resultado.erro_conexao,
+           (unsigned long long)resultado.erro_reset, (unsigned long long)resultado.erro_timeout,
+           (unsigned long long)resultado.erro_503, (unsigned long long)resultado.erro_status,
+           (unsigned long long)resultado.reenvios, (unsigned long long)resultado.nao_modificadas);
+    fflush(stdout);
+    uint64_t falhas = resultado.erro_conexao + resultado.erro_reset + resultado.erro_timeout + resultado.erro_503 +
+                      resultado.erro_status + resultado.reenvios;
+    return falhas == 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = "127.0.0.1";
+    const char *rotas = "/,/estado,/offset/temp/0.0,/limites/temp/min/10.0/max/35.0";
+    const char *lista_clientes = "1,4,8,16,32";
+    unsigned long porta = 8080;
+    double duracao_s = 5;
+    bool pedir_fechamento = false;
+    bool sem_erros = false;
+    int pipeline = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--host") == 0 && i + 1 < argc)
+        {
+            host = argv[++i];
+        }
+        else if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc)
+        {
+            porta = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--clientes") == 0 && i + 1 < argc)
+        {
+            lista_clientes = argv[++i];
+        }
+        else if (strcmp(argv[i], "--duracao") == 0 && i + 1 < argc)
+        {
+            duracao_s = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rotas") == 0 && i + 1 < argc)
+        {
+            rotas = argv[++i];
+        }
+        else if (strcmp(argv[i], "--intervalo") == 0 && i + 1 < argc)
+        {
+            intervalo_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--timeout") == 0 && i + 1 < argc)
+        {
+            timeout_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--fechar") == 0)
+        {
+            pedir_fechamento = true;
+        }
+        else if (strcmp(argv[i], "--condicional") == 0)
+        {
+            condicional = true;
+        }
+        else if (strcmp(argv[i], "--sem-erros") == 0)
+        {
+            sem_erros = true;
+        }
+        else if (strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc)
+        {
+            pipeline = atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr,
+                    "uso: %s [--host ip] [--porta n] [--clientes 1,8,32] [--duracao s] [--rotas /,/estado]\n"
+                    "          [--intervalo ms] [--timeout ms] [--fechar] [--condicional] [--sem-erros]\n"
+                    "          [--pipeline n]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    struct addrinfo dicas = {.ai_family = AF_INET, .ai_socktype = SOCK_STREAM}, *end;
+    if (getaddrinfo(host, NULL, &dicas, &end) != 0)
+    {
+        fprintf(stderr, "%s: endereco invalido\n", host);
+        return 2;
+    }
+    destino = *(struct sockaddr_in *)end->ai_addr;
+    destino.sin_port = htons((uint16_t)porta);
+    freeaddrinfo(end);
+
+    char copia[1024];
+    snprintf(copia, sizeof(copia), "%s", rotas);
+    for (char *r = strtok(copia, ","); r && num_rotas < MAX_ROTAS; r = strtok(NULL, ","))
+    {
+        int tam = snprintf(requisicoes[num_rotas], TAM_REQUISICAO, "GET %s HTTP/1.1\r\nHost: %s\r\n%s\r\n", r, host,
+                           pedir_fechamento ? "Connection: close\r\n" : "");
+        tam_requisicoes[num_rotas++] = (size_t)tam;
+    }
+    if (pipeline > 0 && num_rotas > 0)
+    {
+        return verificar_pipeline(pipeline);
+    }
+
+    int rodadas[MAX_RODADAS], num_rodadas = 0;
+    snprintf(copia, sizeof(copia), "%s", lista_clientes);
+    for (char *r = strtok(copia, ","); r && num_rodadas < MAX_RODADAS; r = strtok(NULL, ","))
+    {
+        int n = atoi(r);
+        if (n > 0)
+        {
+            rodadas[num_rodadas++] = n;
+        }
+    }
+    if (num_rotas == 0 || num_rodadas == 0 || duracao_s <= 0)
+    {
+        fprintf(stderr, "rotas, clientes ou duracao invalidos\n");
+        return 2;
+    }
+
+    // Espera o servidor aceitar conexões, para que a primeira rodada não conte como
+    // erro o tempo que ele leva para subir
+    int sonda = conectar_com_espera();
+    if (sonda < 0)
+    {
+        fprintf(stderr, "%s:%lu: sem conexao com o servidor\n", host, porta);
+        return 1;
+    }
+    close(sonda);
+
+    printf("# %s:%lu, %d rota(s): %s; %.1f s por rodada, intervalo %u ms%s%s\n", host, porta, num_rotas, rotas,
+           duracao_s, intervalo_ms, pedir_fechamento ? ", Connection: close" : "",
+           condicional ? ", If-None-Match" : "");
+    printf("%8s %9s %8s %8s %8s %9s %8s %8s %8s %8s %8s %8s %8s\n", "clientes", "req/s", "p50 ms", "p99 ms", "max ms",
+           "ok", "conexao", "reset", "timeout", "503", "status", "reenvio", "304");
+    bool limpo = true;
+    for (int i = 0; i < num_rodadas; i++)
+    {
+        limpo &= rodar(rodadas[i], duracao_s);
+    }
+    return sem_erros && !limpo ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+// Gera lib/ssd1306_font.c, as fontes maiores do display, a partir da fonte 8x8 de
+// lib/font.h e de um desenho de sete segmentos para os dígitos grandes.
+//
+// Uso: gerar_fontes > lib/ssd1306_font.c
+//
+// Todas as fontes saem no formato de ssd1306_font_t: cada glifo é uma sequência de
+// colunas, da esquerda para a direita, e cada coluna tem um byte por página de 8
+// linhas, de cima para baixo (bit 0 = linha de cima), como a RAM do SSD1306 no
+// endereçamento vertical.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "font.h"
+
+#define MAX_LARGURA 24
+#define MAX_ALTURA 32
+
+// Glifo como matriz de pixels [x][y]
+typedef struct
+{
+    bool p[MAX_LARGURA][MAX_ALTURA];
+} glifo_t;
+
+static bool pixel_8x8(int indice, int x, int y)
+{
+    if (x < 0 || x > 7 || y < 0 || y > 7)
+    {
+        return false;
+    }
+    return font[indice * 8 + x] >> y & 1;
+}
+
+// Ampliação 2x com suavização das diagonais (EPX/Scale2x): cada pixel vira 2x2 e
+// um canto copia os vizinhos quando eles formam uma diagonal
+static void ampliar_epx(int indice, glifo_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    for (int x = 0; x < 8; x++)
+    {
+        for (int y = 0; y < 8; y++)
+        {
+            bool p = pixel_8x8(indice, x, y);
+            bool a = pixel_8x8(indice, x, y - 1); // acima
+            bool b = pixel_8x8(indice, x + 1, y); // direita
+            bool c = pixel_8x8(indice, x - 1, y); // esquerda
+            bool d = pixel_8x8(indice, x, y + 1); // abaixo
+
+            g->p[2 * x][2 * y] = (c == a && c != d && a != b) ? a : p;
+            g->p[2 * x + 1][2 * y] = (a == b && a != c && b != d) ? b : p;
+            g->p[2 * x][2 * y + 1] = (d == c && d != b && c != a) ? c : p;
+            g->p[2 * x + 1][2 * y + 1] = (b == d && b != a && d != c) ? d : p;
+        }
+    }
+}
+
+// === Dígitos de sete segmentos, 24x32 ===
+// Eixos dos traços (centro dos pixels em x + 0,5) e meia espessura
+#define SEG_ESQ 5.0
+#define SEG_DIR 19.0
+#define SEG_CIMA 3.0
+#define SEG_MEIO 15.5
+#define SEG_BAIXO 28.0
+#define SEG_MEIA 2.0
+#define SEG_FOLGA 1.0
+
+// Segmentos: a (cima), b (direita cima), c (direita baixo), d (baixo),
+// e (esquerda baixo), f (esquerda cima), g (meio)
+static const uint8_t segmentos_digito[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F,
+};
+
+// Traço horizontal em 'yc' de x0 a x1 (ou vertical em 'xc' de y0 a y1), com as
+// pontas chanfradas para os segmentos se encaixarem
+static bool no_traco(double px, double py, bool horizontal, double eixo, double ini, double fim)
+{
+    double d = fabs((horizontal ? py : px) - eixo);
+    double t = horizontal ? px : py;
+    return d <= SEG_MEIA && t >= ini + d + SEG_FOLGA && t <= fim - d - SEG_FOLGA;
+}
+
+static void desenhar_segmentos(uint8_t segmentos, glifo_t *g)
+{
+    for (int x = 0; x < 24; x++)
+    {
+        for (int y = 0; y < 32; y++)
+        {
+            double px = x + 0.5, py = y + 0.5;
+            bool aceso =
+                ((segmentos & 0x01) && no_traco(px, py, true, SEG_CIMA, SEG_ESQ, SEG_DIR)) ||
+                ((segmentos & 0x02) && no_traco(px, py, false, SEG_DIR, SEG_CIMA, SEG_MEIO)) ||
+                ((segmentos & 0x04) && no_traco(px, py, false, SEG_DIR, SEG_MEIO, SEG_BAIXO)) ||
+                ((segmentos & 0x08) && no_traco(px, py, true, SEG_BAIXO, SEG_ESQ, SEG_DIR)) ||
+                ((segmentos & 0x10) && no_traco(px, py, false, SEG_ESQ, SEG_MEIO, SEG_BAIXO)) ||
+                ((segmentos & 0x20) && no_traco(px, py, false, SEG_ESQ, SEG_CIMA, SEG_MEIO)) ||
+                ((segmentos & 0x40) && no_traco(px, py, true, SEG_MEIO, SEG_ESQ, SEG_DIR));
+            g->p[x][y] = aceso;
+        }
+    }
+}
+
+// Quadrado de 4x4 com o canto superior esquerdo em (x, y)
+static void ponto(glifo_t *g, int x, int y)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            g->p[x + i][y + j] = true;
+        }
+    }
+}
+
+static void glifo_digitos(char c, glifo_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    if (c >= '0' && c <= '9')
+    {
+        desenhar_segmentos(segmentos_digito[c - '0'], g);
+    }
+    else if (c == '-')
+    {
+        desenhar_segmentos(0x40, g);
+    }
+    else if (c == '.')
+    {
+        ponto(g, 10, 27);
+    }
+    else if (c == ':')
+    {
+        ponto(g, 10, 8);
+        ponto(g, 10, 20);
+    }
+}
+
+// === Saída ===
+
+static void imprimir_glifo(const glifo_t *g, int largura, int paginas, const char *comentario)
+{
+    int n = 0;
+    printf("    ");
+    for (int x = 0; x < largura; x++)
+    {
+        for (int p = 0; p < paginas; p++)
+        {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++)
+            {
+                byte |= (uint8_t)(g->p[x][p * 8 + b] << b);
+            }
+            printf("0x%02X,%s", byte, ++n % 16 == 0 && n < largura * paginas ? "\n    " : " ");
+        }
+    }
+    printf("// %s\n", comentario);
+}
+
+static void comentario_char(char c, char *buf)
+{
+    if (c == '\\')
+    {
+        strcpy(buf, "'\\\\'");
+    }
+    else
+    {
+        sprintf(buf, "'%c'", c);
+    }
+}
+
+int main(void)
+{
+    glifo_t g;
+    char comentario[8];
+
+    printf("// Gerado por host/gerar_fontes.c; não editar à mão.\n");
+    printf("#include \"ssd1306_font.h\"\n");
+    printf("#include \"font.h\"\n\n");
+
+    printf("const ssd1306_font_t ssd1306_font_8x8 = {font, 8, 1, ' ', '~'};\n\n");
+
+    printf("// Fonte 8x8 ampliada para 16x16 (EPX)\n");
+    printf("static const uint8_t font_16x16[] = {\n");
+    for (char c = ' '; c <= '~'; c++)
+    {
+        ampliar_epx(c - ' ', &g);
+        comentario_char(c, comentario);
+        imprimir_glifo(&g, 16, 2, comentario);
+    }
+    printf("};\n\n");
+    printf("const ssd1306_font_t ssd1306_font_16x16 = {font_16x16, 16, 2, ' ', '~'};\n\n");
+
+    printf("// Dígitos de sete segmentos, 24x32, de '-' a ':'\n");
+    printf("static const uint8_t font_digits_24x32[] = {\n");
+    for (char c = '-'; c <= ':'; c++)
+    {
+        glifo_digitos(c, &g);
+        comentario_char(c, comentario);
+        imprimir_glifo(&g, 24, 4, comentario);
+    }
+    printf("};\n\n");
+    printf("const ssd1306_font_t ssd1306_font_digits_24x32 = {font_digits_24x32, 24, 4, '-', ':'};\n");
+    return 0;
+}
@@ -0,0 +1,525 @@
+// Relatório de flash e RAM por módulo a partir do mapa do linker do firmware
+// (WiFiExemplo.elf.map, gerado por pico_add_extra_outputs).
+//
+// Uso: memoria_mapa arq.map [--orcamento arq.json]
+//
+// Cada seção de entrada do mapa é somada ao módulo do arquivo objeto que a trouxe:
+//   - fontes do firmware: o caminho relativo sem extensão (servidor_http, lib/ssd1306);
+//   - pico-sdk: "sdk/<componente>" (sdk/pico_stdlib, sdk/hardware_i2c), e lwip, cyw43
+//     e tinyusb com um nome só;
+//   - bibliotecas da toolchain (libc, libgcc, libm...): o nome da biblioteca;
+//   - "*fill*" (enchimento de alinhamento entre seções): "(alinhamento)".
+// Endereços 0x1xxxxxxx contam como flash e 0x2xxxxxxx como RAM. Seções com endereço de
+// carga (.data, código copiado para a RAM) contam nas duas, e as demais (debug) em
+// nenhuma. No fim sai a ocupação de cada região do linker script.
+//
+// O orçamento é um JSON plano de limites em bytes: "flash" e "ram" para o total, e
+// "flash.<modulo>" / "ram.<modulo>" por módulo. O programa termina com código 1 se
+// algum limite for ultrapassado.
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_MODULOS 256
+#define MAX_REGIOES 16
+#define TAM_NOME 64
+#define TAM_LINHA 1024
+
+typedef struct
+{
+    char nome[TAM_NOME];
+    unsigned long flash;
+    unsigned long ram;
+} modulo_t;
+
+typedef struct
+{
+    char nome[TAM_NOME];
+    unsigned long origem;
+    unsigned long tamanho;
+    unsigned long usado;
+} regiao_t;
+
+static modulo_t modulos[MAX_MODULOS];
+static int num_modulos;
+static regiao_t regioes[MAX_REGIOES];
+static int num_regioes;
+
+// ============================================================================
+// === Módulos ===
+
+static modulo_t *modulo(const char *nome)
+{
+    for (int i = 0; i < num_modulos; i++)
+    {
+        if (strcmp(modulos[i].nome, nome) == 0)
+        {
+            return &modulos[i];
+        }
+    }
+    if (num_modulos == MAX_MODULOS)
+    {
+        return &modulos[MAX_MODULOS - 1]; // tabela cheia: o resto vai para o último
+    }
+    modulo_t *m = &modulos[num_modulos++];
+    snprintf(m->nome, sizeof(m->nome), "%s", nome);
+    return m;
+}
+
+// Copia 'tam' caracteres de 'ini' para 'nome', sem as extensões .obj/.o e .c/.cpp/.S
+static void sem_extensao(const char *ini, size_t tam, char *nome)
+{
+    if (tam >= TAM_NOME)
+    {
+        ini += tam - (TAM_NOME - 1);
+        tam = TAM_NOME - 1;
+    }
+    memcpy(nome, ini, tam);
+    nome[tam] = '\0';
+    for (int i = 0; i < 2; i++)
+    {
+        char *ponto = strrchr(nome, '.');
+        char *barra = strrchr(nome, '/');
+        if (ponto && ponto > nome && (!barra || ponto > barra))
+        {
+            *ponto = '\0';
+        }
+    }
+}
+
+static const char *const bibliotecas_toolchain[] = {
+    "libc", "libc_nano", "libg", "libg_nano", "libm", "libgcc", "libnosys",
+    "libstdc++", "libstdc++_nano", "libsupc++", "libsupc++_nano",
+};
+
+// Bibliotecas e trechos do pico-sdk com um nome só
+static const struct
+{
+    const char *trecho;
+    const char *modulo;
+} marcas_sdk[] = {
+    {"/lwip/", "lwip"},
+    {"cyw43", "cyw43"},
+    {"tinyusb", "tinyusb"},
+    {"btstack", "btstack"},
+    {"mbedtls", "mbedtls"},
+};
+
+// Módulo do arquivo objeto 'arq', como descrito no início do arquivo
+static void nome_modulo(const char *arq, char *nome)
+{
+    if (strcmp(arq, "*fill*") == 0)
+    {
+        snprintf(nome, TAM_NOME, "(alinhamento)");
+        return;
+    }
+
+    // Membro de biblioteca estática: "caminho/libx.a(membro.o)"
+    const char *parentese = strchr(arq, '(');
+    if (parentese && arq[strlen(arq) - 1] == ')')
+    {
+        const char *barra = parentese;
+        while (barra > arq && barra[-1] != '/')
+        {
+            barra--;
+        }
+        sem_extensao(barra, (size_t)(parentese - barra), nome);
+        for (size_t i = 0; i < sizeof(bibliotecas_toolchain) / sizeof(bibliotecas_toolchain[0]); i++)
+        {
+            if (strcmp(nome, bibliotecas_toolchain[i]) == 0)
+            {
+                return;
+            }
+        }
+        sem_extensao(parentese + 1, strlen(parentese + 1) - 1, nome); // biblioteca do projeto: o membro
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(marcas_sdk) / sizeof(marcas_sdk[0]); i++)
+    {
+        if (strstr(arq, marcas_sdk[i].trecho))
+        {
+            snprintf(nome, TAM_NOME, "%s", marcas_sdk[i].modulo);
+            return;
+        }
+    }
+
+    // Componente do SDK: o diretório depois de src/rp2_common, src/common...
+    static const char *const raizes_sdk[] = {"/src/rp2_common/", "/src/common/", "/src/rp2040/", "/src/boards/"};
+    for (size_t i = 0; i < sizeof(raizes_sdk) / sizeof(raizes_sdk[0]); i++)
+    {
+        const char *p = strstr(arq, raizes_sdk[i]);
+        if (p)
+        {
+            p += strlen(raizes_sdk[i]);
+            size_t tam = strcspn(p, "/");
+            snprintf(nome, TAM_NOME, "sdk/%.*s", (int)tam, p);
+            return;
+        }
+    }
+
+    // Fonte do firmware: "CMakeFiles/<alvo>.dir/<caminho>.c.obj"
+    const char *dir = strstr(arq, ".dir/");
+    if (dir)
+    {
+        dir += strlen(".dir/");
+        sem_extensao(dir, strlen(dir), nome);
+        return;
+    }
+
+    const char *barra = strrchr(arq, '/');
+    barra = barra ? barra + 1 : arq;
+    sem_extensao(barra, strlen(barra), nome);
+}
+
+// ============================================================================
+// === Mapa do linker ===
+
+static int hexadecimal(const char *s, unsigned long *valor)
+{
+    if (strncmp(s, "0x", 2) != 0)
+    {
+        return 0;
+    }
+    char *fim;
+    *valor = strtoul(s, &fim, 16);
+    return *fim == '\0';
+}
+
+static int separar(char *linha, char **campos, int max)
+{
+    int n = 0;
+    for (char *c = strtok(linha, " \t\r\n"); c && n < max; c = strtok(NULL, " \t\r\n"))
+    {
+        campos[n++] = c;
+    }
+    return n;
+}
+
+static regiao_t *regiao_de(unsigned long endereco)
+{
+    for (int i = 0; i < num_regioes; i++)
+    {
+        if (endereco >= regioes[i].origem && endereco - regioes[i].origem < regioes[i].tamanho)
+        {
+            return &regioes[i];
+        }
+    }
+    return NULL;
+}
+
+// Soma uma seção de entrada ao módulo e às regiões. 'carga' é o endereço de carga da
+// seção (0 se ela só existe no endereço de execução).
+static void somar(const char *arq, unsigned long endereco, unsigned long tam, unsigned long carga)
+{
+    int na_flash = (endereco >> 28) == 1 || carga;
+    int na_ram = (endereco >> 28) == 2;
+    if (tam == 0 || (!na_flash && !na_ram))
+    {
+        return;
+    }
+    char nome[TAM_NOME];
+    nome_modulo(arq, nome);
+    modulo_t *m = modulo(nome);
+    m->flash += na_flash ? tam : 0;
+    m->ram += na_ram ? tam : 0;
+
+    regiao_t *r = regiao_de(endereco);
+    if (r)
+    {
+        r->usado += tam;
+    }
+    r = carga ? regiao_de(carga) : NULL;
+    if (r)
+    {
+        r->usado += tam;
+    }
+}
+
+// Endereço de carga de uma linha de seção de saída ("... load address 0x1000b0a8")
+static unsigned long endereco_carga(const char *linha)
+{
+    const char *p = strstr(linha, "load address ");
+    return p ? strtoul(p + strlen("load address "), NULL, 16) : 0;
+}
+
+static int ler_mapa(const char *caminho)
+{
+    FILE *f = fopen(caminho, "r");
+    if (!f)
+    {
+        return 0;
+    }
+
+    enum
+    {
+        INICIO,
+        MEMORIA,
+        SECOES
+    } parte = INICIO;
+    unsigned long inicio = 0; // Endereço da seção de saída atual
+    unsigned long carga = 0;  // e onde ela é carregada, se for copiada para a RAM no boot
+    int saida_pendente = 0;   // Nome longo de seção de saída; endereço na próxima linha
+    int entrada_pendente = 0; // Idem para seção de entrada
+    char linha[TAM_LINHA], copia[TAM_LINHA];
+    char *c[8];
+
+    while (fgets(linha, sizeof(linha), f))
+    {
+        if (strncmp(linha, "Memory Configuration", 20) == 0)
+        {
+            parte = MEMORIA;
+            continue;
+        }
+        if (strncmp(linha, "Linker script and memory map", 28) == 0)
+        {
+            parte = SECOES;
+            continue;
+        }
+        memcpy(copia, linha, sizeof(linha));
+        int n = separar(copia, c, 8);
+        if (n == 0 || parte == INICIO)
+        {
+            continue;
+        }
+
+        if (parte == MEMORIA)
+        {
+            // "RAM   0x20000000   0x00040000   xrw"
+            unsigned long origem, tam;
+            if (n >= 3 && num_regioes < MAX_REGIOES && strcmp(c[0], "*default*") != 0 &&
+                hexadecimal(c[1], &origem) && hexadecimal(c[2], &tam))
+            {
+                regiao_t *r = &regioes[num_regioes++];
+                snprintf(r->nome, sizeof(r->nome), "%s", c[0]);
+                r->origem = origem;
+                r->tamanho = tam;
+            }
+            continue;
+        }
+
+        unsigned long endereco, tam;
+        if (!isspace((unsigned char)linha[0]))
+        {
+            // Seção de saída: ".data   0x20000000   0x1a4 load address 0x10005b84"
+            entrada_pendente = 0;
+            saida_pendente = linha[0] == '.' && n == 1;
+            inicio = n >= 2 && hexadecimal(c[1], &endereco) ? endereco : 0;
+            carga = linha[0] == '.' ? endereco_carga(linha) : 0;
+            continue;
+        }
+        if (saida_pendente)
+        {
+            saida_pendente = 0;
+            if (n >= 2 && hexadecimal(c[0], &endereco) && hexadecimal(c[1], &tam))
+            {
+                inicio = endereco;
+                carga = endereco_carga(linha);
+                continue;
+            }
+        }
+
+        // Seção de entrada: " .text.x   0x10000234   0x40 arquivo.obj", com o nome
+        // sozinho numa linha quando é longo; "*fill*" é o alinhamento entre seções
+        char **v = c + 1;
+        int nv = n - 1;
+        if (entrada_pendente)
+        {
+            entrada_pendente = 0;
+            v = c;
+            nv = n;
+        }
+        else if (c[0][0] != '.' && strcmp(c[0], "COMMON") != 0 && strcmp(c[0], "*fill*") != 0)
+        {
+            continue; // símbolo, atribuição ou padrão do linker script
+        }
+        else if (n == 1)
+        {
+            entrada_pendente = 1;
+            continue;
+        }
+        if (nv >= 2 && hexadecimal(v[0], &endereco) && hexadecimal(v[1], &tam))
+        {
+            const char *arq = strcmp(c[0], "*fill*") == 0 ? c[0] : nv >= 3 ? v[2] : NULL;
+            if (arq)
+            {
+                somar(arq, endereco, tam, carga ? carga + (endereco - inicio) : 0);
+            }
+        }
+    }
+    fclose(f);
+    return 1;
+}
+
+// ============================================================================
+// === Orçamento ===
+
+static char *ler_arquivo(const char *caminho)
+{
+    FILE *f = fopen(caminho, "rb");
+    if (!f)
+    {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *texto = malloc((size_t)tam + 1);
+    if (texto && fread(texto, 1, (size_t)tam, f) != (size_t)tam)
+    {
+        free(texto);
+        texto = NULL;
+    }
+    if (texto)
+    {
+        texto[tam] = '\0';
+    }
+    fclose(f);
+    return texto;
+}
+
+// Confere cada "chave": limite do orçamento. Retorna quantos limites estouraram.
+static int conferir_orcamento(const char *json, unsigned long flash, unsigned long ram)
+{
+    int estouros = 0;
+    printf("\n%-34s %10s %10s %6s\n", "orcamento", "usado", "limite", "uso");
+    for (const char *p = strchr(json, '"'); p; p = strchr(p, '"'))
+    {
+        const char *fim = strchr(p + 1, '"');
+        const char *dois_pontos = fim ? strchr(fim, ':') : NULL;
+        if (!dois_pontos)
+        {
+            break;
+        }
+        char chave[TAM_NOME + 8];
+        snprintf(chave, sizeof(chave), "%.*s", (int)(fim - p - 1), p + 1);
+        unsigned long limite = strtoul(dois_pontos + 1, NULL, 10);
+        p = strchr(dois_pontos, ',');
+        if (!p)
+        {
+            p = dois_pontos + 1; // última chave: o laço termina no próximo strchr
+        }
+
+        unsigned long usado;
+        const char *ponto = strchr(chave, '.');
+        if (strcmp(chave, "flash") == 0 || strcmp(chave, "ram") == 0)
+        {
+            usado = chave[0] == 'f' ? flash : ram;
+        }
+        else if (ponto && (strncmp(chave, "flash.", 6) == 0 || strncmp(chave, "ram.", 4) == 0))
+        {
+            const modulo_t *m = NULL;
+            for (int i = 0; i < num_modulos && !m; i++)
+            {
+                m = strcmp(modulos[i].nome, ponto + 1) == 0 ? &modulos[i] : NULL;
+            }
+            if (!m)
+            {
+                printf("%-34s %10s %10lu %6s  modulo ausente do mapa\n", chave, "-", limite, "-");
+                continue;
+            }
+            usado = chave[0] == 'f' ? m->flash : m->ram;
+        }
+        else
+        {
+            printf("%-34s chave desconhecida\n", chave);
+            continue;
+        }
+
+        int estourou = usado > limite;
+        estouros += estourou;
+        printf("%-34s %10lu %10lu %5.0f%%%s\n", chave, usado, limite, limite ? 100.0 * usado / limite : 0.0,
+               estourou ? "  ESTOURADO" : "");
+    }
+    return estouros;
+}
+
+// ============================================================================
+
+static int comparar_modulos(const void *a, const void *b)
+{
+    const modulo_t *ma = a, *mb = b;
+    unsigned long ta = ma->flash + ma->ram, tb = mb->flash + mb->ram;
+    return ta < tb ? 1 : ta > tb ? -1 : strcmp(ma->nome, mb->nome);
+}
+
+int main(int argc, char **argv)
+{
+    const char *arq_mapa = NULL;
+    const char *arq_orcamento = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--orcamento") == 0 && i + 1 < argc)
+        {
+            arq_orcamento = argv[++i];
+        }
+        else if (argv[i][0] != '-' && !arq_mapa)
+        {
+            arq_mapa = argv[i];
+        }
+        else
+        {
+            arq_mapa = NULL;
+            break;
+        }
+    }
+    if (!arq_mapa)
+    {
+        fprintf(stderr, "uso: %s arq.map [--orcamento arq.json]\n", argv[0]);
+        return 2;
+    }
+
+    char *orcamento = NULL;
+    if (arq_orcamento)
+    {
+        orcamento = ler_arquivo(arq_orcamento);
+        if (!orcamento)
+        {
+            perror(arq_orcamento);
+            return 2;
+        }
+    }
+    if (!ler_mapa(arq_mapa))
+    {
+        perror(arq_mapa);
+        return 2;
+    }
+
+    qsort(modulos, (size_t)num_modulos, sizeof(modulos[0]), comparar_modulos);
+    unsigned long flash = 0, ram = 0;
+    printf("%-34s %10s %10s\n", "modulo", "flash", "ram");
+    for (int i = 0; i < num_modulos; i++)
+    {
+        printf("%-34s %10lu %10lu\n", modulos[i].nome, modulos[i].flash, modulos[i].ram);
+        flash += modulos[i].flash;
+        ram += modulos[i].ram;
+    }
+    printf("%-34s %10lu %10lu\n", "total", flash, ram);
+
+    if (num_regioes)
+    {
+        printf("\n%-34s %10s %10s %6s\n", "regiao", "usado", "tamanho", "uso");
+        for (int i = 0; i < num_regioes; i++)
+        {
+            const regiao_t *r = &regioes[i];
+            printf("%-34s %10lu %10lu %5.0f%%\n", r->nome, r->usado, r->tamanho,
+                   r->tamanho ? 100.0 * r->usado / r->tamanho : 0.0);
+        }
+    }
+
+    int estouros = 0;
+    if (orcamento)
+    {
+        estouros = conferir_orcamento(orcamento, flash, ram);
+        free(orcamento);
+    }
+    if (estouros)
+    {
+        printf("%d limite(s) do orcamento ultrapassado(s)\n", estouros);
+        return 1;
+    }
+    return 0;
+}
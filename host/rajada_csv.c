@@ -0,0 +1,75 @@
+// Converte a captura em rajada (GET /rajada.bin) para CSV.
+// Uso: rajada_csv arquivo.bin > rajada.csv
+//
+// Colunas: tempo relativo ao gatilho (s) e pressão (Pa). Os metadados do cabeçalho
+// saem como comentários no início.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rajada_formato.h"
+
+static const char *nome_motivo(uint8_t motivo)
+{
+    switch (motivo)
+    {
+    case RAJADA_MOTIVO_JANELA:
+        return "janela";
+    case RAJADA_MOTIVO_LIMIAR:
+        return "limiar";
+    case RAJADA_MOTIVO_MANUAL:
+        return "manual";
+    default:
+        return "desconhecido";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "uso: %s arquivo.bin\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *dados = malloc(tam > 0 ? (size_t)tam : 1);
+    if (!dados || fread(dados, 1, (size_t)tam, f) != (size_t)tam)
+    {
+        fprintf(stderr, "falha ao ler %s\n", argv[1]);
+        return 2;
+    }
+    fclose(f);
+
+    rajada_cabecalho_t c;
+    if (!rajada_decodificar_cabecalho(dados, (size_t)tam, &c))
+    {
+        fprintf(stderr, "%s: captura invalida ou incompleta\n", argv[1]);
+        return 1;
+    }
+
+    printf("# motivo=%s amostras=%lu pre_gatilho=%lu periodo_us=%lu gatilho_ms=%lu\n",
+           nome_motivo(c.motivo), (unsigned long)c.num_amostras, (unsigned long)c.pre_gatilho,
+           (unsigned long)c.periodo_us, (unsigned long)c.gatilho_ms);
+    printf("# limiar_pa_s=%ld temperatura_c=%.2f lacunas=%u\n",
+           (long)c.limiar_pa_s, c.temperatura_cc / 100.0, c.lacunas);
+    printf("tempo_s,pressao_pa\n");
+
+    for (uint32_t i = 0; i < c.num_amostras; i++)
+    {
+        rajada_amostra_t a;
+        rajada_decodificar_amostra(dados + RAJADA_TAM_CABECALHO + (size_t)i * RAJADA_TAM_AMOSTRA, &a);
+        printf("%.6f,%lu\n", a.instante_us / 1e6, (unsigned long)a.pressao_pa);
+    }
+
+    free(dados);
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Receptor de teste do beacon UDP da estação.
+// Uso: receptor_udp [porta]   (padrão: TELEMETRIA_UDP_PORTA)
+//
+// Mostra cada amostra recebida e, a cada intervalo, as estatísticas por estação:
+// datagramas recebidos, perdidos (saltos na sequência), duplicados/fora de ordem
+// e descartados por CRC ou formato inválido.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetria_udp_formato.h"
+
+#define PORTA_PADRAO 5005
+#define MAX_ESTACOES 64
+#define INTERVALO_ESTATISTICAS_S 10
+
+// Estado de recepção de uma estação
+typedef struct
+{
+    uint32_t estacao;
+    uint16_t sessao;
+    uint32_t ultima_seq;
+    unsigned long recebidos;
+    unsigned long perdidos;
+    unsigned long duplicados;
+    unsigned long reinicios;
+    unsigned long sinalizados; // pacotes com TELEMETRIA_UDP_FLAG_FILA_CHEIA
+} estacao_t;
+
+static estacao_t estacoes[MAX_ESTACOES];
+static int num_estacoes;
+static unsigned long invalidos;
+
+static estacao_t *buscar_estacao(uint32_t id)
+{
+    for (int i = 0; i < num_estacoes; i++)
+    {
+        if (estacoes[i].estacao == id)
+        {
+            return &estacoes[i];
+        }
+    }
+    return NULL;
+}
+
+// Atualiza os contadores da estação. Retorna 0 se o pacote deve ser descartado (duplicado).
+static int contabilizar(const telemetria_udp_pacote_t *pct)
+{
+    estacao_t *e = buscar_estacao(pct->estacao);
+    if (!e)
+    {
+        if (num_estacoes == MAX_ESTACOES)
+        {
+            return 1; // tabela cheia: mostra sem acompanhar
+        }
+        e = &estacoes[num_estacoes++];
+        memset(e, 0, sizeof(*e));
+        e->estacao = pct->estacao;
+        e->sessao = pct->sessao;
+        e->ultima_seq = pct->seq;
+        e->recebidos = 1;
+        return 1;
+    }
+
+    // Nova sessão: a estação reiniciou e a sequência recomeçou
+    if (pct->sessao != e->sessao)
+    {
+        e->sessao = pct->sessao;
+        e->ultima_seq = pct->seq;
+        e->reinicios++;
+        e->recebidos++;
+        return 1;
+    }
+
+    int32_t salto = (int32_t)(pct->seq - e->ultima_seq);
+    if (salto <= 0)
+    {
+        e->duplicados++; // repetido ou atrasado além do último aceito
+        return 0;
+    }
+    e->perdidos += (unsigned long)(salto - 1);
+    e->ultima_seq = pct->seq;
+    e->recebidos++;
+    if (pct->flags & TELEMETRIA_UDP_FLAG_FILA_CHEIA)
+    {
+        e->sinalizados++;
+    }
+    return 1;
+}
+
+static void mostrar_pacote(const telemetria_udp_pacote_t *pct, const char *origem)
+{
+    for (int i = 0; i < pct->quantidade; i++)
+    {
+        const telemetria_udp_amostra_t *a = &pct->amostras[i];
+        printf("%s est=%08lx seq=%lu t=%lu ms  temp=%.2f C  press=%.2f hPa  umid=",
+               origem, (unsigned long)pct->estacao, (unsigned long)pct->seq,
+               (unsigned long)(pct->instante_ms + a->delta_ms),
+               a->temperatura_cc / 100.0, a->pressao_pa / 100.0);
+        if (a->umidade_cp == TELEMETRIA_UDP_UMIDADE_INVALIDA)
+        {
+            printf("--\n");
+        }
+        else
+        {
+            printf("%.2f %%\n", a->umidade_cp / 100.0);
+        }
+    }
+}
+
+static void mostrar_estatisticas(void)
+{
+    printf("--- %d estacao(oes), %lu datagrama(s) invalido(s)\n", num_estacoes, invalidos);
+    for (int i = 0; i < num_estacoes; i++)
+    {
+        const estacao_t *e = &estacoes[i];
+        unsigned long esperados = e->recebidos + e->perdidos;
+        printf("    %08lx sessao=%04x recebidos=%lu perdidos=%lu (%.2f%%) duplicados=%lu reinicios=%lu sinalizados=%lu\n",
+               (unsigned long)e->estacao, e->sessao, e->recebidos, e->perdidos,
+               esperados ? 100.0 * e->perdidos / esperados : 0.0,
+               e->duplicados, e->reinicios, e->sinalizados);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    int porta = argc > 1 ? atoi(argv[1]) : PORTA_PADRAO;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+    int um = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+    setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &um, sizeof(um));
+
+    struct sockaddr_in endereco = {0};
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_ANY);
+    endereco.sin_port = htons((uint16_t)porta);
+    if (bind(sock, (struct sockaddr *)&endereco, sizeof(endereco)) < 0)
+    {
+        perror("bind");
+        return 1;
+    }
+
+    // O timeout de leitura garante as estatísticas periódicas mesmo sem tráfego
+    struct timeval timeout = {.tv_sec = 1};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    printf("Aguardando beacons UDP na porta %d\n", porta);
+    time_t proximas_estatisticas = time(NULL) + INTERVALO_ESTATISTICAS_S;
+
+    while (1)
+    {
+        uint8_t buf[512];
+        struct sockaddr_in origem;
+        socklen_t tam_origem = sizeof(origem);
+        ssize_t n = recvfrom(sock, buf, sizeof(buf), 0, (struct sockaddr *)&origem, &tam_origem);
+
+        if (n >= 0)
+        {
+            telemetria_udp_pacote_t pct;
+            if (!telemetria_udp_decodificar(buf, (size_t)n, &pct))
+            {
+                invalidos++;
+                printf("%s datagrama invalido (%zd bytes)\n", inet_ntoa(origem.sin_addr), n);
+            }
+            else if (contabilizar(&pct))
+            {
+                mostrar_pacote(&pct, inet_ntoa(origem.sin_addr));
+            }
+        }
+
+        if (time(NULL) >= proximas_estatisticas)
+        {
+            mostrar_estatisticas();
+            proximas_estatisticas = time(NULL) + INTERVALO_ESTATISTICAS_S;
+        }
+    }
+}
@@ -0,0 +1,495 @@
+// Reproduz uma gravação dos sensores (GET /gravacao.bin, gravacao_formato.h) pelo mesmo
+// código do firmware: drivers e compensação (sensores_drivers.cpp sobre lib/*.hpp),
+// registro, saúde e média dos sensores com a calibração e os offsets (sensores.c,
+// calibracao.c), configuração (configuracao.c), regras de alerta (alertas.c), média do
+// gráfico (grafico.c) e JSON de /estado (estado_json.c). O barramento I2C é um modelo dos dispositivos gravados
+// que responde com os bytes de cada ciclo, e o relógio simulado segue os instantes da
+// gravação sem esperar: a reprodução roda tão rápido quanto a CPU permite.
+//
+// Uso: reproduzir gravacao.bin [--saida arq.txt] [--comparar ref.txt] [--repetir n]
+//
+// Cada ciclo vira uma linha com a amostra, as saídas de alerta e o JSON de /estado, e
+// cada ponto fechado do gráfico vira outra (sem --saida, vão para stdout). Com
+// --comparar, as linhas são conferidas com as de uma reprodução anterior, feita com
+// outra versão do firmware, e as divergências são listadas; o código de saída é 1 se
+// houver alguma. --repetir roda a gravação n vezes seguidas, com o tempo continuando
+// de onde parou, para medir a vazão com gravações curtas. A vazão, em amostras por
+// segundo, vai para stderr.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "gravacao_formato.h"
+#include "sensores.h"
+#include "configuracao.h"
+#include "alertas.h"
+#include "grafico.h"
+#include "estado_json.h"
+
+#define MAX_DIVERGENCIAS_LISTADAS 10
+
+// ============================================================================
+// === Modelo dos dispositivos ===
+
+#define BMP280_ENDERECO 0x76
+#define AHT20_STATUS_OCIOSO 0x18 // Calibrado, sem medição em andamento
+
+typedef struct
+{
+    gravacao_sensor_t g;
+    uint8_t endereco;
+    uint8_t registrador; // BMP280: próximo registrador lido
+    uint8_t quadro[GRAVACAO_TAM_QUADRO]; // Último quadro entregue pela gravação
+} dispositivo_t;
+
+static dispositivo_t dispositivos[GRAVACAO_MAX_SENSORES];
+static int num_dispositivos;
+static uint8_t selecao_mux[2][TCA9548A_NUM_ENDERECOS]; // Controle de cada TCA9548A
+static bool mux_presente[2][TCA9548A_NUM_ENDERECOS];
+static const gravacao_ciclo_t *ciclo; // Ciclo em reprodução
+
+static bool eh_mux(uint porta, uint8_t endereco)
+{
+    return endereco >= TCA9548A_ENDERECO_BASE && endereco < TCA9548A_ENDERECO_BASE + TCA9548A_NUM_ENDERECOS &&
+           mux_presente[porta][endereco - TCA9548A_ENDERECO_BASE];
+}
+
+// Dispositivo que responde no endereço com a seleção atual dos multiplexadores
+static int buscar(uint porta, uint8_t endereco)
+{
+    for (int i = 0; i < num_dispositivos; i++)
+    {
+        const dispositivo_t *d = &dispositivos[i];
+        if (d->g.porta != porta || d->endereco != endereco)
+        {
+            continue;
+        }
+        if (d->g.mux == SENSOR_SEM_MUX ||
+            (selecao_mux[porta][d->g.mux - TCA9548A_ENDERECO_BASE] & (1u << d->g.canal_mux)))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint8_t estado_no_ciclo(int i)
+{
+    return ciclo ? ciclo->estado[i] : GRAVACAO_VALIDO;
+}
+
+// Sensor que falhou no ciclo não reconhece nada; com leitura válida, só o disparo da
+// próxima medição tinha falhado
+static bool sem_ack(int i, bool escrita)
+{
+    uint8_t estado = estado_no_ciclo(i);
+    return (estado & GRAVACAO_FALHA) && (!(estado & GRAVACAO_VALIDO) || escrita);
+}
+
+static int escrever(uint porta, uint8_t endereco, const uint8_t *dados, size_t tam)
+{
+    if (eh_mux(porta, endereco))
+    {
+        selecao_mux[porta][endereco - TCA9548A_ENDERECO_BASE] = tam > 0 ? dados[tam - 1] : 0;
+        return (int)tam;
+    }
+    int i = buscar(porta, endereco);
+    if (i < 0 || sem_ack(i, dispositivos[i].g.modelo == GRAVACAO_MODELO_AHT20))
+    {
+        return PICO_ERROR_GENERIC;
+    }
+    if (dispositivos[i].g.modelo == GRAVACAO_MODELO_BMP280 && tam > 0)
+    {
+        dispositivos[i].registrador = dados[0];
+    }
+    return (int)tam;
+}
+
+static uint8_t registrador_bmp280(const dispositivo_t *d, uint8_t r)
+{
+    if (r == REG_ID)
+    {
+        return BMP280_CHIP_ID;
+    }
+    if (r >= REG_DIG_T1_LSB && r < REG_DIG_T1_LSB + GRAVACAO_TAM_CALIBRACAO)
+    {
+        return d->g.calibracao[r - REG_DIG_T1_LSB];
+    }
+    if (r >= REG_PRESSURE_MSB && r < REG_PRESSURE_MSB + GRAVACAO_TAM_QUADRO)
+    {
+        return d->quadro[r - REG_PRESSURE_MSB];
+    }
+    return 0;
+}
+
+static int ler(uint porta, uint8_t endereco, uint8_t *dados, size_t tam)
+{
+    if (eh_mux(porta, endereco))
+    {
+        memset(dados, selecao_mux[porta][endereco - TCA9548A_ENDERECO_BASE], tam);
+        return (int)tam;
+    }
+    int i = buscar(porta, endereco);
+    if (i < 0 || sem_ack(i, false))
+    {
+        return PICO_ERROR_GENERIC;
+    }
+
+    dispositivo_t *d = &dispositivos[i];
+    if (ciclo && (ciclo->estado[i] & GRAVACAO_VALIDO))
+    {
+        memcpy(d->quadro, ciclo->quadro[i], GRAVACAO_TAM_QUADRO);
+    }
+    if (d->g.modelo == GRAVACAO_MODELO_BMP280)
+    {
+        for (size_t n = 0; n < tam; n++)
+        {
+            dados[n] = registrador_bmp280(d, (uint8_t)(d->registrador + n));
+        }
+    }
+    else if (tam == GRAVACAO_TAM_QUADRO)
+    {
+        memcpy(dados, d->quadro, tam);
+    }
+    else
+    {
+        memset(dados, 0, tam);
+        dados[0] = AHT20_STATUS_OCIOSO;
+    }
+    return (int)tam;
+}
+
+static const host_i2c_dispositivos_t modelo = {escrever, ler};
+
+static void montar_modelo(const uint8_t *tabela, uint8_t num_sensores)
+{
+    num_dispositivos = num_sensores;
+    for (int i = 0; i < num_sensores; i++)
+    {
+        dispositivo_t *d = &dispositivos[i];
+        gravacao_decodificar_sensor(tabela + i * GRAVACAO_TAM_SENSOR, &d->g);
+        d->endereco = d->g.modelo == GRAVACAO_MODELO_BMP280 ? BMP280_ENDERECO : AHT20_I2C_ADDR;
+        if (d->g.modelo == GRAVACAO_MODELO_AHT20)
+        {
+            d->quadro[0] = AHT20_STATUS_OCIOSO;
+        }
+        if (d->g.mux != SENSOR_SEM_MUX)
+        {
+            mux_presente[d->g.porta & 1][(d->g.mux - TCA9548A_ENDERECO_BASE) & 7] = true;
+        }
+    }
+}
+
+// O registro montado na reprodução precisa repetir o da gravação, na mesma ordem
+static bool conferir_registro(void)
+{
+    if (sensores_quantidade() != num_dispositivos)
+    {
+        return false;
+    }
+    for (int i = 0; i < num_dispositivos; i++)
+    {
+        const sensor_t *s = sensores_obter(i);
+        const gravacao_sensor_t *g = &dispositivos[i].g;
+        const sensor_driver_t *driver = g->modelo == GRAVACAO_MODELO_BMP280 ? &SENSOR_BMP280 : &SENSOR_AHT20;
+        if (s->driver != driver || i2c_hw_index(s->i2c) != g->porta || s->mux != g->mux ||
+            s->canal_mux != g->canal_mux)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// === Saída e comparação ===
+
+static FILE *saida;
+static char *referencia; // Linhas da reprodução anterior, ou NULL sem --comparar
+static const char *proxima_ref;
+static unsigned long linhas, divergencias;
+
+static void emitir(const char *linha)
+{
+    linhas++;
+    if (saida)
+    {
+        fputs(linha, saida);
+    }
+    if (!referencia)
+    {
+        return;
+    }
+
+    // Linha correspondente da referência, com o '\n'
+    const char *ref = proxima_ref && *proxima_ref ? proxima_ref : NULL;
+    const char *fim = ref ? strchr(ref, '\n') : NULL;
+    size_t tam_ref = ref ? (fim ? (size_t)(fim - ref) + 1 : strlen(ref)) : 0;
+    proxima_ref = fim ? fim + 1 : NULL;
+    if (ref && tam_ref == strlen(linha) && memcmp(ref, linha, tam_ref) == 0)
+    {
+        return;
+    }
+
+    if (++divergencias <= MAX_DIVERGENCIAS_LISTADAS)
+    {
+        fprintf(stderr, "linha %lu:\n  ref:  %.*s\n  nova: %s", linhas, ref ? (int)strcspn(ref, "\n") : 5,
+                ref ? ref : "(fim)", linha);
+    }
+}
+
+static char *ler_arquivo(const char *nome, size_t *tam)
+{
+    FILE *f = fopen(nome, "rb");
+    if (!f)
+    {
+        perror(nome);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long t = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *dados = malloc(t > 0 ? (size_t)t + 1 : 1);
+    if (!dados || fread(dados, 1, (size_t)t, f) != (size_t)t)
+    {
+        fprintf(stderr, "falha ao ler %s\n", nome);
+        fclose(f);
+        free(dados);
+        return NULL;
+    }
+    fclose(f);
+    dados[t > 0 ? t : 0] = '\0';
+    *tam = (size_t)t;
+    return dados;
+}
+
+// ============================================================================
+// === Reprodução ===
+
+static void aplicar_configuracao(const gravacao_ciclo_t *c)
+{
+    // Tabelas remontadas dos pontos gravados, como na rota /calibracao
+    calibracao_t tabelas[NUM_GRANDEZAS];
+    for (int g = 0; g < NUM_GRANDEZAS; g++)
+    {
+        float medido[CALIBRACAO_MAX_PONTOS], referencia[CALIBRACAO_MAX_PONTOS];
+        int num = c->num_pontos[g] <= CALIBRACAO_MAX_PONTOS ? c->num_pontos[g] : 0;
+        for (int i = 0; i < num; i++)
+        {
+            medido[i] = (float)c->pontos[g][i][0] / CALIBRACAO_ESCALA;
+            referencia[i] = (float)c->pontos[g][i][1] / CALIBRACAO_ESCALA;
+        }
+        if (!calibracao_montar(&tabelas[g], medido, referencia, num))
+        {
+            tabelas[g] = (calibracao_t){0};
+        }
+    }
+
+    configuracao_t *config = configuracao_alterar();
+    memcpy(config, c->config, sizeof(c->config));
+    memcpy(config->calibracao, tabelas, sizeof(tabelas));
+    configuracao_publicar();
+}
+
+// O que tarefa_aquisicao faz com a amostra, mais o JSON que GET /estado serviria
+static void processar(const gravacao_ciclo_t *c, uint32_t instante_ms)
+{
+    static unsigned long amostras;
+    char linha[512], json[384];
+
+    ciclo = c;
+    host_relogio_us = (uint64_t)instante_ms * 1000u;
+    if (c->flags & GRAVACAO_CICLO_CONFIG)
+    {
+        aplicar_configuracao(c);
+    }
+
+    configuracao_t config;
+    uint32_t versao = configuracao_ler(&config);
+    sensores_coletar();
+    amostra_t amostra = sensores_amostra(&config, instante_ms);
+    grafico_amostra(&amostra);
+    alertas_avaliar(&amostra, &config);
+
+    int ativas;
+    uint8_t saidas = alertas_saidas(&ativas);
+    estado_t estado = {
+        .temperatura = amostra.temperatura,
+        .pressao = amostra.pressao,
+        .umidade = amostra.umidade,
+        .offset_temp = config.offset_temp,
+        .offset_pressao = config.offset_pressao,
+        .offset_umidade = config.offset_umidade,
+        .min_temp = config.min_temp,
+        .max_temp = config.max_temp,
+        .min_pressao = config.min_pressao,
+        .max_pressao = config.max_pressao,
+        .min_umidade = config.min_umidade,
+        .max_umidade = config.max_umidade,
+        .versao = versao,
+    };
+    estado_json(&estado, json, sizeof(json));
+    snprintf(linha, sizeof(linha), "%lu T=%.2f P=%.2f U=%.2f validas=%d%d%d alertas=%02x/%d %s\n",
+             (unsigned long)instante_ms, amostra.temperatura, amostra.pressao, amostra.umidade,
+             amostra.temperatura_valida, amostra.pressao_valida, amostra.umidade_valida, saidas, ativas, json);
+    emitir(linha);
+
+    // Ponto fechado no gráfico (média de GRAFICO_AMOSTRAS_POR_COLUNA amostras)
+    if (++amostras % GRAFICO_AMOSTRAS_POR_COLUNA == 0)
+    {
+        grafico_historico_t h;
+        grafico_exportar(&h);
+        uint8_t ultimo = (uint8_t)((h.proximo + GRAFICO_COLUNAS - 1) % GRAFICO_COLUNAS);
+        snprintf(linha, sizeof(linha), "%lu grafico T=%.3f P=%.3f\n", (unsigned long)instante_ms,
+                 h.valores[0][ultimo], h.valores[1][ultimo]);
+        emitir(linha);
+    }
+}
+
+static double agora_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    const char *arq_gravacao = NULL, *arq_saida = NULL, *arq_referencia = NULL;
+    unsigned long repetir = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc)
+        {
+            arq_saida = argv[++i];
+        }
+        else if (strcmp(argv[i], "--comparar") == 0 && i + 1 < argc)
+        {
+            arq_referencia = argv[++i];
+        }
+        else if (strcmp(argv[i], "--repetir") == 0 && i + 1 < argc)
+        {
+            repetir = strtoul(argv[++i], NULL, 10);
+        }
+        else if (argv[i][0] != '-' && !arq_gravacao)
+        {
+            arq_gravacao = argv[i];
+        }
+        else
+        {
+            arq_gravacao = NULL;
+            break;
+        }
+    }
+    if (!arq_gravacao || repetir == 0)
+    {
+        fprintf(stderr, "uso: %s gravacao.bin [--saida arq] [--comparar ref] [--repetir n]\n", argv[0]);
+        return 2;
+    }
+
+    size_t tam;
+    uint8_t *dados = (uint8_t *)ler_arquivo(arq_gravacao, &tam);
+    if (!dados)
+    {
+        return 2;
+    }
+    gravacao_cabecalho_t cab;
+    if (!gravacao_decodificar_cabecalho(dados, tam, &cab) || cab.num_ciclos == 0)
+    {
+        fprintf(stderr, "%s: gravacao invalida, incompleta ou vazia\n", arq_gravacao);
+        return 1;
+    }
+
+    // Ciclos decodificados de antemão: só o código do firmware entra na medição
+    gravacao_ciclo_t *ciclos = calloc(cab.num_ciclos, sizeof(*ciclos));
+    const uint8_t *p = dados + GRAVACAO_TAM_CABECALHO + (size_t)cab.num_sensores * GRAVACAO_TAM_SENSOR;
+    size_t restante = cab.tam_ciclos;
+    for (uint32_t i = 0; i < cab.num_ciclos; i++)
+    {
+        size_t usado = gravacao_decodificar_ciclo(p, restante, cab.num_sensores, &ciclos[i]);
+        if (usado == 0 || (i == 0 && !(ciclos[0].flags & GRAVACAO_CICLO_CONFIG)))
+        {
+            fprintf(stderr, "%s: ciclo %lu invalido\n", arq_gravacao, (unsigned long)i);
+            return 1;
+        }
+        p += usado;
+        restante -= usado;
+    }
+
+    if (arq_referencia)
+    {
+        size_t tam_ref;
+        referencia = ler_arquivo(arq_referencia, &tam_ref);
+        if (!referencia)
+        {
+            return 2;
+        }
+        proxima_ref = referencia;
+    }
+    saida = arq_saida ? fopen(arq_saida, "w") : (arq_referencia ? NULL : stdout);
+    if (arq_saida && !saida)
+    {
+        perror(arq_saida);
+        return 2;
+    }
+
+    // Boot da estação sobre o modelo: varredura, sondas e leitura da calibração
+    // (sem ciclo em reprodução, todos respondem)
+    montar_modelo(dados + GRAVACAO_TAM_CABECALHO, cab.num_sensores);
+    host_i2c_instalar(&modelo);
+    host_relogio_us = (uint64_t)ciclos[0].instante_ms * 1000u;
+    aplicar_configuracao(&ciclos[0]);
+    static mutex_t mutex_i2c;
+    i2c_inst_t *const portas[] = {i2c0, i2c1};
+    sensores_iniciar(portas, 2, &mutex_i2c);
+    if (!conferir_registro())
+    {
+        fprintf(stderr, "%s: os sensores encontrados nao repetem os da gravacao\n", arq_gravacao);
+        return 1;
+    }
+    alertas_iniciar();
+    sensores_coletar(); // Primeira execução de tarefa_aquisicao: só dispara as medições
+
+    // Cada repetição continua um período depois do último ciclo
+    uint32_t periodo_ms = cab.num_ciclos > 1 ? ciclos[1].instante_ms - ciclos[0].instante_ms : 0;
+    uint32_t duracao_ms = ciclos[cab.num_ciclos - 1].instante_ms - ciclos[0].instante_ms + periodo_ms;
+
+    double inicio = agora_s();
+    for (unsigned long r = 0; r < repetir; r++)
+    {
+        for (uint32_t i = 0; i < cab.num_ciclos; i++)
+        {
+            processar(&ciclos[i], ciclos[i].instante_ms + (uint32_t)(r * duracao_ms));
+        }
+    }
+    double decorrido = agora_s() - inicio;
+
+    double amostras = (double)repetir * cab.num_ciclos;
+    fprintf(stderr, "%.0f amostras (%u sensores) em %.1f ms: %.0f amostras/s\n", amostras, cab.num_sensores,
+            decorrido * 1e3, decorrido > 0 ? amostras / decorrido : 0.0);
+
+    if (referencia)
+    {
+        // Linhas da referência que a reprodução não gerou
+        while (proxima_ref && *proxima_ref)
+        {
+            const char *fim = strchr(proxima_ref, '\n');
+            if (++divergencias <= MAX_DIVERGENCIAS_LISTADAS)
+            {
+                fprintf(stderr, "linha %lu:\n  ref:  %.*s\n  nova: (fim)\n", ++linhas,
+                        fim ? (int)(fim - proxima_ref) : (int)strlen(proxima_ref), proxima_ref);
+            }
+            proxima_ref = fim ? fim + 1 : NULL;
+        }
+        fprintf(stderr, "%s: %lu linhas divergentes\n", divergencias ? "DIVERGE" : "IGUAL", divergencias);
+    }
+    if (saida && saida != stdout)
+    {
+        fclose(saida);
+    }
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+// Servidor HTTP do firmware (servidor_http.c) sobre a pilha TCP simulada de
+// host/shim/lwip_host.c, com os limites de memória do lwipopts.h, para medir com
+// carga_http quantos clientes simultâneos a estação atende.
+//
+// Uso: servidor_http_host [--porta 8080] [--rtt ms] [--duracao s] [--relatorio s]
+//
+// Rotas do firmware, com leituras fixas:
+//   /                                         página (index.h, enviada sem cópia)
+//   /grafico.js                               renderizador dos gráficos
+//   /estado                                   JSON das leituras e da configuração (ETag/304)
+//   /offset/<temp|pressao|umidade>/<valor>    offsets
+//   /limites/<temp|press|umid>/min/<a>/max/<b> limites
+//   POST /config                              lote de offsets e limites ("chave=valor")
+//
+// A cada --relatorio segundos e no fim (--duracao ou Ctrl+C) imprime em stderr a
+// ocupação dos recursos do lwIP (atual/máximo/limite) e os eventos de falta de memória.
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "servidor_http.h"
+#include "configuracao.h"
+#include "estado_json.h"
+#include "estado_resposta.h"
+#include "index.h"
+
+#define ESPERA_MS 10   // Espera máxima de cada volta da pilha
+#define AMOSTRA_MS 500 // Período de tarefa_aquisicao, que republica /estado
+
+static volatile sig_atomic_t parar;
+
+static void ao_sinal(int sinal)
+{
+    (void)sinal;
+    parar = 1;
+}
+
+static uint64_t relogio_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// Leituras fixas e a configuração atual, como montar_estado() no firmware
+static estado_t montar_estado(void)
+{
+    configuracao_t c;
+    uint32_t versao = configuracao_ler(&c);
+    return (estado_t){
+        .temperatura = 25.3f,
+        .pressao = 1013.2f,
+        .umidade = 58.4f,
+        .offset_temp = c.offset_temp,
+        .offset_pressao = c.offset_pressao,
+        .offset_umidade = c.offset_umidade,
+        .min_temp = c.min_temp,
+        .max_temp = c.max_temp,
+        .min_pressao = c.min_pressao,
+        .max_pressao = c.max_pressao,
+        .min_umidade = c.min_umidade,
+        .max_umidade = c.max_umidade,
+        .versao = versao,
+    };
+}
+
+static void tratar_requisicao(const http_requisicao_t *requisicao, http_resposta_t *resp)
+{
+    const char *req = requisicao->texto;
+    char grandeza[16], chave[32];
+    float v1, v2;
+
+    if (strncmp(req, "POST /config ", 13) == 0)
+    {
+        if (!configuracao_definir_lote(requisicao->corpo, requisicao->tam_corpo))
+        {
+            http_resposta_texto(resp, 400, "Lote invalido: chave desconhecida, valor nao numerico ou min > max");
+            return;
+        }
+        int n = configuracao_json(resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = n > 0 && n < HTTP_TAM_CORPO_DINAMICO ? (size_t)n : 0;
+    }
+    else if (sscanf(req, "GET /offset/%15[a-z]/%f", grandeza, &v1) == 2)
+    {
+        snprintf(chave, sizeof(chave), "offset_%s", grandeza);
+        bool ok = configuracao_definir(chave, v1);
+        http_resposta_texto(resp, ok ? 200 : 404, ok ? "Offset atualizado" : "Grandeza desconhecida");
+    }
+    else if (sscanf(req, "GET /limites/%15[a-z]/min/%f/max/%f", grandeza, &v1, &v2) == 3)
+    {
+        bool ok = configuracao_definir_limites(grandeza, v1, v2);
+        http_resposta_texto(resp, ok ? 200 : 404, ok ? "Limites atualizados" : "Grandeza desconhecida");
+    }
+    else if (strstr(req, "GET /estado"))
+    {
+        if (estado_resposta_preencher(requisicao, resp))
+        {
+            return;
+        }
+        estado_t estado = montar_estado();
+        resp->tipo = "application/json";
+        resp->corpo = resp->dinamico;
+        resp->tam_corpo = (size_t)estado_json(&estado, resp->dinamico, HTTP_TAM_CORPO_DINAMICO);
+    }
+    else if (strstr(req, "GET /grafico.js"))
+    {
+        resp->tipo = "application/javascript";
+        resp->corpo = GRAFICO_JS;
+        resp->tam_corpo = sizeof(GRAFICO_JS) - 1;
+        resp->cabecalhos = "Cache-Control: public, max-age=31536000, immutable\r\n";
+    }
+    else
+    {
+        resp->tipo = "text/html";
+        resp->corpo = HTML_BODY;
+        resp->tam_corpo = sizeof(HTML_BODY) - 1;
+    }
+}
+
+static void relatar(uint64_t inicio_us)
+{
+    lwip_host_estatisticas_t e;
+    lwip_host_estatisticas(&e);
+    fprintf(stderr,
+            "[%7.1f s] slots %d/%d | pcb %u/%u/%d | pool %u/%u/%d | heap %u/%u/%d | seg %u/%u/%d | ref %u/%u/%d\n"
+            "            aceitas %u | sem pcb %u (%u ms) | sem pool %u | tcp_write ERR_MEM %u | recusados %u | "
+            "RST servidor %u, cliente %u\n",
+            (host_relogio_us - inicio_us) / 1e6, servidor_http_conexoes_ativas(), HTTP_MAX_CONEXOES,
+            e.pcbs, e.pcbs_max, MEMP_NUM_TCP_PCB, e.pool, e.pool_max, PBUF_POOL_SIZE,
+            e.heap, e.heap_max, MEM_SIZE, e.segs, e.segs_max, MEMP_NUM_TCP_SEG, e.refs, e.refs_max, MEMP_NUM_PBUF,
+            e.aceitas, e.sem_pcb, e.sem_pcb_ms, e.sem_pool, e.escrita_sem_mem, e.recusados, e.abortadas, e.resets);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long porta = 8080, rtt_ms = 0, duracao_s = 0, relatorio_s = 5;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc)
+        {
+            porta = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--rtt") == 0 && i + 1 < argc)
+        {
+            rtt_ms = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--duracao") == 0 && i + 1 < argc)
+        {
+            duracao_s = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--relatorio") == 0 && i + 1 < argc)
+        {
+            relatorio_s = strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "uso: %s [--porta n] [--rtt ms] [--duracao s] [--relatorio s]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    signal(SIGINT, ao_sinal);
+    signal(SIGTERM, ao_sinal);
+    host_relogio_us = relogio_us();
+    lwip_host_configurar((uint32_t)rtt_ms);
+    if (!servidor_http_iniciar((uint16_t)porta, tratar_requisicao))
+    {
+        return 1;
+    }
+    fprintf(stderr, "lwipopts.h: MEM_SIZE %d, PBUF_POOL_SIZE %d, MEMP_NUM_TCP_SEG %d, MEMP_NUM_TCP_PCB %d, "
+                    "TCP_SND_BUF %d, TCP_SND_QUEUELEN %d; RTT simulado %lu ms\n",
+            MEM_SIZE, PBUF_POOL_SIZE, MEMP_NUM_TCP_SEG, MEMP_NUM_TCP_PCB, TCP_SND_BUF, TCP_SND_QUEUELEN, rtt_ms);
+
+    uint64_t inicio_us = host_relogio_us;
+    uint64_t proximo_relatorio_us = inicio_us + relatorio_s * 1000000u;
+    uint64_t proxima_amostra_us = inicio_us;
+    while (!parar)
+    {
+        host_relogio_us = relogio_us();
+        if (duracao_s && host_relogio_us - inicio_us >= duracao_s * 1000000u)
+        {
+            break;
+        }
+        if (relatorio_s && host_relogio_us >= proximo_relatorio_us)
+        {
+            relatar(inicio_us);
+            proximo_relatorio_us += relatorio_s * 1000000u;
+        }
+        if (host_relogio_us >= proxima_amostra_us)
+        {
+            estado_t estado = montar_estado();
+            estado_resposta_atualizar(&estado);
+            proxima_amostra_us += AMOSTRA_MS * 1000u;
+        }
+        lwip_host_processar(ESPERA_MS);
+    }
+    relatar(inicio_us);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef HOST_SHIM_BARRAMENTO_SIMULADO_HPP
+#define HOST_SHIM_BARRAMENTO_SIMULADO_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Barramento simulado para os drivers em C++ (mesma interface de lib/barramento_pico.hpp).
+// Cada endereço é um banco de 256 registradores com ponteiro auto-incrementado, como no
+// BMP280: o primeiro byte escrito posiciona o ponteiro e os seguintes gravam a partir
+// dele. Os testes preenchem 'registradores' direto para simular o dispositivo.
+struct BarramentoSimulado
+{
+    static inline uint8_t registradores[128][256];
+    static inline uint8_t ponteiro[128];
+
+    static int escrever(uint8_t endereco, const uint8_t *dados, size_t tam, bool manter)
+    {
+        (void)manter;
+        if (tam == 0)
+        {
+            return 0;
+        }
+        uint8_t &p = ponteiro[endereco & 0x7F];
+        p = dados[0];
+        for (size_t i = 1; i < tam; i++)
+        {
+            registradores[endereco & 0x7F][p++] = dados[i];
+        }
+        return (int)tam;
+    }
+
+    static int ler(uint8_t endereco, uint8_t *dados, size_t tam, bool manter)
+    {
+        (void)manter;
+        uint8_t &p = ponteiro[endereco & 0x7F];
+        for (size_t i = 0; i < tam; i++)
+        {
+            dados[i] = registradores[endereco & 0x7F][p++];
+        }
+        return (int)tam;
+    }
+};
+
+#endif // HOST_SHIM_BARRAMENTO_SIMULADO_HPP
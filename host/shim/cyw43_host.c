@@ -0,0 +1,87 @@
+#include "pico/cyw43_arch.h"
+
+uint64_t host_relogio_us;
+cyw43_t cyw43_state;
+
+static int resultado = CYW43_LINK_UP;
+static uint32_t ip_resultado;
+static uint32_t atraso_ms;
+
+static int status = CYW43_LINK_DOWN;
+static uint64_t inicio_us; // Início da tentativa em andamento
+static uint32_t tentativas;
+
+int cyw43_arch_init(void)
+{
+    return 0;
+}
+
+void cyw43_arch_enable_sta_mode(void)
+{
+}
+
+int cyw43_arch_wifi_connect_async(const char *ssid, const char *pw, uint32_t auth)
+{
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    tentativas++;
+    status = CYW43_LINK_JOIN;
+    inicio_us = host_relogio_us;
+    cyw43_state.netif[0].ip_addr.addr = 0;
+    return 0;
+}
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf)
+{
+    (void)self;
+    (void)itf;
+    if (status == CYW43_LINK_JOIN && resultado != CYW43_LINK_JOIN &&
+        host_relogio_us - inicio_us >= (uint64_t)atraso_ms * 1000)
+    {
+        status = resultado;
+        if (status == CYW43_LINK_UP)
+        {
+            cyw43_state.netif[0].ip_addr.addr = ip_resultado;
+        }
+    }
+    return status;
+}
+
+int cyw43_wifi_leave(cyw43_t *self, int itf)
+{
+    (void)self;
+    (void)itf;
+    status = CYW43_LINK_DOWN;
+    cyw43_state.netif[0].ip_addr.addr = 0;
+    return 0;
+}
+
+void cyw43_sim_configurar(int novo_resultado, uint32_t ip, uint32_t novo_atraso_ms)
+{
+    resultado = novo_resultado;
+    ip_resultado = ip;
+    atraso_ms = novo_atraso_ms;
+}
+
+void cyw43_sim_derrubar(void)
+{
+    if (status == CYW43_LINK_UP)
+    {
+        status = CYW43_LINK_DOWN;
+        cyw43_state.netif[0].ip_addr.addr = 0;
+    }
+}
+
+void cyw43_sim_trocar_ip(uint32_t ip)
+{
+    if (status == CYW43_LINK_UP)
+    {
+        cyw43_state.netif[0].ip_addr.addr = ip;
+    }
+}
+
+uint32_t cyw43_sim_tentativas(void)
+{
+    return tentativas;
+}
@@ -0,0 +1,46 @@
+#ifndef HOST_SHIM_HARDWARE_GPIO_H
+#define HOST_SHIM_HARDWARE_GPIO_H
+
+// GPIO simulado para a recuperação do barramento (lib/i2c_bus.c): as linhas leem
+// sempre em nível alto, como um barramento livre
+
+#include "pico/stdlib.h"
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+enum gpio_function
+{
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_SIO = 5,
+};
+
+static inline void gpio_init(uint gpio)
+{
+    (void)gpio;
+}
+
+static inline void gpio_set_dir(uint gpio, bool out)
+{
+    (void)gpio;
+    (void)out;
+}
+
+static inline void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    (void)gpio;
+    (void)fn;
+}
+
+static inline void gpio_pull_up(uint gpio)
+{
+    (void)gpio;
+}
+
+static inline bool gpio_get(uint gpio)
+{
+    (void)gpio;
+    return true;
+}
+
+#endif // HOST_SHIM_HARDWARE_GPIO_H
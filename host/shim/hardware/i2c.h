@@ -0,0 +1,73 @@
+#ifndef HOST_SHIM_HARDWARE_I2C_H
+#define HOST_SHIM_HARDWARE_I2C_H
+
+// Barramento I2C simulado (host/shim/i2c_host.c): sem dispositivos instalados,
+// escritas são aceitas e leituras devolvem zeros, o suficiente para exercitar os
+// drivers sem hardware. Com host_i2c_instalar, as transações vão para um modelo dos
+// dispositivos (ex.: a reprodução de uma gravação em host/reproduzir.c).
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct i2c_inst i2c_inst_t;
+
+// As duas portas do RP2040
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+int i2c_write_timeout_per_char_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                                  uint timeout_per_char_us);
+int i2c_read_timeout_per_char_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop,
+                                 uint timeout_per_char_us);
+
+static inline int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                                       uint timeout_us)
+{
+    (void)timeout_us;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+static inline int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop,
+                                      uint timeout_us)
+{
+    (void)timeout_us;
+    return i2c_read_blocking(i2c, addr, dst, len, nostop);
+}
+
+static inline uint i2c_hw_index(i2c_inst_t *i2c)
+{
+    return i2c == i2c1 ? 1 : 0;
+}
+
+static inline uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+static inline void i2c_deinit(i2c_inst_t *i2c)
+{
+    (void)i2c;
+}
+
+// Modelo dos dispositivos: recebe cada transação com a porta (0 ou 1) e devolve, como
+// o SDK, os bytes transferidos ou PICO_ERROR_GENERIC (sem ACK). NULL desinstala.
+typedef struct
+{
+    int (*escrever)(uint porta, uint8_t endereco, const uint8_t *dados, size_t tam);
+    int (*ler)(uint porta, uint8_t endereco, uint8_t *dados, size_t tam);
+} host_i2c_dispositivos_t;
+
+void host_i2c_instalar(const host_i2c_dispositivos_t *dispositivos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_SHIM_HARDWARE_I2C_H
@@ -0,0 +1,23 @@
+#ifndef HOST_SHIM_HARDWARE_SYNC_H
+#define HOST_SHIM_HARDWARE_SYNC_H
+
+// Sem interrupções nem segundo núcleo no host: o seqlock de configuracao.c vira uma
+// cópia simples
+
+#include "pico/stdlib.h"
+
+static inline uint32_t save_and_disable_interrupts(void)
+{
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t estado)
+{
+    (void)estado;
+}
+
+static inline void __dmb(void)
+{
+}
+
+#endif // HOST_SHIM_HARDWARE_SYNC_H
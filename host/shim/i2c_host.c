@@ -0,0 +1,52 @@
+#include "hardware/i2c.h"
+
+#include <string.h>
+
+struct i2c_inst
+{
+    uint8_t porta;
+};
+
+i2c_inst_t i2c0_inst = {0}, i2c1_inst = {1};
+
+static const host_i2c_dispositivos_t *modelo;
+
+void host_i2c_instalar(const host_i2c_dispositivos_t *dispositivos)
+{
+    modelo = dispositivos;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)nostop;
+    if (modelo)
+    {
+        return modelo->escrever(i2c_hw_index(i2c), addr, src, len);
+    }
+    return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    (void)nostop;
+    if (modelo)
+    {
+        return modelo->ler(i2c_hw_index(i2c), addr, dst, len);
+    }
+    memset(dst, 0, len);
+    return (int)len;
+}
+
+int i2c_write_timeout_per_char_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                                  uint timeout_per_char_us)
+{
+    (void)timeout_per_char_us;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+int i2c_read_timeout_per_char_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop,
+                                 uint timeout_per_char_us)
+{
+    (void)timeout_per_char_us;
+    return i2c_read_blocking(i2c, addr, dst, len, nostop);
+}
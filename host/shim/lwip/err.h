@@ -0,0 +1,37 @@
+#ifndef HOST_SHIM_LWIP_ERR_H
+#define HOST_SHIM_LWIP_ERR_H
+
+// Tipos e códigos de erro do lwIP 2.1 (lwip/arch.h e lwip/err.h)
+
+#include <stdint.h>
+
+typedef uint8_t u8_t;
+typedef int8_t s8_t;
+typedef uint16_t u16_t;
+typedef int16_t s16_t;
+typedef uint32_t u32_t;
+
+typedef s8_t err_t;
+
+typedef enum
+{
+    ERR_OK = 0,
+    ERR_MEM = -1,
+    ERR_BUF = -2,
+    ERR_TIMEOUT = -3,
+    ERR_RTE = -4,
+    ERR_INPROGRESS = -5,
+    ERR_VAL = -6,
+    ERR_WOULDBLOCK = -7,
+    ERR_USE = -8,
+    ERR_ALREADY = -9,
+    ERR_ISCONN = -10,
+    ERR_CONN = -11,
+    ERR_IF = -12,
+    ERR_ABRT = -13,
+    ERR_RST = -14,
+    ERR_CLSD = -15,
+    ERR_ARG = -16,
+} err_enum_t;
+
+#endif // HOST_SHIM_LWIP_ERR_H
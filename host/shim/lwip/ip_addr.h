@@ -0,0 +1,14 @@
+#ifndef HOST_SHIM_LWIP_IP_ADDR_H
+#define HOST_SHIM_LWIP_IP_ADDR_H
+
+#include "lwip/err.h"
+
+typedef struct
+{
+    u32_t addr;
+} ip_addr_t;
+
+extern const ip_addr_t ip_addr_any;
+#define IP_ADDR_ANY (&ip_addr_any)
+
+#endif // HOST_SHIM_LWIP_IP_ADDR_H
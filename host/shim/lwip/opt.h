@@ -0,0 +1,32 @@
+#ifndef HOST_SHIM_LWIP_OPT_H
+#define HOST_SHIM_LWIP_OPT_H
+
+// Limites do lwIP do firmware (lwipopts.h, na raiz do repositório) e os padrões do
+// lwIP 2.1 que ele não redefine, usados pela pilha TCP simulada (host/shim/lwip_host.c)
+
+#include "lwipopts.h"
+
+#ifndef MEMP_NUM_PBUF
+#define MEMP_NUM_PBUF 16 // pbufs que apontam para dados sem cópia (tcp_write sem COPY)
+#endif
+
+#ifndef MEMP_NUM_TCP_PCB_LISTEN
+#define MEMP_NUM_TCP_PCB_LISTEN 8
+#endif
+
+#ifndef TCP_DEFAULT_LISTEN_BACKLOG
+#define TCP_DEFAULT_LISTEN_BACKLOG 0xff
+#endif
+
+// Temporizador rápido (reentrega de dados recusados) e lento (tcp_poll), em ms
+#ifndef TCP_TMR_INTERVAL
+#define TCP_TMR_INTERVAL 250
+#endif
+#define TCP_SLOW_INTERVAL (2 * TCP_TMR_INTERVAL)
+
+// FIN_WAIT_2 sem o FIN do cliente depois de tcp_close
+#ifndef TCP_FIN_WAIT_TIMEOUT
+#define TCP_FIN_WAIT_TIMEOUT 20000
+#endif
+
+#endif // HOST_SHIM_LWIP_OPT_H
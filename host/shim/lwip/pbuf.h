@@ -0,0 +1,26 @@
+#ifndef HOST_SHIM_LWIP_PBUF_H
+#define HOST_SHIM_LWIP_PBUF_H
+
+// pbufs recebidos pela pilha TCP simulada: sempre um só bloco do pool
+// (PBUF_POOL_SIZE blocos de até TCP_MSS bytes)
+
+#include "lwip/err.h"
+
+struct pbuf
+{
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;
+    u16_t len;
+};
+
+// Devolve a cadeia ao pool. Retorna o número de pbufs liberados.
+u8_t pbuf_free(struct pbuf *p);
+
+// Copia até 'len' bytes a partir de 'offset'. Retorna quantos foram copiados.
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset);
+
+// Descarta os primeiros 'size' bytes da cadeia. Retorna o que sobrou (NULL se nada).
+struct pbuf *pbuf_free_header(struct pbuf *q, u16_t size);
+
+#endif // HOST_SHIM_LWIP_PBUF_H
@@ -0,0 +1,95 @@
+#ifndef HOST_SHIM_LWIP_TCP_H
+#define HOST_SHIM_LWIP_TCP_H
+
+// API TCP "raw" do lwIP 2.1 sobre sockets do Linux (host/shim/lwip_host.c), para rodar
+// servidor_http.c no host com os mesmos limites de memória do firmware (lwipopts.h).
+//
+// Cada PCB conectado é um socket não bloqueante, e os callbacks são chamados de um
+// único laço (lwip_host_processar), como no firmware, onde rodam no contexto do lwIP.
+// O que o lwIP recusaria por falta de memória é recusado aqui também:
+//   MEMP_NUM_TCP_PCB  conexões; além disso o SYN fica sem resposta (aqui, na fila do kernel)
+//   PBUF_POOL_SIZE    segmentos recebidos e não liberados pela aplicação (pbufs recusados
+//                     inclusos); sem pbuf livre o segmento é descartado (aqui, fica no kernel)
+//   MEM_SIZE          pbufs das escritas com TCP_WRITE_FLAG_COPY e cabeçalhos dos
+//                     segmentos, até o ACK; o excesso faz tcp_write retornar ERR_MEM
+//   MEMP_NUM_TCP_SEG  segmentos na fila de envio de todas as conexões
+//   MEMP_NUM_PBUF     pbufs que apontam para dados sem cópia
+//   TCP_SND_BUF e TCP_SND_QUEUELEN  bytes e pbufs na fila de envio de cada conexão
+// O ACK do cliente é simulado: chega 'rtt_ms' depois de o segmento ir para o socket.
+// Não são simulados: perdas e retransmissões, janela de congestionamento e
+// fragmentação do heap (o uso é somado, não alocado).
+
+#include <stdbool.h>
+
+#include "lwip/opt.h"
+#include "lwip/err.h"
+#include "lwip/pbuf.h"
+#include "lwip/ip_addr.h"
+
+struct tcp_pcb;
+
+typedef err_t (*tcp_accept_fn)(void *arg, struct tcp_pcb *newpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef err_t (*tcp_poll_fn)(void *arg, struct tcp_pcb *tpcb);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+#define SOF_REUSEADDR 0x04
+
+struct tcp_pcb *tcp_new(void);
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port);
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog);
+#define tcp_listen(pcb) tcp_listen_with_backlog(pcb, TCP_DEFAULT_LISTEN_BACKLOG)
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept);
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len);
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags);
+err_t tcp_output(struct tcp_pcb *pcb);
+u16_t tcp_sndbuf(const struct tcp_pcb *pcb);
+u16_t tcp_sndqueuelen(const struct tcp_pcb *pcb);
+err_t tcp_close(struct tcp_pcb *pcb);
+void tcp_abort(struct tcp_pcb *pcb);
+
+// No lwIP é uma macro sobre os campos do PCB (lwip/ip.h)
+void ip_set_option(struct tcp_pcb *pcb, u8_t opt);
+
+// === Controle da pilha simulada ===
+
+// Atraso entre o envio de um segmento e o ACK simulado do cliente (padrão: 0)
+void lwip_host_configurar(uint32_t rtt_ms);
+
+// Uma volta da pilha: espera até 'espera_ms' por atividade nos sockets, aceita
+// conexões, entrega os dados recebidos, confirma os segmentos cujo ACK venceu e roda os
+// temporizadores. O relógio é host_relogio_us: o chamador o atualiza antes de cada volta.
+void lwip_host_processar(uint32_t espera_ms);
+
+// Ocupação dos recursos (atual e máxima) e eventos de falta de memória
+typedef struct
+{
+    uint32_t pcbs, pcbs_max;   // MEMP_NUM_TCP_PCB
+    uint32_t pool, pool_max;   // PBUF_POOL_SIZE
+    uint32_t heap, heap_max;   // MEM_SIZE, em bytes
+    uint32_t segs, segs_max;   // MEMP_NUM_TCP_SEG
+    uint32_t refs, refs_max;   // MEMP_NUM_PBUF
+    uint32_t aceitas;          // conexões entregues ao callback de accept
+    uint32_t sem_pcb;          // vezes em que uma conexão ficou esperando um PCB livre
+    uint32_t sem_pcb_ms;       // ... e o tempo total de espera
+    uint32_t sem_pool;         // segmentos que chegaram sem pbuf livre no pool
+    uint32_t escrita_sem_mem;  // tcp_write com ERR_MEM
+    uint32_t recusados;        // pbufs recusados pelo callback de recepção
+    uint32_t abortadas;        // conexões encerradas com RST pelo servidor
+    uint32_t resets;           // conexões encerradas com RST pelo cliente
+} lwip_host_estatisticas_t;
+
+void lwip_host_estatisticas(lwip_host_estatisticas_t *e);
+
+#endif // HOST_SHIM_LWIP_TCP_H
@@ -0,0 +1,1084 @@
+#define _GNU_SOURCE // accept4
+
+// Cabeçalhos do sistema antes dos do lwIP: netinet/tcp.h define TCP_MSS (512), e o
+// valor que vale aqui é o do lwipopts.h
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#undef TCP_MSS
+
+#include "lwip/tcp.h"
+#include "pico/stdlib.h"
+
+// Custos de memória no firmware (ARM, 32 bits), somados no heap como o lwIP alocaria:
+// cabeçalho de cada bloco do heap, struct pbuf e o espaço reservado para os cabeçalhos
+// TCP + IP + Ethernet de um pbuf PBUF_TRANSPORT
+#define TAM_STRUCT_MEM 8
+#define TAM_STRUCT_PBUF 16
+#define TAM_CABECALHOS (20 + 20 + 14)
+#define ALINHAR(x) (((x) + MEM_ALIGNMENT - 1u) & ~(MEM_ALIGNMENT - 1u))
+
+// Segmento na fila de envio. Os dados ficam sempre aqui (no firmware, os enviados sem
+// TCP_WRITE_FLAG_COPY continuam na memória da aplicação); heap, pbufs e refs são o que o
+// lwIP teria alocado para ele.
+typedef struct segmento
+{
+    struct segmento *prox;
+    char dados[TCP_MSS];
+    u16_t tam;            // bytes no segmento
+    u16_t sobra;          // espaço alocado além de 'tam' no último pbuf (TCP_OVERSIZE)
+    u16_t enviados;       // bytes já entregues ao socket
+    const char *fim_ref;  // fim dos dados do último pbuf sem cópia (escrita contígua o estende)
+    uint32_t heap;        // bytes do heap
+    u8_t pbufs;           // pbufs do segmento (snd_queuelen)
+    u8_t refs;            // pbufs sem cópia (MEMP_NUM_PBUF)
+    bool fin;
+    uint64_t ack_us;      // instante do ACK simulado
+} segmento_t;
+
+typedef enum
+{
+    PCB_LIVRE,
+    PCB_NOVO,      // tcp_new, ainda sem escutar
+    PCB_ESCUTA,
+    PCB_CONECTADO, // ESTABLISHED ou CLOSE_WAIT
+    PCB_FECHANDO,  // tcp_close: FIN na fila, esperando o ACK e o FIN do cliente
+    PCB_MORTO,     // liberado; o slot volta à tabela na próxima volta do laço
+} estado_pcb_t;
+
+struct tcp_pcb
+{
+    estado_pcb_t estado;
+    int fd;
+    u8_t opcoes;
+    void *arg;
+    tcp_accept_fn aceitar;
+    tcp_recv_fn receber;
+    tcp_sent_fn enviado;
+    tcp_poll_fn sondar;
+    tcp_err_fn erro;
+    u8_t intervalo_poll;
+    u8_t contador_poll;
+    u16_t snd_buf;
+    u16_t snd_queuelen;
+    segmento_t *nao_enviados; // unsent
+    segmento_t *sem_ack;      // unacked
+    u32_t janela;             // janela de recepção ainda não devolvida por tcp_recved
+    struct pbuf *recusado;    // pbuf recusado pela aplicação, reentregue depois
+    bool fin_recebido;        // cliente encerrou o envio
+    bool fin_entregue;        // ... e a aplicação já recebeu p == NULL
+    bool socket_cheio;        // o último send() não coube: espera POLLOUT
+    bool falhou;              // send() falhou (cliente sumiu): RST na próxima volta
+    bool erro_memoria;        // tcp_write falhou: a fila sai sem esperar pelo Nagle
+    uint64_t fechado_us;      // instante do tcp_close
+};
+
+typedef struct
+{
+    struct pbuf p; // primeiro campo: pbuf_free volta ao bloco pelo ponteiro
+    bool em_uso;
+    char dados[TCP_MSS];
+} bloco_pool_t;
+
+// Custo de uma escrita: somado antes, para a tcp_write ser tudo ou nada como no lwIP
+typedef struct
+{
+    uint32_t heap, segs, refs, pbufs;
+} custo_t;
+
+const ip_addr_t ip_addr_any;
+
+static struct tcp_pcb pcbs[MEMP_NUM_TCP_PCB];
+static struct tcp_pcb escutas[MEMP_NUM_TCP_PCB_LISTEN];
+static bloco_pool_t pool[PBUF_POOL_SIZE];
+
+static lwip_host_estatisticas_t est;
+static uint32_t rtt_us;
+static uint64_t proximo_rapido_us, proximo_lento_us;
+static uint64_t espera_pcb_us; // início da espera por um PCB livre (0: ninguém esperando)
+static uint64_t esperou_pcb_us;
+
+static void ocupar(uint32_t *uso, uint32_t *max, uint32_t qtd)
+{
+    *uso += qtd;
+    if (*uso > *max)
+    {
+        *max = *uso;
+    }
+}
+
+static u16_t menor(u32_t a, u32_t b)
+{
+    return (u16_t)(a < b ? a : b);
+}
+
+// Bytes do heap ocupados por um pbuf PBUF_RAM com 'tam' bytes de dados
+static uint32_t custo_pbuf(uint32_t tam, bool cabecalhos)
+{
+    return TAM_STRUCT_MEM + ALINHAR(TAM_STRUCT_PBUF + (cabecalhos ? TAM_CABECALHOS : 0) + tam);
+}
+
+static segmento_t *ultimo_segmento(segmento_t *s)
+{
+    while (s && s->prox)
+    {
+        s = s->prox;
+    }
+    return s;
+}
+
+static void anexar(segmento_t **fila, segmento_t *s)
+{
+    while (*fila)
+    {
+        fila = &(*fila)->prox;
+    }
+    s->prox = NULL;
+    *fila = s;
+}
+
+static void liberar_segmento(struct tcp_pcb *pcb, segmento_t *s)
+{
+    est.heap -= s->heap;
+    est.segs--;
+    est.refs -= s->refs;
+    pcb->snd_queuelen -= s->pbufs;
+    free(s);
+}
+
+// ============================================================================
+// === pbufs ===
+
+static struct pbuf *alocar_pool(void)
+{
+    for (int i = 0; i < PBUF_POOL_SIZE; i++)
+    {
+        if (!pool[i].em_uso)
+        {
+            pool[i].em_uso = true;
+            pool[i].p.next = NULL;
+            pool[i].p.payload = pool[i].dados;
+            ocupar(&est.pool, &est.pool_max, 1);
+            return &pool[i].p;
+        }
+    }
+    return NULL;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+    u8_t n = 0;
+    while (p)
+    {
+        struct pbuf *prox = p->next;
+        ((bloco_pool_t *)p)->em_uso = false;
+        est.pool--;
+        n++;
+        p = prox;
+    }
+    return n;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset)
+{
+    u16_t copiados = 0;
+    for (; p && copiados < len; p = p->next)
+    {
+        if (offset >= p->len)
+        {
+            offset -= p->len;
+            continue;
+        }
+        u16_t n = menor(p->len - offset, len - copiados);
+        memcpy((char *)dataptr + copiados, (const char *)p->payload + offset, n);
+        copiados += n;
+        offset = 0;
+    }
+    return copiados;
+}
+
+struct pbuf *pbuf_free_header(struct pbuf *q, u16_t size)
+{
+    while (q && size >= q->len)
+    {
+        struct pbuf *prox = q->next;
+        size -= q->len;
+        q->next = NULL;
+        pbuf_free(q);
+        q = prox;
+    }
+    if (q && size > 0)
+    {
+        q->payload = (char *)q->payload + size;
+        q->len -= size;
+        q->tot_len -= size;
+    }
+    return q;
+}
+
+// ============================================================================
+// === PCBs ===
+
+static struct tcp_pcb *alocar_pcb(struct tcp_pcb *tabela, int tam)
+{
+    for (int i = 0; i < tam; i++)
+    {
+        if (tabela[i].estado == PCB_LIVRE)
+        {
+            memset(&tabela[i], 0, sizeof(tabela[i]));
+            tabela[i].fd = -1;
+            tabela[i].snd_buf = TCP_SND_BUF;
+            tabela[i].janela = TCP_WND;
+            return &tabela[i];
+        }
+    }
+    return NULL;
+}
+
+// Fecha o socket (com RST se pedido) e devolve os recursos do PCB
+static void descartar(struct tcp_pcb *pcb, bool rst)
+{
+    if (pcb->fd >= 0)
+    {
+        if (rst)
+        {
+            struct linger l = {.l_onoff = 1, .l_linger = 0};
+            setsockopt(pcb->fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+        }
+        close(pcb->fd);
+        pcb->fd = -1;
+    }
+    while (pcb->nao_enviados)
+    {
+        segmento_t *s = pcb->nao_enviados;
+        pcb->nao_enviados = s->prox;
+        liberar_segmento(pcb, s);
+    }
+    while (pcb->sem_ack)
+    {
+        segmento_t *s = pcb->sem_ack;
+        pcb->sem_ack = s->prox;
+        liberar_segmento(pcb, s);
+    }
+    if (pcb->recusado)
+    {
+        pbuf_free(pcb->recusado);
+        pcb->recusado = NULL;
+    }
+    if (pcb->estado != PCB_ESCUTA && pcb->estado != PCB_MORTO)
+    {
+        est.pcbs--;
+    }
+    pcb->estado = PCB_MORTO;
+}
+
+// Conexão desfeita pelo cliente: o lwIP avisa pelo callback de erro, com o PCB já liberado
+static void resetar(struct tcp_pcb *pcb)
+{
+    tcp_err_fn erro = pcb->erro;
+    void *arg = pcb->arg;
+    est.resets++;
+    descartar(pcb, false);
+    if (erro)
+    {
+        erro(arg, ERR_RST);
+    }
+}
+
+struct tcp_pcb *tcp_new(void)
+{
+    struct tcp_pcb *pcb = alocar_pcb(pcbs, MEMP_NUM_TCP_PCB);
+    if (pcb)
+    {
+        pcb->estado = PCB_NOVO;
+        ocupar(&est.pcbs, &est.pcbs_max, 1);
+    }
+    return pcb;
+}
+
+void ip_set_option(struct tcp_pcb *pcb, u8_t opt)
+{
+    pcb->opcoes |= opt;
+}
+
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        return ERR_MEM;
+    }
+    int um = 1;
+    if (pcb->opcoes & SOF_REUSEADDR)
+    {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+    }
+    struct sockaddr_in endereco = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = ipaddr ? ipaddr->addr : 0, // ip_addr_t já está na ordem da rede
+    };
+    if (bind(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0)
+    {
+        close(fd);
+        return ERR_USE;
+    }
+    if (pcb->fd >= 0)
+    {
+        close(pcb->fd);
+    }
+    pcb->fd = fd;
+    return ERR_OK;
+}
+
+// Como no lwIP, o PCB de escuta é outro (menor) e o original é liberado
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog)
+{
+    struct tcp_pcb *escuta = alocar_pcb(escutas, MEMP_NUM_TCP_PCB_LISTEN);
+    if (!escuta || pcb->fd < 0 || listen(pcb->fd, backlog) != 0)
+    {
+        return NULL;
+    }
+    escuta->estado = PCB_ESCUTA;
+    escuta->fd = pcb->fd;
+    escuta->arg = pcb->arg;
+    escuta->opcoes = pcb->opcoes;
+    pcb->fd = -1;
+    descartar(pcb, false);
+    return escuta;
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg)
+{
+    pcb->arg = arg;
+}
+
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept)
+{
+    pcb->aceitar = accept;
+}
+
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv)
+{
+    pcb->receber = recv;
+}
+
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent)
+{
+    pcb->enviado = sent;
+}
+
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval)
+{
+    pcb->sondar = poll;
+    pcb->intervalo_poll = interval;
+}
+
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err)
+{
+    pcb->erro = err;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len)
+{
+    pcb->janela += len;
+    if (pcb->janela > TCP_WND)
+    {
+        pcb->janela = TCP_WND;
+    }
+}
+
+u16_t tcp_sndbuf(const struct tcp_pcb *pcb)
+{
+    return pcb->snd_buf;
+}
+
+u16_t tcp_sndqueuelen(const struct tcp_pcb *pcb)
+{
+    return pcb->snd_queuelen;
+}
+
+// ============================================================================
+// === Envio ===
+
+// Tamanho do pbuf alocado para 'tam' bytes com cópia: o lwIP reserva até um MSS a mais
+// quando espera mais dados (TCP_WRITE_FLAG_MORE, ou Nagle com dados na fila)
+static u16_t prealocar(const struct tcp_pcb *pcb, u16_t tam, u16_t max, u8_t flags, bool primeiro)
+{
+    if (tam < max && ((flags & TCP_WRITE_FLAG_MORE) || !primeiro || pcb->nao_enviados || pcb->sem_ack))
+    {
+        return menor(ALINHAR(tam + TCP_MSS), max);
+    }
+    return tam;
+}
+
+// Percorre as três etapas da tcp_write do lwIP: completa o espaço que sobrou no último
+// pbuf (copiando mesmo sem COPY), encadeia um pbuf no último segmento enquanto ele não
+// tem um MSS e cria segmentos novos para o resto. Sem 'aplicar' apenas soma o custo.
+static void enfileirar(struct tcp_pcb *pcb, const char *dados, u16_t len, u8_t flags, bool aplicar, custo_t *custo)
+{
+    bool copiar = flags & TCP_WRITE_FLAG_COPY;
+    segmento_t *ultimo = ultimo_segmento(pcb->nao_enviados);
+    u16_t pos = 0;
+    memset(custo, 0, sizeof(*custo));
+
+    if (ultimo && !ultimo->fin)
+    {
+        u16_t n = menor(ultimo->sobra, len);
+        u16_t tam = ultimo->tam + n;
+        u16_t espaco = TCP_MSS - tam;
+        if (aplicar && n > 0)
+        {
+            memcpy(ultimo->dados + ultimo->tam, dados, n);
+            ultimo->tam = tam;
+            ultimo->sobra -= n;
+        }
+        pos = n;
+
+        if (pos < len && espaco > 0 && tam > 0)
+        {
+            u16_t m = menor(len - pos, espaco);
+            u16_t sobra = 0;
+            uint32_t heap = 0;
+            u8_t pbufs = 0, refs = 0;
+            if (copiar)
+            {
+                u16_t alocado = prealocar(pcb, m, espaco, flags, true);
+                heap = custo_pbuf(alocado, false);
+                sobra = alocado - m;
+                pbufs = 1;
+            }
+            else if (ultimo->fim_ref != dados + pos)
+            {
+                pbufs = 1;
+                refs = 1;
+            }
+            custo->heap += heap;
+            custo->pbufs += pbufs;
+            custo->refs += refs;
+            if (aplicar)
+            {
+                memcpy(ultimo->dados + tam, dados + pos, m);
+                ultimo->tam = tam + m;
+                ultimo->sobra = sobra;
+                ultimo->fim_ref = copiar ? NULL : dados + pos + m;
+                ultimo->heap += heap;
+                ultimo->pbufs += pbufs;
+                ultimo->refs += refs;
+            }
+            pos += m;
+        }
+    }
+
+    for (bool primeiro = true; pos < len; primeiro = false)
+    {
+        u16_t m = menor(len - pos, TCP_MSS);
+        u16_t sobra = 0;
+        uint32_t heap;
+        u8_t pbufs, refs;
+        if (copiar)
+        {
+            u16_t alocado = prealocar(pcb, m, TCP_MSS, flags, primeiro);
+            heap = custo_pbuf(alocado, true);
+            sobra = alocado - m;
+            pbufs = 1;
+            refs = 0;
+        }
+        else
+        {
+            heap = custo_pbuf(0, true); // pbuf só com os cabeçalhos, encadeado aos dados
+            pbufs = 2;
+            refs = 1;
+        }
+        custo->heap += heap;
+        custo->pbufs += pbufs;
+        custo->refs += refs;
+        custo->segs++;
+        if (aplicar)
+        {
+            segmento_t *s = calloc(1, sizeof(*s));
+            memcpy(s->dados, dados + pos, m);
+            s->tam = m;
+            s->sobra = sobra;
+            s->fim_ref = copiar ? NULL : dados + pos + m;
+            s->heap = heap;
+            s->pbufs = pbufs;
+            s->refs = refs;
+            anexar(&pcb->nao_enviados, s);
+        }
+        pos += m;
+    }
+}
+
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags)
+{
+    if (pcb->estado != PCB_CONECTADO)
+    {
+        return ERR_CONN;
+    }
+    if (len == 0)
+    {
+        return ERR_OK;
+    }
+
+    custo_t custo;
+    enfileirar(pcb, dataptr, len, apiflags, false, &custo);
+    if (len > pcb->snd_buf || pcb->snd_queuelen >= TCP_SND_QUEUELEN ||
+        pcb->snd_queuelen + custo.pbufs > TCP_SND_QUEUELEN ||
+        est.heap + custo.heap > MEM_SIZE ||
+        est.segs + custo.segs > MEMP_NUM_TCP_SEG ||
+        est.refs + custo.refs > MEMP_NUM_PBUF)
+    {
+        est.escrita_sem_mem++;
+        pcb->erro_memoria = true;
+        return ERR_MEM;
+    }
+
+    enfileirar(pcb, dataptr, len, apiflags, true, &custo);
+    ocupar(&est.heap, &est.heap_max, custo.heap);
+    ocupar(&est.segs, &est.segs_max, custo.segs);
+    ocupar(&est.refs, &est.refs_max, custo.refs);
+    pcb->snd_buf -= len;
+    pcb->snd_queuelen += custo.pbufs;
+    return ERR_OK;
+}
+
+// Entrega ao socket os segmentos da fila. Um erro aqui só marca o PCB: a aplicação
+// ainda o está usando, e o RST é tratado na próxima volta do laço.
+err_t tcp_output(struct tcp_pcb *pcb)
+{
+    if (pcb->estado != PCB_CONECTADO && pcb->estado != PCB_FECHANDO)
+    {
+        return ERR_OK;
+    }
+
+    while (pcb->nao_enviados && !pcb->falhou)
+    {
+        segmento_t *s = pcb->nao_enviados;
+
+        // Nagle: um único segmento incompleto espera o ACK do que já foi enviado
+        if (s->enviados == 0 && pcb->sem_ack && !s->prox && s->tam < TCP_MSS && !s->fin &&
+            pcb->estado == PCB_CONECTADO && !pcb->erro_memoria &&
+            pcb->snd_buf > 0 && pcb->snd_queuelen < TCP_SND_QUEUELEN)
+        {
+            break;
+        }
+
+        if (s->enviados < s->tam)
+        {
+            ssize_t n = send(pcb->fd, s->dados + s->enviados, s->tam - s->enviados, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    pcb->socket_cheio = true;
+                }
+                else
+                {
+                    pcb->falhou = true;
+                }
+                break;
+            }
+            s->enviados += (u16_t)n;
+            if (s->enviados < s->tam)
+            {
+                pcb->socket_cheio = true;
+                break;
+            }
+        }
+        if (s->fin)
+        {
+            shutdown(pcb->fd, SHUT_WR);
+        }
+        pcb->socket_cheio = false;
+        pcb->nao_enviados = s->prox;
+        s->ack_us = host_relogio_us + rtt_us;
+        anexar(&pcb->sem_ack, s);
+    }
+
+    if (!pcb->nao_enviados)
+    {
+        pcb->erro_memoria = false;
+    }
+    return ERR_OK;
+}
+
+// Coloca o FIN na fila. Com dados recebidos e não lidos, o lwIP responde com RST.
+err_t tcp_close(struct tcp_pcb *pcb)
+{
+    if (pcb->estado == PCB_FECHANDO || pcb->estado == PCB_MORTO)
+    {
+        return ERR_OK;
+    }
+    if (pcb->estado != PCB_CONECTADO)
+    {
+        descartar(pcb, false);
+        return ERR_OK;
+    }
+    if (pcb->recusado || pcb->janela != TCP_WND)
+    {
+        est.abortadas++;
+        descartar(pcb, true);
+        return ERR_OK;
+    }
+
+    // O FIN vai no último segmento da fila ou, sem fila, em um segmento vazio
+    segmento_t *ultimo = ultimo_segmento(pcb->nao_enviados);
+    if (ultimo)
+    {
+        ultimo->fin = true;
+    }
+    else
+    {
+        uint32_t heap = custo_pbuf(0, true);
+        if (pcb->snd_queuelen >= TCP_SND_QUEUELEN || est.heap + heap > MEM_SIZE || est.segs + 1 > MEMP_NUM_TCP_SEG)
+        {
+            return ERR_MEM;
+        }
+        segmento_t *s = calloc(1, sizeof(*s));
+        s->fin = true;
+        s->heap = heap;
+        s->pbufs = 1;
+        anexar(&pcb->nao_enviados, s);
+        ocupar(&est.heap, &est.heap_max, heap);
+        ocupar(&est.segs, &est.segs_max, 1);
+        pcb->snd_queuelen++;
+    }
+
+    pcb->estado = PCB_FECHANDO;
+    pcb->fechado_us = host_relogio_us;
+    tcp_output(pcb);
+    return ERR_OK;
+}
+
+// Como no lwIP, o callback de erro é chamado com ERR_ABRT
+void tcp_abort(struct tcp_pcb *pcb)
+{
+    if (pcb->estado == PCB_MORTO)
+    {
+        return;
+    }
+    tcp_err_fn erro = pcb->erro;
+    void *arg = pcb->arg;
+    est.abortadas++;
+    descartar(pcb, true);
+    if (erro)
+    {
+        erro(arg, ERR_ABRT);
+    }
+}
+
+// ============================================================================
+// === Recepção ===
+
+// Entrega um pbuf à aplicação (sem callback, descarta como tcp_recv_null).
+// Retorna false se ele foi recusado ou o PCB deixou de existir.
+static bool entregar(struct tcp_pcb *pcb, struct pbuf *p)
+{
+    if (!pcb->receber)
+    {
+        tcp_recved(pcb, p->tot_len);
+        pbuf_free(p);
+        return true;
+    }
+    err_t err = pcb->receber(pcb->arg, pcb, p, ERR_OK);
+    if (err == ERR_ABRT)
+    {
+        return false;
+    }
+    if (err != ERR_OK)
+    {
+        if (pcb->estado == PCB_MORTO)
+        {
+            pbuf_free(p);
+        }
+        else
+        {
+            pcb->recusado = p;
+        }
+        return false;
+    }
+    return pcb->estado != PCB_MORTO;
+}
+
+static void entregar_fin(struct tcp_pcb *pcb)
+{
+    pcb->fin_entregue = true;
+    if (pcb->receber)
+    {
+        pcb->receber(pcb->arg, pcb, NULL, ERR_OK);
+    }
+    else
+    {
+        tcp_close(pcb);
+    }
+}
+
+// Reentrega o pbuf recusado e, se ele for aceito, o FIN que chegou depois dele
+static void reentregar(struct tcp_pcb *pcb)
+{
+    if (pcb->recusado)
+    {
+        struct pbuf *p = pcb->recusado;
+        pcb->recusado = NULL;
+        if (!entregar(pcb, p))
+        {
+            return;
+        }
+    }
+    if (pcb->estado == PCB_CONECTADO && pcb->fin_recebido && !pcb->fin_entregue)
+    {
+        entregar_fin(pcb);
+    }
+}
+
+// Lê o próximo segmento do socket para um pbuf do pool
+static void ler(struct tcp_pcb *pcb)
+{
+    if (pcb->estado == PCB_FECHANDO)
+    {
+        // Depois do tcp_close o lwIP não aceita mais dados: responde com RST
+        char lixo[64];
+        ssize_t n = recv(pcb->fd, lixo, sizeof(lixo), MSG_DONTWAIT);
+        if (n > 0)
+        {
+            tcp_abort(pcb);
+        }
+        else if (n == 0)
+        {
+            pcb->fin_recebido = true;
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            resetar(pcb);
+        }
+        return;
+    }
+    if (pcb->recusado || pcb->fin_recebido)
+    {
+        return;
+    }
+
+    struct pbuf *p = alocar_pool();
+    if (!p)
+    {
+        est.sem_pool++; // No firmware o segmento é descartado e o cliente retransmite
+        return;
+    }
+    ssize_t n = recv(pcb->fd, p->payload, menor(TCP_MSS, pcb->janela), MSG_DONTWAIT);
+    if (n <= 0)
+    {
+        pbuf_free(p);
+        if (n == 0)
+        {
+            pcb->fin_recebido = true;
+            entregar_fin(pcb);
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            resetar(pcb);
+        }
+        return;
+    }
+    pcb->janela -= (u32_t)n;
+    p->len = p->tot_len = (u16_t)n;
+    if (!entregar(pcb, p) && pcb->recusado == p)
+    {
+        est.recusados++;
+    }
+}
+
+// ============================================================================
+// === Laço ===
+
+// Libera os segmentos cujo ACK simulado venceu e avisa a aplicação. Como na chegada de
+// um ACK no lwIP, também reentrega o pbuf recusado e tenta enviar o resto da fila.
+static void confirmar(struct tcp_pcb *pcb)
+{
+    uint32_t confirmados = 0;
+    bool algum = false;
+    while (pcb->sem_ack && pcb->sem_ack->ack_us <= host_relogio_us)
+    {
+        segmento_t *s = pcb->sem_ack;
+        pcb->sem_ack = s->prox;
+        confirmados += s->tam;
+        pcb->snd_buf += s->tam;
+        liberar_segmento(pcb, s);
+        algum = true;
+    }
+    if (!algum)
+    {
+        return;
+    }
+    if (confirmados > 0 && pcb->enviado && pcb->enviado(pcb->arg, pcb, (u16_t)confirmados) == ERR_ABRT)
+    {
+        return;
+    }
+    if (pcb->estado == PCB_CONECTADO)
+    {
+        reentregar(pcb);
+    }
+    tcp_output(pcb);
+}
+
+static void aceitar(struct tcp_pcb *escuta)
+{
+    for (;;)
+    {
+        struct tcp_pcb *pcb = alocar_pcb(pcbs, MEMP_NUM_TCP_PCB);
+        if (!pcb)
+        {
+            return;
+        }
+        int fd = accept4(escuta->fd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0)
+        {
+            return;
+        }
+        int um = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um)); // o Nagle é o da pilha simulada
+
+        pcb->estado = PCB_CONECTADO;
+        pcb->fd = fd;
+        pcb->arg = escuta->arg;
+        ocupar(&est.pcbs, &est.pcbs_max, 1);
+        est.aceitas++;
+
+        err_t err = escuta->aceitar ? escuta->aceitar(escuta->arg, pcb, ERR_OK) : ERR_ARG;
+        if (err != ERR_OK)
+        {
+            if (err != ERR_ABRT)
+            {
+                tcp_abort(pcb);
+            }
+            continue;
+        }
+        tcp_output(pcb);
+    }
+}
+
+static bool ativo(const struct tcp_pcb *pcb)
+{
+    return pcb->estado == PCB_CONECTADO || pcb->estado == PCB_FECHANDO;
+}
+
+// Temporizadores do lwIP: o rápido reentrega dados recusados; o lento chama o tcp_poll
+// e encerra o FIN_WAIT_2 sem resposta do cliente
+static void temporizadores(void)
+{
+    if (host_relogio_us >= proximo_rapido_us)
+    {
+        proximo_rapido_us = host_relogio_us + TCP_TMR_INTERVAL * 1000u;
+        for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+        {
+            if (pcbs[i].estado == PCB_CONECTADO && pcbs[i].recusado)
+            {
+                reentregar(&pcbs[i]);
+                tcp_output(&pcbs[i]);
+            }
+        }
+    }
+
+    if (host_relogio_us >= proximo_lento_us)
+    {
+        proximo_lento_us = host_relogio_us + TCP_SLOW_INTERVAL * 1000u;
+        for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+        {
+            struct tcp_pcb *pcb = &pcbs[i];
+            if (pcb->estado == PCB_FECHANDO && !pcb->nao_enviados && !pcb->sem_ack && !pcb->fin_recebido &&
+                host_relogio_us - pcb->fechado_us > TCP_FIN_WAIT_TIMEOUT * 1000ull)
+            {
+                descartar(pcb, false);
+                continue;
+            }
+            if (!ativo(pcb) || ++pcb->contador_poll < pcb->intervalo_poll)
+            {
+                continue;
+            }
+            pcb->contador_poll = 0;
+            if (pcb->sondar && pcb->sondar(pcb->arg, pcb) == ERR_ABRT)
+            {
+                continue;
+            }
+            tcp_output(pcb);
+        }
+    }
+}
+
+void lwip_host_configurar(uint32_t rtt_ms)
+{
+    rtt_us = rtt_ms * 1000u;
+}
+
+void lwip_host_processar(uint32_t espera_ms)
+{
+    // Slots liberados na volta anterior voltam à tabela
+    for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+    {
+        if (pcbs[i].estado == PCB_MORTO)
+        {
+            pcbs[i].estado = PCB_LIVRE;
+        }
+    }
+    for (int i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++)
+    {
+        if (escutas[i].estado == PCB_MORTO)
+        {
+            escutas[i].estado = PCB_LIVRE;
+        }
+    }
+
+    // O que venceu até agora: RSTs pendentes, ACKs simulados, temporizadores e o fim
+    // das conexões fechadas dos dois lados (o TIME_WAIT não segura o PCB: o lwIP o
+    // reaproveita quando falta PCB)
+    for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+    {
+        struct tcp_pcb *pcb = &pcbs[i];
+        if (ativo(pcb) && pcb->falhou)
+        {
+            resetar(pcb);
+        }
+        else if (ativo(pcb))
+        {
+            confirmar(pcb);
+        }
+    }
+    temporizadores();
+    for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+    {
+        struct tcp_pcb *pcb = &pcbs[i];
+        if (pcb->estado == PCB_FECHANDO && pcb->fin_recebido && !pcb->nao_enviados && !pcb->sem_ack)
+        {
+            descartar(pcb, false);
+        }
+    }
+
+    // Sockets a observar. Sem PCB livre as escutas ficam de fora (o SYN esperaria no
+    // firmware); sem pbuf livre no pool, nenhuma conexão é lida.
+    bool pcb_livre = false;
+    for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+    {
+        pcb_livre |= pcbs[i].estado == PCB_LIVRE;
+    }
+    struct pollfd fds[MEMP_NUM_TCP_PCB_LISTEN + MEMP_NUM_TCP_PCB];
+    struct tcp_pcb *donos[MEMP_NUM_TCP_PCB_LISTEN + MEMP_NUM_TCP_PCB];
+    int n = 0;
+    bool esperando_pcb = false;
+    for (int i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++)
+    {
+        if (escutas[i].estado != PCB_ESCUTA)
+        {
+            continue;
+        }
+        if (pcb_livre)
+        {
+            fds[n] = (struct pollfd){.fd = escutas[i].fd, .events = POLLIN};
+            donos[n++] = &escutas[i];
+        }
+        else
+        {
+            struct pollfd espera = {.fd = escutas[i].fd, .events = POLLIN};
+            esperando_pcb |= poll(&espera, 1, 0) > 0;
+        }
+    }
+    if (esperando_pcb && !espera_pcb_us)
+    {
+        espera_pcb_us = host_relogio_us;
+        est.sem_pcb++;
+    }
+    else if (!esperando_pcb && espera_pcb_us)
+    {
+        esperou_pcb_us += host_relogio_us - espera_pcb_us;
+        espera_pcb_us = 0;
+    }
+
+    uint64_t prazo_us = host_relogio_us + espera_ms * 1000ull;
+    if (proximo_rapido_us < prazo_us)
+    {
+        prazo_us = proximo_rapido_us;
+    }
+    if (proximo_lento_us < prazo_us)
+    {
+        prazo_us = proximo_lento_us;
+    }
+    for (int i = 0; i < MEMP_NUM_TCP_PCB; i++)
+    {
+        struct tcp_pcb *pcb = &pcbs[i];
+        if (!ativo(pcb))
+        {
+            continue;
+        }
+        if (pcb->sem_ack && pcb->sem_ack->ack_us < prazo_us)
+        {
+            prazo_us = pcb->sem_ack->ack_us;
+        }
+        short eventos = 0;
+        if (pcb->estado == PCB_FECHANDO ? !pcb->fin_recebido
+                                        : !pcb->recusado && !pcb->fin_recebido && pcb->janela > 0 && est.pool < PBUF_POOL_SIZE)
+        {
+            eventos |= POLLIN;
+        }
+        if (pcb->socket_cheio)
+        {
+            eventos |= POLLOUT;
+        }
+        if (eventos)
+        {
+            fds[n] = (struct pollfd){.fd = pcb->fd, .events = eventos};
+            donos[n++] = pcb;
+        }
+    }
+
+    int espera = prazo_us > host_relogio_us ? (int)((prazo_us - host_relogio_us + 999) / 1000) : 0;
+    if (poll(fds, (nfds_t)n, espera) <= 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        struct tcp_pcb *pcb = donos[i];
+        short r = fds[i].revents;
+        if (!r)
+        {
+            continue;
+        }
+        if (pcb->estado == PCB_ESCUTA)
+        {
+            aceitar(pcb);
+            continue;
+        }
+        if (!ativo(pcb) || pcb->fd != fds[i].fd)
+        {
+            continue; // liberado por um callback desta volta
+        }
+        if (r & POLLERR)
+        {
+            resetar(pcb);
+            continue;
+        }
+        if (r & (POLLIN | POLLHUP))
+        {
+            ler(pcb);
+        }
+        if (ativo(pcb) && (r & POLLOUT))
+        {
+            pcb->socket_cheio = false;
+        }
+        if (ativo(pcb))
+        {
+            tcp_output(pcb);
+        }
+    }
+}
+
+void lwip_host_estatisticas(lwip_host_estatisticas_t *e)
+{
+    *e = est;
+    e->sem_pcb_ms = (uint32_t)((esperou_pcb_us + (espera_pcb_us ? host_relogio_us - espera_pcb_us : 0)) / 1000);
+}
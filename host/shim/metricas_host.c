@@ -0,0 +1,28 @@
+#include "metricas.h"
+
+// Contadores e histogramas do firmware descartados no host: o código que os alimenta
+// (sensores.c) roda sem alterações, e /metrics não existe aqui
+
+uint32_t metricas_inicio(void)
+{
+    return 0;
+}
+
+void metricas_registrar(metrica_latencia_t metrica, uint32_t inicio)
+{
+    (void)metrica;
+    (void)inicio;
+}
+
+void metricas_contar(metrica_contador_t contador)
+{
+    (void)contador;
+}
+
+size_t metricas_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    (void)cursor;
+    (void)buf;
+    (void)tam;
+    return 0;
+}
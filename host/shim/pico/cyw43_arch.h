@@ -0,0 +1,66 @@
+#ifndef HOST_SHIM_PICO_CYW43_ARCH_H
+#define HOST_SHIM_PICO_CYW43_ARCH_H
+
+// Driver CYW43 simulado (host/shim/cyw43_host.c) para exercitar rede.c no host.
+// Uma tentativa de conexão passa por CYW43_LINK_JOIN e, depois do atraso configurado,
+// termina no resultado configurado; o programa do host derruba o enlace ou troca o IP
+// quando quiser.
+
+#include "pico/stdlib.h"
+
+#define CYW43_ITF_STA 0
+#define CYW43_AUTH_WPA2_AES_PSK 0x00400004
+
+// Valores de cyw43_tcpip_link_status
+#define CYW43_LINK_DOWN 0
+#define CYW43_LINK_JOIN 1
+#define CYW43_LINK_NOIP 2
+#define CYW43_LINK_UP 3
+#define CYW43_LINK_FAIL -1
+#define CYW43_LINK_NONET -2
+#define CYW43_LINK_BADAUTH -3
+
+typedef struct
+{
+    struct
+    {
+        struct
+        {
+            uint32_t addr;
+        } ip_addr;
+    } netif[1];
+} cyw43_t;
+
+extern cyw43_t cyw43_state;
+
+int cyw43_arch_init(void);
+void cyw43_arch_enable_sta_mode(void);
+int cyw43_arch_wifi_connect_async(const char *ssid, const char *pw, uint32_t auth);
+int cyw43_tcpip_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_leave(cyw43_t *self, int itf);
+
+// A pilha TCP simulada (host/shim/lwip_host.c) roda em uma só thread
+static inline void cyw43_arch_lwip_begin(void)
+{
+}
+
+static inline void cyw43_arch_lwip_end(void)
+{
+}
+
+// === Controle do enlace simulado ===
+
+// Resultado das próximas tentativas: status final (CYW43_LINK_UP, _NONET, _BADAUTH,
+// _FAIL ou _JOIN para nunca terminar), IP entregue no UP e atraso até o resultado
+void cyw43_sim_configurar(int resultado, uint32_t ip, uint32_t atraso_ms);
+
+// Derruba um enlace de pé (como o AP sumindo)
+void cyw43_sim_derrubar(void);
+
+// Troca o IP de um enlace de pé (renovação do DHCP)
+void cyw43_sim_trocar_ip(uint32_t ip);
+
+// Tentativas de conexão recebidas pelo driver
+uint32_t cyw43_sim_tentativas(void);
+
+#endif // HOST_SHIM_PICO_CYW43_ARCH_H
@@ -0,0 +1,21 @@
+#ifndef HOST_SHIM_PICO_MUTEX_H
+#define HOST_SHIM_PICO_MUTEX_H
+
+// Ferramentas do host têm uma só thread: o mutex do barramento não faz nada
+
+typedef struct
+{
+    int dono;
+} mutex_t;
+
+static inline void mutex_enter_blocking(mutex_t *mtx)
+{
+    (void)mtx;
+}
+
+static inline void mutex_exit(mutex_t *mtx)
+{
+    (void)mtx;
+}
+
+#endif // HOST_SHIM_PICO_MUTEX_H
@@ -0,0 +1,53 @@
+#ifndef HOST_SHIM_PICO_STDLIB_H
+#define HOST_SHIM_PICO_STDLIB_H
+
+// Substituto mínimo do pico/stdlib.h para compilar os drivers de lib/ no host
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x##u
+
+static inline void sleep_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+static inline void busy_wait_us(uint64_t us)
+{
+    (void)us;
+}
+
+static inline void tight_loop_contents(void)
+{
+}
+
+// Relógio simulado: só anda quando o programa do host avança host_relogio_us
+// (definido em host/shim/cyw43_host.c)
+extern uint64_t host_relogio_us;
+
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return host_relogio_us;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t)(t / 1000);
+}
+
+static inline uint64_t time_us_64(void)
+{
+    return host_relogio_us;
+}
+
+// Códigos de erro de pico/error.h
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+#endif // HOST_SHIM_PICO_STDLIB_H
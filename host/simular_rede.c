@@ -0,0 +1,110 @@
+// Percorre as transições do gerenciador de Wi-Fi (rede.c) sobre o enlace simulado de
+// host/shim/cyw43_host.c, com o relógio avançando no ritmo da tarefa de manutenção.
+//
+// Uso: simular_rede
+//
+// Imprime a linha do tempo (estados e mudanças de IP) e confere, ao fim de cada fase,
+// o estado, o IP e as estatísticas esperados. Termina com código 1 se algo divergir.
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "rede.h"
+
+#define PASSO_MS 50 // PERIODO_MANUTENCAO_MS
+
+#define IP(a, b, c, d) ((uint32_t)(a) | (uint32_t)(b) << 8 | (uint32_t)(c) << 16 | (uint32_t)(d) << 24)
+
+static uint32_t avisos_ip;    // Chamadas da callback
+static uint32_t ultimo_aviso; // IP do último aviso
+static int divergencias;
+
+static double agora_s(void)
+{
+    return host_relogio_us / 1e6;
+}
+
+static void ao_mudar_ip(uint32_t ip)
+{
+    avisos_ip++;
+    ultimo_aviso = ip;
+    printf("[%8.3f s] IP %u.%u.%u.%u\n", agora_s(), ip & 0xFF, ip >> 8 & 0xFF, ip >> 16 & 0xFF, ip >> 24);
+}
+
+// Chama rede_processar a cada PASSO_MS por 'ms', imprimindo as mudanças de estado
+static void rodar(uint32_t ms)
+{
+    static rede_estado_t anterior = REDE_DESLIGADA;
+    for (uint32_t t = 0; t < ms; t += PASSO_MS)
+    {
+        host_relogio_us += PASSO_MS * 1000;
+        rede_processar();
+        if (rede_estado() != anterior)
+        {
+            printf("[%8.3f s] %s -> %s\n", agora_s(), rede_estado_nome(anterior), rede_estado_nome(rede_estado()));
+            anterior = rede_estado();
+        }
+    }
+}
+
+static void conferir(const char *fase, rede_estado_t estado, uint32_t ip, uint32_t conexoes, uint32_t falhas,
+                     uint32_t quedas, uint32_t tentativas)
+{
+    bool ok = rede_estado() == estado && rede_ip() == ip && rede_conexoes() == conexoes &&
+              rede_falhas() == falhas && rede_quedas() == quedas && cyw43_sim_tentativas() == tentativas;
+    printf("-- %s: %s (estado %s, conexoes %u, falhas %u, quedas %u, tentativas %u)\n\n", fase,
+           ok ? "ok" : "DIVERGE", rede_estado_nome(rede_estado()), rede_conexoes(), rede_falhas(), rede_quedas(),
+           cyw43_sim_tentativas());
+    if (!ok)
+    {
+        divergencias++;
+    }
+}
+
+int main(void)
+{
+    // Boot com o AP fora do ar: cada tentativa falha em 3 s, e o recuo dobra
+    // (1, 2, 4, 8 s). Tentativas em 0, 4, 9, 16 e 27 s.
+    cyw43_sim_configurar(CYW43_LINK_NONET, 0, 3000);
+    rede_iniciar("ssid", "senha", ao_mudar_ip);
+    rodar(40000);
+    conferir("AP ausente no boot", REDE_ESPERANDO, 0, 0, 5, 0, 5);
+
+    // O AP volta: a tentativa de 46 s (recuo de 16 s) conecta 2 s depois
+    cyw43_sim_configurar(CYW43_LINK_UP, IP(192, 168, 0, 20), 2000);
+    rodar(10000);
+    conferir("AP de volta", REDE_CONECTADA, IP(192, 168, 0, 20), 1, 5, 0, 6);
+
+    // Renovação do DHCP com outro endereço: um aviso, sem reconectar
+    cyw43_sim_trocar_ip(IP(192, 168, 0, 21));
+    rodar(1000);
+    conferir("Troca de IP", REDE_CONECTADA, IP(192, 168, 0, 21), 1, 5, 0, 6);
+
+    // Queda do enlace: aviso com IP 0 e nova tentativa na hora, que conecta em 1 s
+    cyw43_sim_configurar(CYW43_LINK_UP, IP(192, 168, 0, 22), 1000);
+    cyw43_sim_derrubar();
+    rodar(2000);
+    conferir("Queda e reconexao", REDE_CONECTADA, IP(192, 168, 0, 22), 2, 5, 1, 7);
+
+    // Associação que nunca recebe IP: falha quando o prazo estoura, e o recuo recomeça
+    // de 1 s porque a última tentativa tinha conectado
+    cyw43_sim_configurar(CYW43_LINK_JOIN, 0, 0);
+    cyw43_sim_derrubar();
+    rodar(REDE_PRAZO_CONEXAO_MS + 500);
+    conferir("Prazo de conexao", REDE_ESPERANDO, 0, 2, 6, 2, 8);
+
+    // Senha errada: falha imediata em toda tentativa, recuo até o máximo
+    cyw43_sim_configurar(CYW43_LINK_BADAUTH, 0, 0);
+    rodar(10 * 60 * 1000);
+    printf("Recuo no teto: %u tentativas em 10 min\n", cyw43_sim_tentativas() - 8);
+
+    printf("Avisos de IP: %u (esperado 5), ultimo %u\n", avisos_ip, ultimo_aviso);
+    if (avisos_ip != 5 || ultimo_aviso != 0)
+    {
+        divergencias++;
+    }
+
+    printf("%s\n", divergencias ? "FALHOU" : "OK");
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+#include "http_requisicao.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// Localiza o valor do cabeçalho 'nome' (sem diferenciar maiúsculas, como exige o HTTP).
+// 'req' deve terminar logo após a última linha de cabeçalho.
+// Retorna o início do valor e seu tamanho em *tam, ou NULL se o cabeçalho não existir.
+const char *http_cabecalho_valor(const char *req, const char *nome, size_t *tam)
+{
+    size_t tam_nome = strlen(nome);
+
+    // Pula a linha de requisição e percorre as linhas de cabeçalho
+    const char *linha = strstr(req, "\r\n");
+    while (linha && linha[2] != '\0')
+    {
+        linha += 2;
+        const char *fim = strstr(linha, "\r\n");
+        if (!fim)
+        {
+            break;
+        }
+
+        if (strncasecmp(linha, nome, tam_nome) == 0 && linha[tam_nome] == ':')
+        {
+            const char *valor = linha + tam_nome + 1;
+            while (valor < fim && (*valor == ' ' || *valor == '\t'))
+            {
+                valor++;
+            }
+            *tam = (size_t)(fim - valor);
+            return valor;
+        }
+        linha = fim;
+    }
+    return NULL;
+}
+
+// Verifica se o cabeçalho 'nome' existe na requisição e contém 'valor'
+bool http_cabecalho_contem(const char *req, const char *nome, const char *valor)
+{
+    size_t tam;
+    const char *v = http_cabecalho_valor(req, nome, &tam);
+    size_t tam_valor = strlen(valor);
+
+    for (size_t i = 0; v && i + tam_valor <= tam; i++)
+    {
+        if (strncasecmp(v + i, valor, tam_valor) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Verifica a versão informada na linha de requisição
+bool http_requisicao_http10(const char *req)
+{
+    const char *fim_linha = strstr(req, "\r\n");
+    return fim_linha && (fim_linha - req) >= 8 && strncmp(fim_linha - 8, "HTTP/1.0", 8) == 0;
+}
+
+// HTTP/1.1 mantém a conexão por padrão; HTTP/1.0 só se o cliente pedir
+bool http_requisicao_mantem_conexao(const char *req)
+{
+    if (http_requisicao_http10(req))
+    {
+        return http_cabecalho_contem(req, "Connection", "keep-alive");
+    }
+    return !http_cabecalho_contem(req, "Connection", "close");
+}
+
+// Verifica se o início de 'req' (com 'tam' bytes acumulados, até 'limite') contém uma
+// requisição completa (cabeçalhos e corpo). 'req' precisa de espaço para req[tam] = '\0'.
+// Retorna o tamanho total da requisição, 0 se ainda faltam bytes ou um código HTTP
+// negativo (-431, -413, -400) se a requisição não pode ser atendida.
+int http_requisicao_completa(char *req, size_t tam, size_t limite, size_t *tam_cabecalhos)
+{
+    req[tam] = '\0';
+    char *fim = strstr(req, "\r\n\r\n");
+    if (!fim)
+    {
+        // Buffer cheio sem o fim dos cabeçalhos: nunca vai caber
+        return tam >= limite ? -431 : 0;
+    }
+    *tam_cabecalhos = (size_t)(fim - req) + 4;
+
+    // Termina temporariamente os cabeçalhos para procurar Content-Length
+    fim[2] = '\0';
+    size_t tam_valor;
+    const char *valor = http_cabecalho_valor(req, "Content-Length", &tam_valor);
+    long tam_corpo = 0;
+    if (valor)
+    {
+        char *fim_num;
+        tam_corpo = strtol(valor, &fim_num, 10);
+        if (fim_num == valor || tam_corpo < 0)
+        {
+            tam_corpo = -1;
+        }
+    }
+    fim[2] = '\r';
+
+    if (tam_corpo < 0)
+    {
+        return -400;
+    }
+    if ((size_t)tam_corpo > limite - *tam_cabecalhos)
+    {
+        return -413;
+    }
+    if (*tam_cabecalhos + (size_t)tam_corpo > tam)
+    {
+        return 0; // Corpo ainda chegando
+    }
+    return (int)(*tam_cabecalhos + (size_t)tam_corpo);
+}
@@ -0,0 +1,30 @@
+#ifndef HTTP_REQUISICAO_H // Previne múltiplas inclusões do cabeçalho
+#define HTTP_REQUISICAO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Interpretação de requisições HTTP/1.x recebidas como texto.
+// Não depende do lwIP, para poder ser medida e testada no host.
+
+// Localiza o valor do cabeçalho 'nome' (sem diferenciar maiúsculas, como exige o HTTP).
+// 'req' deve terminar logo após a última linha de cabeçalho.
+// Retorna o início do valor e seu tamanho em *tam, ou NULL se o cabeçalho não existir.
+const char *http_cabecalho_valor(const char *req, const char *nome, size_t *tam);
+
+// Verifica se o cabeçalho 'nome' existe na requisição e contém 'valor'
+bool http_cabecalho_contem(const char *req, const char *nome, const char *valor);
+
+// Verifica a versão informada na linha de requisição
+bool http_requisicao_http10(const char *req);
+
+// HTTP/1.1 mantém a conexão por padrão; HTTP/1.0 só se o cliente pedir
+bool http_requisicao_mantem_conexao(const char *req);
+
+// Verifica se o início de 'req' (com 'tam' bytes acumulados, até 'limite') contém uma
+// requisição completa (cabeçalhos e corpo). 'req' precisa de espaço para req[tam] = '\0'.
+// Retorna o tamanho total da requisição, 0 se ainda faltam bytes ou um código HTTP
+// negativo (-431, -413, -400) se a requisição não pode ser atendida.
+int http_requisicao_completa(char *req, size_t tam, size_t limite, size_t *tam_cabecalhos);
+
+#endif // HTTP_REQUISICAO_H
@@ -22,6 +22,7 @@ const char HTML_BODY[] =
     ".grid{display:flex;flex-wrap:wrap;justify-content:center;gap:20px;max-width:1200px;margin:20px auto}" // Layout flexível para gráficos
     ".grafico-container{flex:1 1 45%;min-width:300px;padding:15px;background:#fff;border-radius:12px;box-shadow:0 2px 5px rgba(0,0,0,0.1)}" // Container individual dos gráficos
     "canvas{width:100%;height:auto}"                                                                // Canvas responsivo
+    ".legenda{font-size:13px;margin-top:4px}"                                                       // Legenda abaixo de cada gráfico
     ".modal{display:none;position:fixed;z-index:999;left:0;top:0;width:100%;height:100%;overflow:auto;background:rgba(0,0,0,0.5)}" // Fundo do modal escurecido oculto por padrão
     ".modal-conteudo{background:#fff;margin:5% auto;padding:25px;border-radius:14px;width:90%;max-width:500px;box-shadow:0 6px 20px rgba(0,0,0,0.3)}" // Conteúdo modal centralizado
     ".fechar{color:#999;float:right;font-size:28px;font-weight:bold;cursor:pointer;margin-top:-10px}" // Botão fechar modal no canto superior direito
@@ -38,43 +39,19 @@ const char HTML_BODY[] =
     "@media(max-width:600px){.modal-grid{grid-template-columns:1fr}}"                               // Responsividade para modal em telas muito pequenas
     "</style>"
 
-    // Inclusão da biblioteca Chart.js para gráficos
-    "<script src='https://cdn.jsdelivr.net/npm/chart.js'></script>"
+    // Renderizador de gráficos servido pelo próprio dispositivo (funciona sem internet)
+    "<script src='/grafico.js?v=1'></script>"
 
     // Script JavaScript para controlar gráficos e interações
     "<script>"
-    "let g1,g2,g3,g4,d={x:[],y:[],z:[],t:[]},n=30;" // Variáveis globais para gráficos e dados acumulados (x=temp, y=altitude, z=umidade, t=tempo), n=limite de pontos
-
-    // Função para criar gráfico de linha simples
-    "function cg(i,l,c){"
-    "return new Chart(document.getElementById(i).getContext('2d'),{"
-    "type:'line',"
-    "data:{labels:[],datasets:[{label:l,data:[],borderColor:c,fill:false}]},"
-    "options:{responsive:true,maintainAspectRatio:true,aspectRatio:1.3,animation:false,"
-    "scales:{x:{title:{display:true,text:'Tempo'}},y:{title:{display:true,text:'Valor'}}}}"
-    "});"
-    "}"
-
-    // Função para criar gráfico de linhas múltiplas (para combinado)
-    "function cgmulti(i){"
-    "return new Chart(document.getElementById(i).getContext('2d'),{"
-    "type:'line',"
-    "data:{labels:[],datasets:["
-    "{label:'Temp (°C)',data:[],borderColor:'#2196F3',fill:false},"
-    "{label:'Pressão (hPa)',data:[],borderColor:'#B16099',fill:false},"
-    "{label:'Umidade (%)',data:[],borderColor:'#FF9800',fill:false}"
-    "]},"
-    "options:{responsive:true,maintainAspectRatio:true,aspectRatio:1.3,animation:false,"
-    "scales:{x:{title:{display:true,text:'Tempo'}},y:{title:{display:true,text:'Valor'}}}}"
-    "});"
-    "}"
+    "let g1,g2,g3,g4,jan=600;" // Gráficos (g1=temp, g2=pressão, g3=umidade, g4=combinado), jan=pontos visíveis
 
     // Inicialização após carregamento da página
     "document.addEventListener('DOMContentLoaded',()=>{"
-    "g1=cg('g1','Temp','#2196F3');"     // Gráfico temperatura
-    "g2=cg('g2','Pressão','#B16099');"  // Gráfico pressão
-    "g3=cg('g3','Umidade','#FF9800');"  // Gráfico umidade
-    "g4=cgmulti('g4');"                 // Gráfico combinado
+    "g1=G('g1',[{l:'Temp',c:'#2196F3'}],jan);"        // Gráfico temperatura
+    "g2=G('g2',[{l:'Pressão',c:'#B16099'}],jan);"     // Gráfico pressão
+    "g3=G('g3',[{l:'Umidade',c:'#FF9800'}],jan);"     // Gráfico umidade
+    "g4=G('g4',[{l:'Temp (°C)',c:'#2196F3'},{l:'Pressão (hPa)',c:'#B16099'},{l:'Umidade (%)',c:'#FF9800'}],jan);" // Gráfico combinado
 
     // Evento para enviar offset ao apertar Enter nos inputs
     "document.querySelectorAll('.offset-input').forEach(i=>{"
@@ -97,13 +74,6 @@ const char HTML_BODY[] =
     // Função para atualizar dados e gráficos a cada segundo
     "function att(){"
     "fetch('/estado').then(r=>r.json()).then(e=>{"
-    "let t=new Date().toLocaleTimeString();" // Tempo atual formatado
-    // Remove dados antigos se exceder limite n
-    "if(d.x.length>=n){d.x.shift();d.y.shift();d.z.shift();d.t.shift();}"
-
-    // Adiciona novos dados recebidos do servidor
-    "d.x.push(e.x); d.y.push(e.y); d.z.push(e.z); d.t.push(t);"
-
     // Atualiza valores exibidos na página
     "document.getElementById('v_temp').innerText = e.x + ' °C';"
     "document.getElementById('v_pressao').innerText = e.y + ' hPa';"
@@ -122,11 +92,8 @@ const char HTML_BODY[] =
     "document.getElementById('min_umid_disp').innerText = e.min_umid ?? '--';"
     "document.getElementById('max_umid_disp').innerText = e.max_umid ?? '--';"
 
-    // Atualiza os dados dos gráficos se definidos
-    "if(g1){g1.data.labels=d.t;g1.data.datasets[0].data=d.x;g1.update();}"
-    "if(g2){g2.data.labels=d.t;g2.data.datasets[0].data=d.y;g2.update();}"
-    "if(g3){g3.data.labels=d.t;g3.data.datasets[0].data=d.z;g3.update();}"
-    "if(g4){g4.data.labels=d.t;g4.data.datasets[0].data=d.x;g4.data.datasets[1].data=d.y;g4.data.datasets[2].data=d.z;g4.update();}"
+    // Acrescenta o novo ponto aos gráficos (desenho incremental, sem redesenhar tudo)
+    "if(g1){g1.add([e.x]);g2.add([e.y]);g3.add([e.z]);g4.add([e.x,e.y,e.z]);}"
     "});"
     "}"
 
@@ -175,13 +142,32 @@ const char HTML_BODY[] =
     "return;"
     "}"
 
-    "fetch('/limites/'+tipo+'/min/'+min+'/max/'+max).then(()=>{"
-    "m.textContent='Limites de '+tipo+' salvos com sucesso!';"
+    "enviarConfig('min_'+tipo+'='+min+'&max_'+tipo+'='+max,'Limites de '+tipo+' salvos com sucesso!',[minInput,maxInput]);"
+    "}"
+
+    // Salva todos os limites preenchidos numa única requisição (aplicados juntos, numa versão)
+    "function salvarTodos(){"
+    "let campos=['temp','press','umid'].flatMap(t=>['min_'+t,'max_'+t])"
+    ".map(id=>document.getElementById(id)).filter(i=>i.value.trim()!=='');"
+    "if(!campos.length){"
+    "document.getElementById('mensagem_limites').textContent='Preencha ao menos um limite';"
+    "mostrarErro();"
+    "return;"
+    "}"
+    "enviarConfig(campos.map(i=>i.id+'='+i.value.trim()).join('&'),"
+    "'Limites salvos com sucesso!',campos);"
+    "}"
+
+    // POST /config com o lote 'chave=valor'; a estação recusa o lote inteiro se min > max
+    "function enviarConfig(corpo,sucesso,inputs){"
+    "let m=document.getElementById('mensagem_limites');"
+    "fetch('/config',{method:'POST',body:corpo}).then(r=>{"
+    "if(!r.ok){m.textContent='Limites recusados: confira se o mínimo é menor que o máximo';mostrarErro();return;}"
+    "m.textContent=sucesso;"
     "m.className='mensagem-final';"
     "m.style.display='block';"
     "setTimeout(()=>{m.style.display='none';},3000);"
-    "minInput.value='';"
-    "maxInput.value='';"
+    "inputs.forEach(i=>i.value='');"
     "});"
     "}"
 
@@ -265,6 +251,7 @@ const char HTML_BODY[] =
     "<div><label>Pres Min:</label><input type='number' id='min_press' step='any'><label>Pres Max:</label><input type='number' id='max_press' step='any'><button type='button' class='botao on' onclick=\"salvarLimite('press')\">Salvar</button></div>"
     "<div><label>Umid Min:</label><input type='number' id='min_umid' step='any'><label>Umid Max:</label><input type='number' id='max_umid' step='any'><button type='button' class='botao on' onclick=\"salvarLimite('umid')\">Salvar</button></div>"
     "</div>"
+    "<button type='button' class='botao on' onclick='salvarTodos()'>Salvar todos</button>"
     "<div id='mensagem_limites' class='mensagem-final'></div>"  // Mensagem de sucesso ou erro dos limites
     "</div>"
     "</div>"
@@ -276,3 +263,59 @@ const char HTML_BODY[] =
     "</footer>"
     "</body>"
     "</html>";
+
+
+// Renderizador mínimo de gráficos de linha em canvas, servido em /grafico.js com cache longo.
+// Cada série guarda os últimos 'jan' pontos em um Float32Array circular. Um novo ponto
+// desloca a área do gráfico com drawImage e desenha apenas o último segmento; o
+// redesenho completo só acontece quando a escala muda, a janela dá uma volta ou a
+// página é redimensionada.
+const char GRAFICO_JS[] =
+    // G(id, séries, janela): cria o gráfico no canvas 'id'; séries = [{l:rótulo, c:cor}]
+    "function G(id,ss,jan){"
+    "var c=document.getElementById(id),x=c.getContext('2d'),"
+    "o={n:0,h:0,lo:0,hi:1,ac:0,cont:0,d:ss.map(()=>new Float32Array(jan))};"
+
+    // Legenda em HTML, fora do canvas, para não ser deslocada com os dados
+    "var lg=document.createElement('div');lg.className='legenda';"
+    "lg.innerHTML=ss.map(s=>'<span style=color:'+s.c+'>&#9632; '+s.l+'</span>').join(' ');c.after(lg);"
+
+    // Dimensões em pixels reais: g=margem dos rótulos, R=borda direita, P=largura útil
+    "function dim(){var r=window.devicePixelRatio||1;c.width=c.clientWidth*r;c.height=c.width/1.3;"
+    "o.r=r;o.g=44*r;o.R=c.width-2;o.P=o.R-o.g;o.H=c.height;o.t=8*r;}"
+
+    // Converte valor para coordenada vertical
+    "function py(v){return o.t+(o.hi-v)/(o.hi-o.lo)*(o.H-2*o.t);}"
+
+    // Linhas de grade horizontais entre x0 e x1
+    "function grade(x0,x1){x.strokeStyle='#e5e5e5';x.lineWidth=1;x.beginPath();"
+    "for(var i=0;i<=4;i++){var y=py(o.lo+(o.hi-o.lo)*i/4);x.moveTo(x0,y);x.lineTo(x1,y);}x.stroke();}"
+
+    // Redesenho completo: recalcula a escala e traça a janela inteira
+    "function tudo(){var lo=Infinity,hi=-Infinity,s,i,v;"
+    "for(s=0;s<ss.length;s++)for(i=0;i<o.n;i++){v=o.d[s][i];if(v<lo)lo=v;if(v>hi)hi=v;}"
+    "if(!(hi>=lo)){lo=0;hi=1;}v=(hi-lo)*.1||1;o.lo=lo-v;o.hi=hi+v;o.ac=0;o.cont=0;"
+    "x.clearRect(0,0,c.width,c.height);grade(o.g,o.R);"
+    "x.fillStyle='#666';x.font=(10*o.r)+'px sans-serif';"
+    "for(i=0;i<=4;i++){v=o.lo+(o.hi-o.lo)*i/4;x.fillText(v.toFixed(1),2,py(v)+3*o.r);}"
+    "x.lineWidth=1.5*o.r;"
+    "for(s=0;s<ss.length;s++){x.strokeStyle=ss[s].c;x.beginPath();"
+    "for(i=0;i<o.n;i++){var px=o.R-(o.n-1-i)*o.P/(jan-1),pv=o.d[s][(o.h-o.n+i+jan)%jan];"
+    "i?x.lineTo(px,py(pv)):x.moveTo(px,py(pv));}x.stroke();}}"
+
+    // Acrescenta um ponto (um valor por série) desenhando só o trecho novo
+    "o.add=function(v){var s,a=(o.h+jan-1)%jan,tinha=o.n>0;"
+    "for(s=0;s<ss.length;s++)o.d[s][o.h]=v[s];"
+    "o.h=(o.h+1)%jan;if(o.n<jan)o.n++;"
+    "if(!tinha||v.some(k=>k<o.lo||k>o.hi)||++o.cont>=jan){tudo();return;}"
+    "o.ac+=o.P/(jan-1);var d=Math.floor(o.ac);o.ac-=d;"
+    "if(d>0){x.drawImage(c,o.g+d,0,o.P-d,o.H,o.g,0,o.P-d,o.H);x.clearRect(o.R-d,0,d+2,o.H);grade(o.R-d,o.R);}"
+    "x.lineWidth=1.5*o.r;"
+    "for(s=0;s<ss.length;s++){x.strokeStyle=ss[s].c;x.beginPath();"
+    "x.moveTo(o.R-d,py(o.d[s][a]));x.lineTo(o.R,py(v[s]));x.stroke();}"
+    "};"
+
+    "dim();tudo();"
+    "window.addEventListener('resize',()=>{dim();tudo();});"
+    "return o;"
+    "}";
@@ -22,6 +22,14 @@ bool aht20_init(i2c_inst_t *i2c);
 // Faz a leitura de temperatura e umidade do AHT20
 bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data);
 
+// Leitura em duas etapas, sem esperar a conversão (~80 ms) com o barramento ocupado:
+// dispara a medição e, depois, busca o resultado (false se ainda ocupado ou em erro)
+bool aht20_start_measurement(i2c_inst_t *i2c);
+bool aht20_read_measurement(i2c_inst_t *i2c, AHT20_Data *data);
+
+// Converte os 6 bytes lidos do sensor (status + 20 bits de umidade + 20 bits de temperatura)
+void aht20_convert(const uint8_t buffer[6], AHT20_Data *data);
+
 // Reseta o sensor AHT20
 void aht20_reset(i2c_inst_t *i2c);
 
@@ -0,0 +1,94 @@
+#ifndef AHT20_HPP
+#define AHT20_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "aht20.h" // comandos e AHT20_Data
+
+// Driver do AHT20 especializado em tempo de compilação, no mesmo molde de bmp280.hpp.
+// A leitura é em duas etapas (disparar e, ~80 ms depois, coletar), como em
+// aht20_start_measurement/aht20_read_measurement.
+namespace aht20
+{
+constexpr uint8_t STATUS_OCUPADO = 0x80;
+constexpr uint8_t STATUS_CALIBRADO = 0x08;
+
+// Status + 20 bits de umidade + 20 bits de temperatura -> % e °C
+constexpr AHT20_Data converter(const uint8_t (&b)[6])
+{
+    uint32_t umidade = (uint32_t)b[1] << 12 | (uint32_t)b[2] << 4 | b[3] >> 4;
+    uint32_t temperatura = (uint32_t)(b[3] & 0x0F) << 16 | (uint32_t)b[4] << 8 | b[5];
+    return AHT20_Data{
+        (float)((float)temperatura * 200.0 / 1048576.0 - 50.0),
+        (float)((float)umidade * 100.0 / 1048576.0),
+    };
+}
+
+// Meio da escala nos dois canais: 50 °C e 50 %
+static_assert(converter({0x1C, 0x80, 0x00, 0x08, 0x00, 0x00}).temperature == 50.0f, "conversão da temperatura");
+static_assert(converter({0x1C, 0x80, 0x00, 0x08, 0x00, 0x00}).humidity == 50.0f, "conversão da umidade");
+} // namespace aht20
+
+template <typename Barramento, uint8_t Endereco = AHT20_I2C_ADDR>
+struct Aht20
+{
+    static constexpr uint8_t comando_inicio[] = {AHT20_CMD_INIT, 0x08, 0x00};
+    static constexpr uint8_t comando_medir[] = {AHT20_CMD_TRIGGER, 0x33, 0x00};
+    static constexpr uint8_t comando_reset[] = {AHT20_CMD_RESET};
+
+    // O sensor responde no endereço
+    static bool verificar()
+    {
+        uint8_t status;
+        return Barramento::ler(Endereco, &status, 1, false) == 1;
+    }
+
+    // Reset e calibração; espera até ~150 ms, então só no boot
+    static bool iniciar()
+    {
+        Barramento::escrever(Endereco, comando_reset, sizeof(comando_reset), false);
+        sleep_ms(20);
+        Barramento::escrever(Endereco, comando_inicio, sizeof(comando_inicio), false);
+        sleep_ms(50);
+        for (int i = 0; i < 10; i++)
+        {
+            uint8_t status = 0;
+            if (Barramento::ler(Endereco, &status, 1, false) == 1 &&
+                (status & aht20::STATUS_CALIBRADO) == aht20::STATUS_CALIBRADO)
+            {
+                return true;
+            }
+            sleep_ms(10);
+        }
+        return false;
+    }
+
+    static bool disparar()
+    {
+        return Barramento::escrever(Endereco, comando_medir, sizeof(comando_medir), false) == sizeof(comando_medir);
+    }
+
+    // Busca a medição disparada antes; false se ainda ocupado ou em erro
+    static bool coletar(AHT20_Data &dados)
+    {
+        uint8_t b[6];
+        if (!coletar(b))
+        {
+            return false;
+        }
+        dados = aht20::converter(b);
+        return true;
+    }
+
+    // Mesma coleta, devolvendo o quadro lido (status + dados) sem converter
+    static bool coletar(uint8_t (&quadro)[6])
+    {
+        return Barramento::ler(Endereco, quadro, sizeof(quadro), false) == sizeof(quadro) &&
+               !(quadro[0] & aht20::STATUS_OCUPADO);
+    }
+};
+
+#endif // AHT20_HPP
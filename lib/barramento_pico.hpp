@@ -0,0 +1,42 @@
+#ifndef BARRAMENTO_PICO_HPP
+#define BARRAMENTO_PICO_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+// Barramento I2C do Pico SDK para os drivers em C++ (bmp280.hpp, aht20.hpp).
+// A porta é parâmetro do tipo, então a instância (i2c0/i2c1) é uma constante em
+// cada chamada e as funções se reduzem à chamada direta do SDK.
+//
+// As transações passam por i2c_bus, com tempo limitado e recuperação do barramento.
+//
+// Todo barramento usado pelos drivers oferece as mesmas duas funções estáticas,
+// com a semântica de i2c_write_blocking/i2c_read_blocking (bytes transferidos ou < 0):
+//   static int escrever(uint8_t endereco, const uint8_t *dados, size_t tam, bool manter);
+//   static int ler(uint8_t endereco, uint8_t *dados, size_t tam, bool manter);
+// 'manter' mantém o barramento (sem STOP) para uma leitura em seguida.
+template <unsigned Porta>
+struct BarramentoPico
+{
+    static_assert(Porta < 2, "o RP2040 tem duas portas I2C");
+
+    static i2c_inst_t *instancia()
+    {
+        return Porta == 0 ? i2c0 : i2c1;
+    }
+
+    static int escrever(uint8_t endereco, const uint8_t *dados, size_t tam, bool manter)
+    {
+        return i2c_bus_write(instancia(), endereco, dados, tam, manter);
+    }
+
+    static int ler(uint8_t endereco, uint8_t *dados, size_t tam, bool manter)
+    {
+        return i2c_bus_read(instancia(), endereco, dados, tam, manter);
+    }
+};
+
+#endif // BARRAMENTO_PICO_HPP
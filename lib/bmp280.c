@@ -1,38 +1,53 @@
 #include "bmp280.h"
 #include "hardware/i2c.h"
+#include "i2c_bus.h"
 
 #define ADDR _u(0x76)
 
 void bmp280_init(i2c_inst_t *i2c) {
+    bmp280_configure(i2c, BMP280_CONFIG_DEFAULT, BMP280_CTRL_MEAS_DEFAULT);
+ //   printf("Ctrl_meas register value: %x\n", BMP280_CTRL_MEAS_DEFAULT);
+}
+
+void bmp280_configure(i2c_inst_t *i2c, uint8_t config, uint8_t ctrl_meas) {
     uint8_t buf[2];
-    const uint8_t reg_config_val = ((0x04 << 5) | (0x05 << 2)) & 0xFC;
     buf[0] = REG_CONFIG;
-    buf[1] = reg_config_val;
-   
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    buf[1] = config & 0xFC;
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
 
-    const uint8_t reg_ctrl_meas_val = (0x01 << 5) | (0x03 << 2) | (0x03);
     buf[0] = REG_CTRL_MEAS;
-    buf[1] = reg_ctrl_meas_val;
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
- //   printf("Ctrl_meas register value: %x\n", reg_ctrl_meas_val);
+    buf[1] = ctrl_meas;
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
 }
 
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
+// Retorna false se a transação I2C falhar; nesse caso 'temp' e 'pressure' não são alterados
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
     uint8_t buf[6];
     uint8_t reg = REG_PRESSURE_MSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, 6, false);
+    if (i2c_bus_write(i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(i2c, ADDR, buf, 6, false) != 6) {
+        return false;
+    }
 
     *pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
     *temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
-
-
+    return true;
 }
 
 void bmp280_reset(i2c_inst_t *i2c) {
     uint8_t buf[2] = { REG_RESET, 0xB6 };
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
+}
+
+// Confirma pelo registrador de identificação que há um BMP280 no endereço
+bool bmp280_check(i2c_inst_t *i2c) {
+    uint8_t reg = REG_ID;
+    uint8_t id = 0;
+    if (i2c_bus_write(i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(i2c, ADDR, &id, 1, false) != 1) {
+        return false;
+    }
+    return id == BMP280_CHIP_ID;
 }
 
 // função intermediária que calcula a temperatura de resolução fina
@@ -80,11 +95,14 @@ int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_ca
     return converted;
 }
 
-void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
+// Retorna false se a leitura falhar; nesse caso 'params' não é alterado
+bool bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
     uint8_t buf[NUM_CALIB_PARAMS] = { 0 };
     uint8_t reg = REG_DIG_T1_LSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, NUM_CALIB_PARAMS, false);
+    if (i2c_bus_write(i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(i2c, ADDR, buf, NUM_CALIB_PARAMS, false) != NUM_CALIB_PARAMS) {
+        return false;
+    }
 
     params->dig_t1 = (uint16_t)(buf[1] << 8) | buf[0];
     params->dig_t2 = (int16_t)(buf[3] << 8) | buf[2];
@@ -99,6 +117,5 @@ void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params)
     params->dig_p7 = (int16_t)(buf[19] << 8) | buf[18];
     params->dig_p8 = (int16_t)(buf[21] << 8) | buf[20];
     params->dig_p9 = (int16_t)(buf[23] << 8) | buf[22];
-
-
+    return true;
 }
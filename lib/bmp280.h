@@ -9,6 +9,9 @@
 #define REG_CONFIG _u(0xF5)
 #define REG_CTRL_MEAS _u(0xF4)
 #define REG_RESET _u(0xE0)
+#define REG_ID _u(0xD0)
+
+#define BMP280_CHIP_ID _u(0x58)
 
 #define REG_TEMP_XLSB _u(0xFC)
 #define REG_TEMP_LSB _u(0xFB)
@@ -45,6 +48,14 @@
 
 #define NUM_CALIB_PARAMS 24
 
+// Valores de REG_CONFIG (t_sb << 5 | filtro << 2) e REG_CTRL_MEAS (osrs_t << 5 | osrs_p << 2 | modo)
+// Padrão: standby de 500 ms, filtro IIR 16, temperatura x1, pressão x4, modo normal
+#define BMP280_CONFIG_DEFAULT ((0x04 << 5) | (0x05 << 2))
+#define BMP280_CTRL_MEAS_DEFAULT ((0x01 << 5) | (0x03 << 2) | 0x03)
+// Taxa máxima útil: standby de 0,5 ms, sem filtro, temperatura x1, pressão x2 (~110 Hz)
+#define BMP280_CONFIG_FAST ((0x00 << 5) | (0x00 << 2))
+#define BMP280_CTRL_MEAS_FAST ((0x01 << 5) | (0x02 << 2) | 0x03)
+
 struct bmp280_calib_param {
     uint16_t dig_t1;
     int16_t dig_t2;
@@ -63,10 +74,12 @@ struct bmp280_calib_param {
 
 //void bmp280_init(void);
 void bmp280_init(i2c_inst_t *i2c);
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
+void bmp280_configure(i2c_inst_t *i2c, uint8_t config, uint8_t ctrl_meas);
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
 void bmp280_reset(i2c_inst_t *i2c);
+bool bmp280_check(i2c_inst_t *i2c);
 int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params);
 int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params);
-void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
+bool bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
 
 #endif
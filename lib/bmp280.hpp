@@ -0,0 +1,175 @@
+#ifndef BMP280_HPP
+#define BMP280_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bmp280.h" // registradores, valores de configuração e struct bmp280_calib_param
+
+// Driver do BMP280 especializado em tempo de compilação: barramento (ver
+// barramento_pico.hpp), endereço e configuração são parâmetros do tipo, então cada
+// chamada vira a transação I2C com constantes, sem ponteiro de instância nem
+// despacho virtual. A decodificação da calibração e a compensação são constexpr e
+// dão os mesmos resultados que lib/bmp280.c (verificado com static_assert abaixo).
+namespace bmp280
+{
+using Calibracao = bmp280_calib_param;
+
+constexpr uint16_t u16(const uint8_t *b)
+{
+    return (uint16_t)(b[1] << 8 | b[0]);
+}
+
+constexpr int16_t s16(const uint8_t *b)
+{
+    return (int16_t)(b[1] << 8 | b[0]);
+}
+
+// Registradores 0x88..0x9F (little-endian) -> parâmetros de calibração
+constexpr Calibracao decodificar_calibracao(const uint8_t (&b)[NUM_CALIB_PARAMS])
+{
+    return Calibracao{
+        u16(&b[0]), s16(&b[2]), s16(&b[4]),
+        u16(&b[6]), s16(&b[8]), s16(&b[10]), s16(&b[12]), s16(&b[14]),
+        s16(&b[16]), s16(&b[18]), s16(&b[20]), s16(&b[22]),
+    };
+}
+
+// Temperatura de resolução fina, base das duas compensações. Os deslocamentos à
+// esquerda de lib/bmp280.c viraram multiplicações, definidas também para negativos.
+constexpr int32_t temperatura_fina(int32_t bruto, const Calibracao &c)
+{
+    int32_t var1 = (((bruto >> 3) - ((int32_t)c.dig_t1 * 2)) * (int32_t)c.dig_t2) >> 11;
+    int32_t var2 = (((((bruto >> 4) - (int32_t)c.dig_t1) * ((bruto >> 4) - (int32_t)c.dig_t1)) >> 12) *
+                    (int32_t)c.dig_t3) >> 14;
+    return var1 + var2;
+}
+
+// Centésimos de °C
+constexpr int32_t converter_temperatura(int32_t bruto, const Calibracao &c)
+{
+    return (temperatura_fina(bruto, c) * 5 + 128) >> 8;
+}
+
+// Pa (rotina de 32 bits do datasheet)
+constexpr int32_t converter_pressao(int32_t bruto, int32_t bruto_temp, const Calibracao &c)
+{
+    int32_t var1 = (temperatura_fina(bruto_temp, c) >> 1) - 64000;
+    int32_t var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * (int32_t)c.dig_p6;
+    var2 += (var1 * (int32_t)c.dig_p5) * 2;
+    var2 = (var2 >> 2) + (int32_t)c.dig_p4 * 65536;
+    var1 = (((c.dig_p3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + (((int32_t)c.dig_p2 * var1) >> 1)) >> 18;
+    var1 = ((32768 + var1) * (int32_t)c.dig_p1) >> 15;
+    if (var1 == 0)
+    {
+        return 0; // evita divisão por zero
+    }
+    uint32_t p = ((uint32_t)(1048576 - bruto) - (uint32_t)(var2 >> 12)) * 3125;
+    p = p < 0x80000000u ? (p << 1) / (uint32_t)var1 : (p / (uint32_t)var1) * 2;
+    var1 = ((int32_t)c.dig_p9 * (int32_t)(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+    var2 = ((int32_t)(p >> 2) * (int32_t)c.dig_p8) >> 13;
+    return (int32_t)p + ((var1 + var2 + c.dig_p7) >> 4);
+}
+
+// Exemplo do datasheet: 25,08 °C e 100656 Pa na rotina de 32 bits
+namespace exemplo
+{
+constexpr uint8_t registradores[NUM_CALIB_PARAMS] = {
+    0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC, 0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B,
+    0x27, 0x0B, 0x8C, 0x00, 0xF9, 0xFF, 0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17,
+};
+constexpr Calibracao calibracao = decodificar_calibracao(registradores);
+static_assert(calibracao.dig_t1 == 27504 && calibracao.dig_t3 == -1000 && calibracao.dig_p9 == 6000,
+              "decodificação da calibração");
+static_assert(converter_temperatura(519888, calibracao) == 2508, "compensação da temperatura");
+static_assert(converter_pressao(415148, 519888, calibracao) == 100656, "compensação da pressão");
+} // namespace exemplo
+
+// Leitura de 6 bytes a partir de REG_PRESSURE_MSB -> valores brutos de 20 bits
+constexpr int32_t pressao_bruta(const uint8_t (&b)[6])
+{
+    return (int32_t)b[0] << 12 | (int32_t)b[1] << 4 | b[2] >> 4;
+}
+
+constexpr int32_t temperatura_bruta(const uint8_t (&b)[6])
+{
+    return (int32_t)b[3] << 12 | (int32_t)b[4] << 4 | b[5] >> 4;
+}
+} // namespace bmp280
+
+template <typename Barramento, uint8_t Endereco = 0x76,
+          uint8_t Config = BMP280_CONFIG_DEFAULT, uint8_t CtrlMeas = BMP280_CTRL_MEAS_DEFAULT>
+struct Bmp280
+{
+    static_assert(Endereco == 0x76 || Endereco == 0x77, "o BMP280 só responde em 0x76 ou 0x77");
+
+    // Escritas de configuração, na ordem: filtro/standby antes de entrar no modo normal
+    static constexpr uint8_t sequencia_inicio[][2] = {
+        {REG_CONFIG, (uint8_t)(Config & 0xFC)},
+        {REG_CTRL_MEAS, CtrlMeas},
+    };
+
+    // Confirma pelo registrador de identificação que há um BMP280 no endereço
+    static bool verificar()
+    {
+        uint8_t id = 0;
+        return ler_registradores(REG_ID, &id, 1) && id == BMP280_CHIP_ID;
+    }
+
+    static bool iniciar()
+    {
+        for (const auto &escrita : sequencia_inicio)
+        {
+            if (Barramento::escrever(Endereco, escrita, 2, false) != 2)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool ler_calibracao(bmp280::Calibracao &calibracao)
+    {
+        uint8_t b[NUM_CALIB_PARAMS] = {0};
+        return ler_calibracao(calibracao, b);
+    }
+
+    // Também devolve os registradores 0x88..0x9F como lidos, para quem os guarda
+    static bool ler_calibracao(bmp280::Calibracao &calibracao, uint8_t (&registradores)[NUM_CALIB_PARAMS])
+    {
+        if (!ler_registradores(REG_DIG_T1_LSB, registradores, sizeof(registradores)))
+        {
+            return false;
+        }
+        calibracao = bmp280::decodificar_calibracao(registradores);
+        return true;
+    }
+
+    // Registradores 0xF7..0xFC sem decodificar (pressao_bruta/temperatura_bruta)
+    static bool ler_medicao(uint8_t (&registradores)[6])
+    {
+        return ler_registradores(REG_PRESSURE_MSB, registradores, sizeof(registradores));
+    }
+
+    // Retorna false se a transação falhar; nesse caso 'temp' e 'pressao' não são alterados
+    static bool ler_bruto(int32_t &temp, int32_t &pressao)
+    {
+        uint8_t b[6];
+        if (!ler_medicao(b))
+        {
+            return false;
+        }
+        pressao = bmp280::pressao_bruta(b);
+        temp = bmp280::temperatura_bruta(b);
+        return true;
+    }
+
+private:
+    static bool ler_registradores(uint8_t registrador, uint8_t *dados, size_t tam)
+    {
+        return Barramento::escrever(Endereco, &registrador, 1, true) == 1 &&
+               Barramento::ler(Endereco, dados, tam, false) == (int)tam;
+    }
+};
+
+#endif // BMP280_HPP
@@ -0,0 +1,95 @@
+#include "i2c_bus.h"
+#include "hardware/gpio.h"
+
+// Meio período do SCL gerado na recuperação (~100 kHz)
+#define HALF_PERIOD_US 5
+
+typedef struct {
+    bool configured;
+    uint sda, scl;
+    uint baudrate;
+    i2c_bus_stats_t stats;
+} bus_t;
+
+static bus_t buses[2];
+
+static bus_t *bus_of(i2c_inst_t *i2c) {
+    return &buses[i2c_hw_index(i2c)];
+}
+
+static void attach_pins(const bus_t *b) {
+    gpio_set_function(b->sda, GPIO_FUNC_I2C);
+    gpio_set_function(b->scl, GPIO_FUNC_I2C);
+    gpio_pull_up(b->sda);
+    gpio_pull_up(b->scl);
+}
+
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate) {
+    bus_t *b = bus_of(i2c);
+    b->configured = true;
+    b->sda = sda;
+    b->scl = scl;
+    b->baudrate = baudrate;
+    i2c_init(i2c, baudrate);
+    attach_pins(b);
+}
+
+static int check(i2c_inst_t *i2c, int result) {
+    if (result == PICO_ERROR_TIMEOUT) {
+        bus_of(i2c)->stats.timeouts++;
+        i2c_bus_recover(i2c);
+    }
+    return result;
+}
+
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    return check(i2c, i2c_write_timeout_per_char_us(i2c, addr, src, len, nostop, I2C_BUS_TIMEOUT_PER_CHAR_US));
+}
+
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    return check(i2c, i2c_read_timeout_per_char_us(i2c, addr, dst, len, nostop, I2C_BUS_TIMEOUT_PER_CHAR_US));
+}
+
+// Linhas em dreno aberto: nível baixo = saída em 0, nível alto = entrada (pull-up)
+static void line(uint pin, bool high) {
+    gpio_set_dir(pin, high ? GPIO_IN : GPIO_OUT);
+    busy_wait_us(HALF_PERIOD_US);
+}
+
+bool i2c_bus_recover(i2c_inst_t *i2c) {
+    bus_t *b = bus_of(i2c);
+    if (!b->configured)
+        return false;
+
+    i2c_deinit(i2c);
+    gpio_init(b->sda); // SIO, entrada, saída em 0
+    gpio_init(b->scl);
+    gpio_pull_up(b->sda);
+    gpio_pull_up(b->scl);
+    busy_wait_us(HALF_PERIOD_US);
+
+    // O escravo que segura SDA está no meio de um byte: cada pulso avança um bit
+    for (int i = 0; i < I2C_BUS_RECOVERY_PULSES && !gpio_get(b->sda); i++) {
+        line(b->scl, false);
+        line(b->scl, true);
+    }
+
+    // STOP: SDA sobe com SCL em alto
+    line(b->scl, false);
+    line(b->sda, false);
+    line(b->scl, true);
+    line(b->sda, true);
+
+    bool free = gpio_get(b->sda) && gpio_get(b->scl);
+    i2c_init(i2c, b->baudrate);
+    attach_pins(b);
+
+    b->stats.recoveries++;
+    if (!free)
+        b->stats.failed_recoveries++;
+    return free;
+}
+
+const i2c_bus_stats_t *i2c_bus_stats(i2c_inst_t *i2c) {
+    return &bus_of(i2c)->stats;
+}
@@ -0,0 +1,47 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Acesso ao barramento I2C com tempo limitado, usado por todos os drivers de lib/.
+// Cada byte tem I2C_BUS_TIMEOUT_PER_CHAR_US para completar; um escravo segurando SDA
+// ou SCL faz a transação falhar em vez de travar o núcleo. Em um estouro de tempo o
+// barramento é recuperado na hora (i2c_bus_recover) e a transação retorna
+// PICO_ERROR_TIMEOUT; quem chama decide se tenta de novo.
+
+// 400 kHz: um byte com ACK leva ~23 us; a folga cobre o clock stretching do AHT20
+#define I2C_BUS_TIMEOUT_PER_CHAR_US 500
+// Pulsos de SCL na recuperação: o bastante para o escravo terminar o byte que enviava
+#define I2C_BUS_RECOVERY_PULSES 9
+
+typedef struct {
+    uint32_t timeouts;          // transações que estouraram o tempo
+    uint32_t recoveries;        // recuperações do barramento
+    uint32_t failed_recoveries; // SDA ou SCL continuaram em nível baixo
+} i2c_bus_stats_t;
+
+// i2c_init com a frequência dada, pinos na função I2C com pull-up. Guarda os
+// pinos para a recuperação.
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate);
+
+// Mesma semântica de i2c_write_blocking/i2c_read_blocking (bytes ou < 0)
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// Desliga o periférico, gera até I2C_BUS_RECOVERY_PULSES pulsos de SCL enquanto SDA
+// estiver em baixo, fecha com um STOP e reinicia o periférico. Retorna true se as
+// duas linhas ficaram livres. Quem chama precisa ter o barramento reservado.
+bool i2c_bus_recover(i2c_inst_t *i2c);
+
+const i2c_bus_stats_t *i2c_bus_stats(i2c_inst_t *i2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I2C_BUS_H
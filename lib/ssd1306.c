@@ -1,5 +1,6 @@
 #include "ssd1306.h"
-#include "font.h"
+#include "i2c_bus.h"
+#include <string.h>
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -13,59 +14,121 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->port_buffer[0] = 0x80;
 }
 
-void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
-}
-
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+// Retorna false na primeira transação que falhar (display ausente ou barramento preso)
+bool ssd1306_config(ssd1306_t *ssd) {
+  static const uint8_t commands[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01,
+  };
+  for (size_t i = 0; i < sizeof(commands); ++i) {
+    if (!ssd1306_command(ssd, commands[i]))
+      return false;
+  }
+  return true;
+}
+
+bool ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  return i2c_bus_write(
     ssd->i2c_port,
     ssd->address,
     ssd->port_buffer,
     2,
     false
-  );
+  ) == 2;
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
+// Janela de escrita na RAM do display; os dados seguintes a preenchem coluna a coluna
+static bool set_window(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end) {
+  return ssd1306_command(ssd, SET_COL_ADDR) &&
+         ssd1306_command(ssd, col_start) &&
+         ssd1306_command(ssd, col_end) &&
+         ssd1306_command(ssd, SET_PAGE_ADDR) &&
+         ssd1306_command(ssd, page_start) &&
+         ssd1306_command(ssd, page_end);
+}
+
+bool ssd1306_send_data(ssd1306_t *ssd) {
+  if (!set_window(ssd, 0, ssd->pages - 1, 0, ssd->width - 1))
+    return false;
+  return i2c_bus_write(
     ssd->i2c_port,
     ssd->address,
     ssd->ram_buffer,
     ssd->bufsize,
     false
-  );
+  ) == (int)ssd->bufsize;
+}
+
+// Envia só a janela [page_start..page_end] x [col_start..col_end] do ram_buffer.
+// No endereçamento vertical a janela vai coluna a coluna, em blocos que continuam
+// de onde o anterior parou na RAM do display.
+bool ssd1306_send_region(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end) {
+  uint8_t chunk[1 + 16 * 8];
+  uint8_t rows = page_end - page_start + 1;
+  size_t pos = 1;
+
+  if (!set_window(ssd, page_start, page_end, col_start, col_end))
+    return false;
+
+  chunk[0] = 0x40;
+  for (uint16_t x = col_start; x <= col_end; ++x) {
+    memcpy(&chunk[pos], &ssd->ram_buffer[1 + x * ssd->pages + page_start], rows);
+    pos += rows;
+    if (pos + rows > sizeof(chunk) || x == col_end) {
+      if (i2c_bus_write(ssd->i2c_port, ssd->address, chunk, pos, false) != (int)pos)
+        return false;
+      pos = 1;
+    }
+  }
+  return true;
+}
+
+// Desloca as páginas [page_start..page_end] do ram_buffer uma coluna para a
+// esquerda e limpa a última coluna. Só o buffer muda.
+void ssd1306_shift_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end) {
+  uint8_t rows = page_end - page_start + 1;
+  uint8_t *col = &ssd->ram_buffer[1 + page_start];
+
+  if (rows == ssd->pages) {
+    memmove(col, col + ssd->pages, (ssd->width - 1) * ssd->pages);
+  } else {
+    for (uint8_t x = 0; x < ssd->width - 1; ++x, col += ssd->pages)
+      memcpy(col, col + ssd->pages, rows);
+  }
+  memset(&ssd->ram_buffer[1 + (ssd->width - 1) * ssd->pages + page_start], 0, rows);
+}
+
+// O mesmo deslocamento feito pelo próprio controlador (content scroll, 2Dh): a RAM
+// do display anda uma coluna para a esquerda em toda a largura e o ram_buffer
+// acompanha, então os dois continuam iguais e só a nova última coluna precisa ser
+// desenhada e enviada. Exige pelo menos dois quadros (~20 ms) entre chamadas.
+// Com false, a RAM do display pode ter ficado diferente do buffer.
+bool ssd1306_scroll_content_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end) {
+  const uint8_t commands[] = {
+    SET_SCROLL_OFF,
+    SET_CONTENT_SCROLL_LEFT, 0x00, page_start, 0x01, page_end, 0, ssd->width - 1,
+  };
+  ssd1306_shift_left(ssd, page_start, page_end);
+  for (size_t i = 0; i < sizeof(commands); ++i) {
+    if (!ssd1306_command(ssd, commands[i]))
+      return false;
+  }
+  return true;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
@@ -77,24 +140,11 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     ssd->ram_buffer[index] &= ~(1 << pixel);
 }
 
-/*
+// Cada byte do buffer (menos o de controle) é uma coluna de 8 pixels de uma página
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
-
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+  memset(ssd->ram_buffer + 1, value ? 0xFF : 0x00, ssd->bufsize - 1);
 }
 
-
-
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
   for (uint8_t x = left; x < left + width; ++x) {
     ssd1306_pixel(ssd, x, top, value);
@@ -153,31 +203,64 @@ void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value
     ssd1306_pixel(ssd, x, y, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
+// Copia um glifo para o ram_buffer com o canto superior esquerdo em (x, y). O glifo
+// é opaco: o fundo apaga o que havia embaixo. Com y múltiplo de 8, cada coluna do
+// glifo vai com um memcpy para as páginas correspondentes; fora disso, cada byte é
+// deslocado e dividido entre duas páginas vizinhas, preservando as linhas de fora.
+void ssd1306_draw_glyph(ssd1306_t *ssd, const ssd1306_font_t *font, char c, uint8_t x, uint8_t y) {
+  static const uint8_t blank[8] = {0};
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 7;
+  const uint8_t *src = NULL;
 
-  // Verifica o caractere e calcula o índice correspondente na fonte
-  if (c >= ' ' && c <= '~') // Verifica se o caractere está na faixa ASCII válida
-  {
-    index = (c - ' ') * 8; // Calcula o índice baseado na posição do caractere na tabela ASCII
-  }
-  else
-  {
-    // Caractere inválido, desenha um espaço (ou pode ser tratado de outra forma)
-    index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
-  }
+  if (page >= ssd->pages)
+    return;
+  if (c >= font->first && c <= font->last)
+    src = font->data + (size_t)(c - font->first) * font->width * font->pages;
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+  // Páginas do glifo que cabem no display
+  uint8_t rows = font->pages;
+  if (page + rows > ssd->pages)
+    rows = ssd->pages - page;
+
+  uint8_t keep = (1 << shift) - 1; // linhas acima do glifo na primeira página
+  for (uint8_t i = 0; i < font->width && x + i < ssd->width; ++i) {
+    const uint8_t *col = src ? src + i * font->pages : blank;
+    uint8_t *dst = &ssd->ram_buffer[1 + (x + i) * ssd->pages + page];
+
+    if (shift == 0) {
+      memcpy(dst, col, rows);
+      continue;
     }
+
+    dst[0] = (dst[0] & keep) | (uint8_t)(col[0] << shift);
+    for (uint8_t k = 1; k < rows; ++k)
+      dst[k] = (uint8_t)(col[k - 1] >> (8 - shift)) | (uint8_t)(col[k] << shift);
+    if (page + font->pages < ssd->pages)
+      dst[font->pages] = (dst[font->pages] & ~keep) | (col[font->pages - 1] >> (8 - shift));
+  }
+}
+
+// Desenha a string numa linha só, sem quebra, cortando no fim do display.
+// Retorna o x logo depois do último caractere.
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y) {
+  while (*str && x < ssd->width) {
+    ssd1306_draw_glyph(ssd, font, *str++, x, y);
+    x = (x + font->width < ssd->width) ? x + font->width : ssd->width;
   }
+  return x;
+}
+
+// Largura da string na fonte, em colunas (para alinhar à direita ou centralizar)
+uint8_t ssd1306_text_width(const ssd1306_font_t *font, const char *str) {
+  size_t n = strlen(str);
+  return n * font->width > 255 ? 255 : (uint8_t)(n * font->width);
+}
+
+// Função para desenhar um caractere (fonte 8x8; fora de ' '..'~' desenha um espaço)
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  ssd1306_draw_glyph(ssd, &ssd1306_font_8x8, c, x, y);
 }
 
 // Função para desenhar uma string
@@ -197,4 +280,4 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
       break;
     }
   }
-}
\ No newline at end of file
+}
@@ -1,6 +1,10 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "ssd1306_font.h"
 
 #define WIDTH 128
 #define HEIGHT 64
@@ -22,7 +26,9 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_SCROLL_OFF = 0x2E,
+  SET_CONTENT_SCROLL_LEFT = 0x2D
 } ssd1306_command_t;
 
 typedef struct {
@@ -35,9 +41,12 @@ typedef struct {
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
-void ssd1306_config(ssd1306_t *ssd);
-void ssd1306_command(ssd1306_t *ssd, uint8_t command);
-void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_config(ssd1306_t *ssd);
+bool ssd1306_command(ssd1306_t *ssd, uint8_t command);
+bool ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_send_region(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end);
+void ssd1306_shift_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end);
+bool ssd1306_scroll_content_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -46,4 +55,9 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_draw_glyph(ssd1306_t *ssd, const ssd1306_font_t *font, char c, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_text_width(const ssd1306_font_t *font, const char *str);
+
+#endif // SSD1306_H
@@ -0,0 +1,291 @@
+// Gerado por host/gerar_fontes.c; não editar à mão.
+#include "ssd1306_font.h"
+#include "font.h"
+
+const ssd1306_font_t ssd1306_font_8x8 = {font, 8, 1, ' ', '~'};
+
+// Fonte 8x8 ampliada para 16x16 (EPX)
+static const uint8_t font_16x16[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x31, 0xFF, 0x33,
+    0xFF, 0x33, 0xFE, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '!'
+    0x00, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '"'
+    0x30, 0x03, 0x38, 0x07, 0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x30, 0x03, 0x30, 0x03,
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x38, 0x07, 0x30, 0x03, 0x00, 0x00, 0x00, 0x00, // '#'
+    0x30, 0x0C, 0x78, 0x0C, 0x78, 0x0C, 0xFC, 0x0C, 0xCC, 0x0C, 0xCE, 0x1C, 0xCE, 0x1C, 0xCF, 0x3C,
+    0xCF, 0x3C, 0xCE, 0x1C, 0xCE, 0x1F, 0x8C, 0x07, 0x8C, 0x07, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, // '$'
+    0x18, 0x30, 0x3C, 0x38, 0x3C, 0x38, 0x18, 0x1E, 0x00, 0x1E, 0x80, 0x07, 0x80, 0x07, 0xE0, 0x01,
+    0xE0, 0x01, 0x78, 0x00, 0x78, 0x18, 0x1C, 0x3C, 0x1C, 0x3C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, // '%'
+    0x00, 0x06, 0x80, 0x1F, 0x8C, 0x1F, 0xCE, 0x3F, 0xFE, 0x38, 0xFF, 0x30, 0xF3, 0x31, 0xF3, 0x33,
+    0x3F, 0x07, 0x1E, 0x0F, 0x8E, 0x1F, 0xCC, 0x3F, 0xC0, 0x39, 0xC0, 0x30, 0x00, 0x00, 0x00, 0x00, // '&'
+    0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x38, 0x00, 0x3E, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x06, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '''
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x01, 0xF8, 0x07, 0xF8, 0x07, 0xFE, 0x1F,
+    0x1E, 0x1E, 0x07, 0x38, 0x07, 0x38, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '('
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x07, 0x38, 0x07, 0x38, 0x1E, 0x1E,
+    0xFE, 0x1F, 0xF8, 0x07, 0xF8, 0x07, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ')'
+    0xC0, 0x00, 0xC0, 0x00, 0xCC, 0x0C, 0xCC, 0x0C, 0xFC, 0x0F, 0xF8, 0x07, 0xF8, 0x07, 0xF0, 0x03,
+    0xF0, 0x03, 0xF8, 0x07, 0xF8, 0x07, 0xFC, 0x0F, 0xCC, 0x0C, 0xCC, 0x0C, 0xC0, 0x00, 0xC0, 0x00, // '*'
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0xF8, 0x07, 0xFC, 0x0F,
+    0xFC, 0x0F, 0xF8, 0x07, 0xE0, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // '+'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xE0, 0x00, 0xF8, 0x00, 0x7C,
+    0x00, 0x7C, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ','
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x3C,
+    0x00, 0x3C, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '.'
+    0x00, 0x38, 0x00, 0x3E, 0x00, 0x1E, 0x80, 0x07, 0x80, 0x07, 0xE0, 0x01, 0xE0, 0x01, 0x78, 0x00,
+    0x78, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x07, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // '/'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0xC7, 0x33, 0xC3, 0x31, 0xE3, 0x31, 0x73, 0x30,
+    0x3F, 0x30, 0x3F, 0x38, 0xFF, 0x3F, 0xFE, 0x1F, 0xFE, 0x1F, 0xF8, 0x07, 0x00, 0x00, 0x00, 0x00, // '0'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x30, 0x0C, 0x30, 0x1E, 0x38, 0xFE, 0x3F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xFE, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, // '1'
+    0x0C, 0x1E, 0x8E, 0x3F, 0x8E, 0x3F, 0xC7, 0x3F, 0xC7, 0x39, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xE7, 0x30, 0xFF, 0x30, 0x7E, 0x30, 0x7E, 0x30, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, // '2'
+    0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xE7, 0x39, 0xFF, 0x3F, 0xFE, 0x1F, 0x3E, 0x1F, 0x18, 0x06, 0x00, 0x00, 0x00, 0x00, // '3'
+    0xF8, 0x01, 0xFC, 0x03, 0xFC, 0x03, 0xF8, 0x03, 0x80, 0x03, 0x00, 0x03, 0x00, 0x03, 0x80, 0x07,
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x80, 0x07, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, // '4'
+    0x1E, 0x0C, 0x3F, 0x1C, 0x3F, 0x1C, 0x3F, 0x38, 0x33, 0x38, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30,
+    0x33, 0x30, 0x73, 0x38, 0xF3, 0x3F, 0xE3, 0x1F, 0xE3, 0x1F, 0x83, 0x07, 0x00, 0x00, 0x00, 0x00, // '5'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0xE7, 0x39, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xC3, 0x39, 0xC3, 0x3F, 0x83, 0x1F, 0x80, 0x1F, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, // '6'
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x18, 0x03, 0x3E, 0x03, 0x3E, 0x83, 0x1F,
+    0x83, 0x07, 0xE7, 0x01, 0xFF, 0x01, 0x7F, 0x00, 0x7F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, // '7'
+    0x18, 0x06, 0x3E, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0xE7, 0x39, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xE7, 0x39, 0xFF, 0x3F, 0xFE, 0x1F, 0x3E, 0x1F, 0x18, 0x06, 0x00, 0x00, 0x00, 0x00, // '8'
+    0x18, 0x00, 0x7E, 0x00, 0x7E, 0x30, 0xFF, 0x30, 0xE7, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xE7, 0x39, 0xFF, 0x3F, 0xFE, 0x1F, 0xFE, 0x1F, 0xF8, 0x07, 0x00, 0x00, 0x00, 0x00, // '9'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x3C, 0x3C,
+    0x3C, 0x3C, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ':'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xE0, 0x18, 0xF8, 0x3C, 0x7C,
+    0x3C, 0x7C, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ';'
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0xE0, 0x01, 0xF8, 0x07, 0x38, 0x07, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x07, 0x38, 0x07, 0x38, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '<'
+    0x00, 0x00, 0x00, 0x00, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03,
+    0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x00, 0x00, 0x00, 0x00, // '='
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x07, 0x38, 0x07, 0x38, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x38, 0x07, 0xF8, 0x07, 0xE0, 0x01, 0xE0, 0x01, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // '>'
+    0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x87, 0x31, 0xE3, 0x33,
+    0xE3, 0x33, 0xF3, 0x31, 0x7F, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, // '?'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0xE3, 0x31, 0xF3, 0x33,
+    0xF3, 0x33, 0xF3, 0x33, 0xFF, 0x33, 0xFE, 0x33, 0xFE, 0x33, 0xF8, 0x31, 0x00, 0x00, 0x00, 0x00, // '@'
+    0xE0, 0x1F, 0xF8, 0x3F, 0xF8, 0x3F, 0xFE, 0x1F, 0x9E, 0x07, 0x07, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x07, 0x03, 0x9E, 0x07, 0xFE, 0x1F, 0xF8, 0x3F, 0xF8, 0x3F, 0xE0, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'A'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xE7, 0x39, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xE7, 0x39, 0xFF, 0x3F, 0xFE, 0x1F, 0x3E, 0x1F, 0x18, 0x06, 0x00, 0x00, 0x00, 0x00, // 'B'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30,
+    0x03, 0x30, 0x07, 0x38, 0x07, 0x38, 0x0E, 0x1C, 0x0E, 0x1C, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0x00, // 'C'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x07, 0x38,
+    0x07, 0x38, 0x1E, 0x1E, 0xFE, 0x1F, 0xF8, 0x07, 0xF8, 0x07, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x00, // 'D'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xE7, 0x39, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xC3, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, // 'E'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xE7, 0x01, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00,
+    0xC3, 0x00, 0xC3, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // 'F'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30,
+    0x03, 0x33, 0x07, 0x33, 0x07, 0x3F, 0x0E, 0x1F, 0x0E, 0x1F, 0x0C, 0x06, 0x00, 0x00, 0x00, 0x00, // 'G'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0xE0, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xE0, 0x01, 0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'H'
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x07, 0x38, 0xFF, 0x3F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, // 'I'
+    0x00, 0x0C, 0x00, 0x1C, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x38, 0xFE, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFE, 0x07, 0x00, 0x00, 0x00, 0x00, // 'J'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0xF8, 0x07,
+    0x38, 0x07, 0x1E, 0x1E, 0x1E, 0x1E, 0x07, 0x38, 0x07, 0x38, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, // 'K'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, // 'L'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0xFE, 0x00, 0xF8, 0x00, 0xF0, 0x03, 0xF0, 0x03,
+    0xF8, 0x00, 0xFE, 0x00, 0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'M'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x3E, 0x00, 0x38, 0x00, 0x78, 0x00, 0xE0, 0x01,
+    0xC0, 0x01, 0xC0, 0x07, 0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'N'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30,
+    0x03, 0x30, 0x07, 0x38, 0xFF, 0x3F, 0xFE, 0x1F, 0xFE, 0x1F, 0xF8, 0x07, 0x00, 0x00, 0x00, 0x00, // 'O'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xE7, 0x01, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00,
+    0xC3, 0x00, 0xE7, 0x00, 0xFF, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, // 'P'
+    0xF8, 0x07, 0xFE, 0x1F, 0xFE, 0x1F, 0xFF, 0x3F, 0x07, 0x30, 0x03, 0x30, 0x03, 0x3F, 0x03, 0x3F,
+    0x03, 0x3C, 0x07, 0x7C, 0xFF, 0x7F, 0xFE, 0xFF, 0xFE, 0xCF, 0xF8, 0xC7, 0x00, 0x00, 0x00, 0x00, // 'Q'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xE7, 0x00, 0xC3, 0x00, 0xC3, 0x01, 0xC3, 0x07,
+    0xC3, 0x07, 0xE7, 0x1F, 0xFF, 0x1C, 0x7E, 0x38, 0x7E, 0x38, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, // 'R'
+    0x18, 0x0C, 0x7E, 0x1C, 0x7E, 0x1C, 0xFF, 0x38, 0xE7, 0x38, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xC7, 0x39, 0xC7, 0x3F, 0x8E, 0x1F, 0x8E, 0x1F, 0x0C, 0x06, 0x00, 0x00, 0x00, 0x00, // 'S'
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07, 0x00, 0xFF, 0x1F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xFF, 0x1F, 0x07, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, // 'T'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x38, 0xFE, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'U'
+    0xFE, 0x01, 0xFF, 0x07, 0xFF, 0x07, 0xFE, 0x1F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C,
+    0x00, 0x3C, 0x00, 0x1E, 0xFE, 0x1F, 0xFF, 0x07, 0xFF, 0x07, 0xFE, 0x01, 0x00, 0x00, 0x00, 0x00, // 'V'
+    0xFE, 0x07, 0xFF, 0x1F, 0xFF, 0x1F, 0xFE, 0x3F, 0x00, 0x3C, 0x00, 0x1C, 0x00, 0x0F, 0x00, 0x0F,
+    0x00, 0x1C, 0x00, 0x3C, 0xFE, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFE, 0x07, 0x00, 0x00, 0x00, 0x00, // 'W'
+    0x06, 0x18, 0x1F, 0x3E, 0x1F, 0x3E, 0x3E, 0x1F, 0xF8, 0x07, 0xE0, 0x01, 0xC0, 0x00, 0xC0, 0x00,
+    0xE0, 0x01, 0xF8, 0x07, 0x3E, 0x1F, 0x1F, 0x3E, 0x1F, 0x3E, 0x06, 0x18, 0x00, 0x00, 0x00, 0x00, // 'X'
+    0x1E, 0x30, 0x7F, 0x30, 0x7F, 0x30, 0xFE, 0x38, 0xE0, 0x38, 0xC0, 0x1C, 0xC0, 0x1F, 0xC0, 0x07,
+    0xC0, 0x07, 0xE0, 0x01, 0xFE, 0x01, 0x7F, 0x00, 0x7F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, // 'Y'
+    0x03, 0x30, 0x03, 0x38, 0x03, 0x38, 0x03, 0x3E, 0x03, 0x3E, 0x83, 0x3F, 0x83, 0x33, 0xE3, 0x31,
+    0xE3, 0x31, 0x73, 0x30, 0x7F, 0x30, 0x1F, 0x30, 0x1F, 0x30, 0x06, 0x30, 0x00, 0x00, 0x00, 0x00, // 'Z'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F,
+    0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '['
+    0x03, 0x00, 0x07, 0x00, 0x07, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x78, 0x00, 0x78, 0x00, 0xE0, 0x01,
+    0xE0, 0x01, 0x80, 0x07, 0x80, 0x07, 0x00, 0x1E, 0x00, 0x3E, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, // '\\'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x07, 0x38,
+    0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ']'
+    0xC0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x78, 0x00, 0x78, 0x00, 0x1E, 0x00, 0x0F, 0x00, 0x0F, 0x00,
+    0x1E, 0x00, 0x78, 0x00, 0x78, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // '^'
+    0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, // '_'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x1F, 0x00,
+    0x1F, 0x00, 0x3E, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '`'
+    0x00, 0x0C, 0x00, 0x1E, 0x30, 0x1E, 0x30, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33,
+    0x30, 0x33, 0x30, 0x33, 0xF0, 0x3F, 0xE0, 0x3F, 0xE0, 0x3F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'a'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x3F, 0xE0, 0x39, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30,
+    0xC0, 0x30, 0xC0, 0x39, 0xC0, 0x3F, 0x80, 0x1F, 0x80, 0x1F, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, // 'b'
+    0x80, 0x07, 0xE0, 0x1F, 0xE0, 0x1F, 0xF0, 0x3F, 0x70, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x70, 0x38, 0x70, 0x38, 0xE0, 0x1C, 0xE0, 0x1C, 0xC0, 0x0C, 0x00, 0x00, 0x00, 0x00, // 'c'
+    0x00, 0x06, 0x80, 0x1F, 0x80, 0x1F, 0xC0, 0x3F, 0xC0, 0x39, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30,
+    0xC0, 0x30, 0xE0, 0x39, 0xFE, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'd'
+    0x80, 0x07, 0xE0, 0x1F, 0xE0, 0x1F, 0xF0, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33,
+    0x30, 0x33, 0x30, 0x33, 0xF0, 0x33, 0xE0, 0x33, 0xE0, 0x03, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, // 'e'
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x30, 0xE0, 0x39, 0xF8, 0x3F, 0xFE, 0x3F, 0xFE, 0x3F, 0xFF, 0x3F,
+    0xE3, 0x39, 0xC3, 0x30, 0x07, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, // 'f'
+    0x80, 0xC1, 0xE0, 0xC7, 0xE0, 0xC7, 0xF0, 0xCF, 0x70, 0xCE, 0x30, 0xCC, 0x30, 0xCC, 0x30, 0xCC,
+    0x30, 0xCC, 0x70, 0xCE, 0xF0, 0xFF, 0xF0, 0x7F, 0xF0, 0x7F, 0xE0, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'g'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x78, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x70, 0x00, 0xF0, 0x1F, 0xE0, 0x3F, 0xE0, 0x3F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'h'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x70, 0x38, 0xF3, 0x3F, 0xF3, 0x3F,
+    0xF3, 0x3F, 0xE3, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 'i'
+    0x00, 0x30, 0x00, 0x70, 0x00, 0x70, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x00, 0xC0, 0x00, 0xE0, 0xE3, 0xFF, 0xF3, 0x7F, 0xF3, 0x7F, 0xE3, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'j'
+    0xFE, 0x1F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFE, 0x1F, 0x00, 0x07, 0x00, 0x03, 0x80, 0x03, 0xE0, 0x07,
+    0xE0, 0x07, 0xF0, 0x1F, 0x70, 0x1E, 0x30, 0x38, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, // 'k'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x07, 0x38, 0xFF, 0x3F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xFE, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 'l'
+    0xE0, 0x1F, 0xF0, 0x3F, 0xF0, 0x3F, 0xE0, 0x1F, 0xE0, 0x03, 0xC0, 0x03, 0xC0, 0x3F, 0xE0, 0x3F,
+    0xE0, 0x03, 0xF0, 0x03, 0xF0, 0x1F, 0xE0, 0x3F, 0xE0, 0x3F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'm'
+    0xE0, 0x1F, 0xF0, 0x3F, 0xF0, 0x3F, 0xF0, 0x1F, 0x70, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x70, 0x00, 0xF0, 0x1F, 0xE0, 0x3F, 0xE0, 0x3F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'n'
+    0x80, 0x07, 0xE0, 0x1F, 0xE0, 0x1F, 0xF0, 0x3F, 0x70, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x70, 0x38, 0xF0, 0x3F, 0xE0, 0x1F, 0xE0, 0x1F, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, // 'o'
+    0xE0, 0x7F, 0xF0, 0xFF, 0xF0, 0xFF, 0xF0, 0x7F, 0x70, 0x1E, 0x30, 0x0C, 0x30, 0x0C, 0x30, 0x0C,
+    0x30, 0x0C, 0x70, 0x0E, 0xF0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, // 'p'
+    0x80, 0x01, 0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x0F, 0x70, 0x0E, 0x30, 0x0C, 0x30, 0x0C, 0x30, 0x0C,
+    0x30, 0x0C, 0x70, 0x1E, 0xF0, 0x7F, 0xF0, 0xFF, 0xF0, 0xFF, 0xE0, 0x7F, 0x00, 0x00, 0x00, 0x00, // 'q'
+    0xE0, 0x1F, 0xF0, 0x3F, 0xF0, 0x3F, 0xF0, 0x1F, 0x70, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x70, 0x00, 0x70, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // 'r'
+    0xC0, 0x30, 0xE0, 0x31, 0xE0, 0x31, 0xF0, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33,
+    0x30, 0x33, 0x30, 0x33, 0x30, 0x3F, 0x30, 0x1E, 0x30, 0x1E, 0x30, 0x0C, 0x00, 0x00, 0x00, 0x00, // 's'
+    0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x78, 0x00, 0xFE, 0x07, 0xFF, 0x1F,
+    0xFF, 0x1F, 0xFE, 0x3F, 0x78, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, // 't'
+    0xE0, 0x07, 0xF0, 0x1F, 0xF0, 0x1F, 0xE0, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x38, 0xE0, 0x3F, 0xF0, 0x3F, 0xF0, 0x3F, 0xE0, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'u'
+    0xE0, 0x01, 0xF0, 0x07, 0xF0, 0x07, 0xE0, 0x1F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C,
+    0x00, 0x3C, 0x00, 0x1E, 0xE0, 0x1F, 0xF0, 0x07, 0xF0, 0x07, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x00, // 'v'
+    0xE0, 0x07, 0xF0, 0x1F, 0xF0, 0x1F, 0xE0, 0x3F, 0x00, 0x3C, 0x00, 0x1C, 0x00, 0x0F, 0x00, 0x0F,
+    0x00, 0x1C, 0x00, 0x3C, 0xE0, 0x3F, 0xF0, 0x1F, 0xF0, 0x1F, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00, // 'w'
+    0x30, 0x30, 0x70, 0x38, 0x70, 0x38, 0xE0, 0x1C, 0xE0, 0x1F, 0x80, 0x07, 0x00, 0x03, 0x00, 0x03,
+    0x80, 0x07, 0xE0, 0x1F, 0xE0, 0x1C, 0x70, 0x38, 0x70, 0x38, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, // 'x'
+    0xE0, 0xC1, 0xF0, 0xC7, 0xF0, 0xC7, 0xE0, 0xCF, 0x00, 0xCE, 0x00, 0xCC, 0x00, 0xCC, 0x00, 0xCC,
+    0x00, 0xCC, 0x00, 0xCE, 0xE0, 0xFF, 0xF0, 0x7F, 0xF0, 0x7F, 0xE0, 0x1F, 0x00, 0x00, 0x00, 0x00, // 'y'
+    0x30, 0x30, 0x30, 0x38, 0x30, 0x38, 0x30, 0x3E, 0x30, 0x3E, 0x30, 0x3F, 0x30, 0x33, 0x30, 0x33,
+    0xF0, 0x33, 0xF0, 0x31, 0xF0, 0x31, 0x70, 0x30, 0x70, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, // 'z'
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0xF8, 0x07, 0xFE, 0x1F,
+    0x3E, 0x1F, 0x1F, 0x3E, 0x07, 0x38, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, // '{'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x1E, 0x3F, 0x3F,
+    0x3F, 0x3F, 0x1E, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '|'
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x07, 0x38, 0x1F, 0x3E, 0x3E, 0x1F,
+    0xFE, 0x1F, 0xF8, 0x07, 0xE0, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, // '}'
+    0x0C, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07, 0x00, 0x0E, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // '~'
+};
+
+const ssd1306_font_t ssd1306_font_16x16 = {font_16x16, 16, 2, ' ', '~'};
+
+// Dígitos de sete segmentos, 24x32, de '-' a ':'
+static const uint8_t font_digits_24x32[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xC0, 0x01, 0x00,
+    0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00,
+    0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00,
+    0x00, 0xC0, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x78,
+    0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '.'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '/'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0xFC, 0x03,
+    0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07, 0xEC, 0x1F, 0xFC, 0x1B, 0x1E, 0x00, 0x00, 0x3C,
+    0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C,
+    0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C, 0x1E, 0x00, 0x00, 0x3C,
+    0x1E, 0x00, 0x00, 0x3C, 0xEC, 0x1F, 0xFC, 0x1B, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '0'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0xFC, 0x03, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '1'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x03,
+    0x00, 0x00, 0xFE, 0x07, 0x00, 0x00, 0xFE, 0x07, 0x0C, 0x80, 0xFC, 0x1B, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0xEC, 0x9F, 0x00, 0x18, 0xF0, 0x3F, 0x00, 0x00, 0xF0, 0x3F, 0x00, 0x00,
+    0xE0, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '2'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x80, 0x00, 0x18, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0xEC, 0x9F, 0xFC, 0x1B, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '3'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0x00, 0x00,
+    0xF0, 0x3F, 0x00, 0x00, 0xF0, 0x3F, 0x00, 0x00, 0xE0, 0x9F, 0x00, 0x00, 0x00, 0xC0, 0x01, 0x00,
+    0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00,
+    0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xE0, 0x03, 0x00,
+    0x00, 0xC0, 0x01, 0x00, 0xE0, 0x9F, 0xFC, 0x03, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '4'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0x00, 0x00,
+    0xF0, 0x3F, 0x00, 0x00, 0xF0, 0x3F, 0x00, 0x00, 0xEC, 0x9F, 0x00, 0x18, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0x0C, 0x80, 0xFC, 0x1B, 0x00, 0x00, 0xFE, 0x07, 0x00, 0x00, 0xFE, 0x07,
+    0x00, 0x00, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '5'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0xFC, 0x03,
+    0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07, 0xEC, 0x9F, 0xFC, 0x1B, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0x0C, 0x80, 0xFC, 0x1B, 0x00, 0x00, 0xFE, 0x07, 0x00, 0x00, 0xFE, 0x07,
+    0x00, 0x00, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '6'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0xEC, 0x1F, 0xFC, 0x03, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '7'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0xFC, 0x03,
+    0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07, 0xEC, 0x9F, 0xFC, 0x1B, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0xEC, 0x9F, 0xFC, 0x1B, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '8'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x1F, 0x00, 0x00,
+    0xF0, 0x3F, 0x00, 0x00, 0xF0, 0x3F, 0x00, 0x00, 0xEC, 0x9F, 0x00, 0x18, 0x1E, 0xC0, 0x01, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C, 0x1E, 0xE0, 0x03, 0x3C,
+    0x1E, 0xC0, 0x01, 0x3C, 0xEC, 0x9F, 0xFC, 0x1B, 0xF0, 0x3F, 0xFE, 0x07, 0xF0, 0x3F, 0xFE, 0x07,
+    0xE0, 0x1F, 0xFC, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '9'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x0F, 0xF0, 0x00,
+    0x00, 0x0F, 0xF0, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ':'
+};
+
+const ssd1306_font_t ssd1306_font_digits_24x32 = {font_digits_24x32, 24, 4, '-', ':'};
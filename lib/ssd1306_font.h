@@ -0,0 +1,23 @@
+#ifndef SSD1306_FONT_H
+#define SSD1306_FONT_H
+
+#include <stdint.h>
+
+// Fonte monoespaçada no layout de páginas do SSD1306: cada glifo tem 'width'
+// colunas, da esquerda para a direita, e cada coluna tem 'pages' bytes, da página de
+// cima para a de baixo (bit 0 = linha de cima). Uma coluna do glifo é, portanto,
+// exatamente o que a RAM do display guarda para aquela coluna no endereçamento
+// vertical. As tabelas maiores são geradas por host/gerar_fontes.c.
+typedef struct {
+  const uint8_t *data;
+  uint8_t width;  // colunas por glifo, com o espaçamento
+  uint8_t pages;  // altura em páginas de 8 linhas
+  char first;     // caracteres fora de [first, last] saem em branco
+  char last;
+} ssd1306_font_t;
+
+extern const ssd1306_font_t ssd1306_font_8x8;          // font.h, ' ' a '~'
+extern const ssd1306_font_t ssd1306_font_16x16;        // 8x8 ampliada 2x, ' ' a '~'
+extern const ssd1306_font_t ssd1306_font_digits_24x32; // sete segmentos: '-', '.', '0'-'9', ':'
+
+#endif // SSD1306_FONT_H
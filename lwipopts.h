@@ -21,6 +21,8 @@
 #define MEM_ALIGNMENT               4
 #define MEM_SIZE                    16000
 #define MEMP_NUM_TCP_SEG            64
+// HTTP_MAX_CONEXOES (16) + escuta + MQTT, com folga para conexões ainda em fechamento
+#define MEMP_NUM_TCP_PCB            24
 #define MEMP_NUM_ARP_QUEUE          10
 #define PBUF_POOL_SIZE              24
 #define LWIP_ARP                    1
@@ -35,9 +37,11 @@
 #define LWIP_NETIF_LINK_CALLBACK    1
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETCONN                0
-#define MEM_STATS                   0
+// Uso do heap e dos pools do lwIP exportado em /metrics (metricas.c)
+#define LWIP_STATS                  1
+#define MEM_STATS                   1
 #define SYS_STATS                   0
-#define MEMP_STATS                  0
+#define MEMP_STATS                  1
 #define LINK_STATS                  0
 // #define ETH_PAD_SIZE                2
 #define LWIP_CHKSUM_ALGORITHM       3
@@ -50,10 +54,17 @@
 #define LWIP_NETIF_TX_SINGLE_PBUF   1
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
+// SOF_REUSEADDR: o servidor HTTP volta a escutar na porta 80 depois de uma troca de IP
+// mesmo com conexões antigas em TIME_WAIT
+#define SO_REUSE                    1
+
+// Cliente MQTT (lwip/apps/mqtt): um timer extra e buffer para lotes de amostras
+#define MEMP_NUM_SYS_TIMEOUT        (LWIP_NUM_SYS_TIMEOUT_INTERNAL + 1)
+#define MQTT_OUTPUT_RINGBUF_SIZE    1024
+#define MQTT_REQ_MAX_IN_FLIGHT      5
 
 #ifndef NDEBUG
 #define LWIP_DEBUG                  1
-#define LWIP_STATS                  1
 #define LWIP_STATS_DISPLAY          1
 #endif
 
@@ -0,0 +1,153 @@
+#include "memoria.h"
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "servidor_http.h"
+
+// Limites das pilhas definidos pelo linker script do SDK (memmap_default.ld): a do
+// núcleo 0 fica em SCRATCH_Y e a do núcleo 1 (a de multicore_launch_core1) em SCRATCH_X
+extern uint32_t __StackBottom, __StackTop, __StackOneBottom, __StackOneTop;
+
+typedef struct
+{
+    uint32_t *base; // Palavra mais baixa (a pilha cresce para baixo)
+    uint32_t *topo;
+} pilha_t;
+
+static const pilha_t pilhas[MEMORIA_NUCLEOS] = {
+    {&__StackBottom, &__StackTop},
+    {&__StackOneBottom, &__StackOneTop},
+};
+
+static void pintar(uint32_t *de, uint32_t *ate)
+{
+    for (volatile uint32_t *p = de; p < ate; p++)
+    {
+        *p = MEMORIA_PINTURA;
+    }
+}
+
+void memoria_iniciar(void)
+{
+    // Do quadro atual para cima a pilha do núcleo 0 está em uso; abaixo dele, livre. O
+    // quadro de pintar() e os registradores que ela salva ficam logo abaixo de 'sp',
+    // então a pintura para MEMORIA_MARGEM_PILHA bytes antes para não sobrescrevê-los.
+    uint32_t *sp;
+    __asm volatile("mov %0, sp" : "=r"(sp));
+    pintar(pilhas[0].base, sp - MEMORIA_MARGEM_PILHA / sizeof(uint32_t));
+    pintar(pilhas[1].base, pilhas[1].topo);
+}
+
+uint32_t memoria_pilha_tamanho(int nucleo)
+{
+    return (uint32_t)((pilhas[nucleo].topo - pilhas[nucleo].base) * sizeof(uint32_t));
+}
+
+uint32_t memoria_pilha_maximo(int nucleo)
+{
+    const volatile uint32_t *p = pilhas[nucleo].base;
+    while (p < pilhas[nucleo].topo && *p == MEMORIA_PINTURA)
+    {
+        p++;
+    }
+    return (uint32_t)((pilhas[nucleo].topo - p) * sizeof(uint32_t));
+}
+
+// ============================================================================
+// === Exportação ===
+// Itens: uma pilha por item, heap do malloc, heap do lwIP, um pool por item e o fim
+
+#if MEMP_STATS
+static const char *const nomes_pools[MEMP_MAX] = {
+#define LWIP_MEMPOOL(nome, num, tam, desc) #nome,
+#include "lwip/priv/memp_std.h"
+};
+#define NUM_POOLS MEMP_MAX
+#else
+#define NUM_POOLS 0
+#endif
+
+static int gerar_pilha(int nucleo, char *buf, size_t tam)
+{
+    uint32_t tamanho = memoria_pilha_tamanho(nucleo);
+    uint32_t maximo = memoria_pilha_maximo(nucleo);
+    return snprintf(buf, tam, "%s{\"nucleo\":%d,\"tamanho\":%lu,\"maximo\":%lu,\"no_limite\":%s}%s",
+                    nucleo == 0 ? "{\"pilhas\":[" : ",", nucleo, (unsigned long)tamanho, (unsigned long)maximo,
+                    maximo >= tamanho ? "true" : "false", nucleo == MEMORIA_NUCLEOS - 1 ? "]" : "");
+}
+
+// 'reservado' é o que o malloc já tirou da região do heap (sbrk). O newlib só devolve
+// memória acima do limiar de trim, então esse valor funciona como o pico de uso.
+static int gerar_heap(char *buf, size_t tam)
+{
+    extern char __StackLimit, __bss_end__;
+    struct mallinfo info = mallinfo();
+    return snprintf(buf, tam, ",\"heap\":{\"usado\":%lu,\"reservado\":%lu,\"total\":%lu}",
+                    (unsigned long)info.uordblks, (unsigned long)info.arena,
+                    (unsigned long)(&__StackLimit - &__bss_end__));
+}
+
+static int gerar_lwip_heap(char *buf, size_t tam)
+{
+#if MEM_STATS
+    const struct stats_mem *s = &lwip_stats.mem;
+    return snprintf(buf, tam, ",\"lwip_heap\":{\"usado\":%lu,\"maximo\":%lu,\"total\":%lu,\"falhas\":%lu}",
+                    (unsigned long)s->used, (unsigned long)s->max, (unsigned long)s->avail, (unsigned long)s->err);
+#else
+    return snprintf(buf, tam, ",\"lwip_heap\":null");
+#endif
+}
+
+#if MEMP_STATS
+static int gerar_pool(int pool, char *buf, size_t tam)
+{
+    const struct stats_mem *s = lwip_stats.memp[pool];
+    return snprintf(buf, tam, "%s{\"nome\":\"%s\",\"usado\":%lu,\"maximo\":%lu,\"total\":%lu,\"falhas\":%lu}",
+                    pool == 0 ? "" : ",", nomes_pools[pool], (unsigned long)s->used, (unsigned long)s->max,
+                    (unsigned long)s->avail, (unsigned long)s->err);
+}
+#endif
+
+// Escreve o item 'item'. Retorna o tamanho ou -1 depois do último item.
+static int gerar_item(uint32_t item, char *buf, size_t tam)
+{
+    if (item < MEMORIA_NUCLEOS)
+    {
+        return gerar_pilha((int)item, buf, tam);
+    }
+    item -= MEMORIA_NUCLEOS;
+    if (item == 0)
+    {
+        return gerar_heap(buf, tam);
+    }
+    if (item == 1)
+    {
+        return gerar_lwip_heap(buf, tam);
+    }
+    if (item == 2)
+    {
+        return snprintf(buf, tam, ",\"lwip_pools\":[");
+    }
+    item -= 3;
+#if MEMP_STATS
+    if (item < NUM_POOLS)
+    {
+        return gerar_pool((int)item, buf, tam);
+    }
+#endif
+    if (item == NUM_POOLS)
+    {
+        return snprintf(buf, tam, "]}\n");
+    }
+    return -1;
+}
+
+size_t memoria_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    return http_gerar_itens(cursor, buf, tam, gerar_item);
+}
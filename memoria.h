@@ -0,0 +1,33 @@
+#ifndef MEMORIA_H // Previne múltiplas inclusões do cabeçalho
+#define MEMORIA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Marcas d'água de memória para GET /memoria: pilhas dos dois núcleos, heap do
+// malloc, heap e pools do lwIP.
+//
+// As pilhas são pintadas com MEMORIA_PINTURA no boot. O maior uso é a distância do
+// topo até a palavra pintada mais baixa que foi sobrescrita, e só cresce. A pilha do
+// núcleo 0 também é a das interrupções dele (callbacks do lwIP, botões), então a
+// marca cobre esses picos. Uma pilha usada até a última palavra aparece com
+// "no_limite": passou do fim ou chegou a ele, e o tamanho precisa crescer
+// (PICO_STACK_SIZE / PICO_CORE1_STACK_SIZE).
+
+#define MEMORIA_PINTURA 0xC5C5C5C5u // Valor das palavras ainda não usadas da pilha
+#define MEMORIA_NUCLEOS 2
+#define MEMORIA_MARGEM_PILHA 256   // Bytes abaixo do quadro de memoria_iniciar que não são pintados
+
+// Pinta as pilhas: a do núcleo 0 abaixo do quadro atual, menos MEMORIA_MARGEM_PILHA
+// (que já conta como usada), e a do núcleo 1 inteira.
+// Chamar no início do main, antes de multicore_launch_core1.
+void memoria_iniciar(void);
+
+// Tamanho e maior uso (bytes) da pilha do núcleo 0 ou 1
+uint32_t memoria_pilha_tamanho(int nucleo);
+uint32_t memoria_pilha_maximo(int nucleo);
+
+// Gerador do JSON de /memoria (http_gerador_t)
+size_t memoria_gerar(uint32_t *cursor, char *buf, size_t tam);
+
+#endif // MEMORIA_H
@@ -0,0 +1,477 @@
+#include "metricas.h"
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "agendador.h"
+#include "configuracao.h"
+#include "sensores.h"
+#include "supervisor.h"
+#include "rede.h"
+#include "i2c_bus.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "servidor_http.h"
+#include "telemetria_mqtt.h"
+
+// Histograma com buckets fixos. 'buckets' guarda a contagem de cada faixa;
+// a forma acumulada exigida pelo Prometheus é calculada só na exportação.
+typedef struct
+{
+    uint32_t buckets[METRICAS_NUM_LIMITES + 1];
+    uint32_t contagem;
+    uint64_t soma_us;
+} histograma_t;
+
+static const uint32_t limites_us[METRICAS_NUM_LIMITES] = METRICAS_LIMITES_US;
+static histograma_t histogramas[METRICA_NUM_LATENCIAS];
+static uint32_t contadores[METRICA_NUM_CONTADORES];
+
+// Valor do rótulo "operacao" de cada histograma
+static const char *const nomes_latencia[METRICA_NUM_LATENCIAS] = {
+    "bmp280_read_raw",
+    "aht20_read",
+    "display_pagina",
+    "ssd1306_envio",
+    "alertas_avaliar",
+    "alertas_saidas",
+    "http_recv",
+};
+
+// Família, rótulos e descrição de cada contador. Contadores da mesma família
+// precisam ficar em sequência para que HELP/TYPE saiam uma única vez.
+static const struct
+{
+    const char *familia;
+    const char *rotulos;
+    const char *ajuda;
+} descricao_contadores[METRICA_NUM_CONTADORES] = {
+    {"estacao_i2c_erros_total", "{sensor=\"bmp280\"}", "Transacoes I2C que falharam mesmo apos as retentativas"},
+    {"estacao_i2c_erros_total", "{sensor=\"aht20\"}", NULL},
+    {"estacao_i2c_retentativas_total", "{sensor=\"bmp280\"}", "Leituras I2C repetidas apos uma falha"},
+    {"estacao_i2c_retentativas_total", "{sensor=\"aht20\"}", NULL},
+    {"estacao_http_conexoes_total", "", "Conexoes HTTP aceitas"},
+    {"estacao_http_conexoes_recusadas_total", "", "Conexoes HTTP recusadas com 503 por falta de slot"},
+    {"estacao_http_requisicoes_total", "", "Requisicoes HTTP atendidas"},
+};
+
+// ============================================================================
+// === Medidores (valores lidos no momento da exportação) ===
+
+static uint32_t tempo_ativo_s(void)
+{
+    return to_ms_since_boot(get_absolute_time()) / 1000;
+}
+
+static uint32_t heap_usado(void)
+{
+    struct mallinfo info = mallinfo();
+    return (uint32_t)info.uordblks;
+}
+
+// Região entre o fim do .bss e o início da pilha, disponível para o malloc
+static uint32_t heap_total(void)
+{
+    extern char __StackLimit, __bss_end__;
+    return (uint32_t)(&__StackLimit - &__bss_end__);
+}
+
+static uint32_t conexoes_http(void)
+{
+    return (uint32_t)servidor_http_conexoes_ativas();
+}
+
+static uint32_t mqtt_conectado(void)
+{
+    return telemetria_mqtt_conectado();
+}
+
+static uint32_t partida_quente(void)
+{
+    return supervisor_partida_quente();
+}
+
+static uint32_t estado_wifi(void)
+{
+    return rede_estado();
+}
+
+#if MEM_STATS
+static uint32_t lwip_heap_usado(void)
+{
+    return lwip_stats.mem.used;
+}
+
+static uint32_t lwip_heap_maximo(void)
+{
+    return lwip_stats.mem.max;
+}
+#endif
+
+static const struct
+{
+    const char *nome;
+    const char *ajuda;
+    uint32_t (*valor)(void);
+} medidores[] = {
+    {"estacao_tempo_ativo_segundos", "Tempo desde o boot", tempo_ativo_s},
+    {"estacao_heap_usado_bytes", "Bytes alocados pelo malloc", heap_usado},
+    {"estacao_heap_total_bytes", "Tamanho da regiao de heap", heap_total},
+    {"estacao_http_conexoes_ativas", "Slots de conexao HTTP em uso", conexoes_http},
+    {"estacao_mqtt_conectado", "1 se ha sessao com o broker MQTT", mqtt_conectado},
+    {"estacao_configuracao_versao", "Versao da configuracao, muda a cada alteracao", configuracao_versao},
+    {"estacao_partida_quente", "1 se o boot retomou o estado retido apos um reset do watchdog", partida_quente},
+    {"estacao_partida_ms", "Tempo do reset ate o inicio das tarefas", supervisor_partida_ms},
+    {"estacao_reinicios_watchdog", "Resets do watchdog desde a ultima partida a frio", supervisor_reinicios},
+    {"estacao_wifi_estado", "0 desligada, 1 conectando, 2 conectada, 3 esperando nova tentativa", estado_wifi},
+    {"estacao_wifi_conexoes", "Vezes que o Wi-Fi conectou desde o boot", rede_conexoes},
+    {"estacao_wifi_falhas", "Tentativas de conexao Wi-Fi que falharam desde o boot", rede_falhas},
+    {"estacao_wifi_quedas", "Quedas do Wi-Fi depois de conectado desde o boot", rede_quedas},
+#if MEM_STATS
+    {"estacao_lwip_heap_usado_bytes", "Heap interno do lwIP em uso", lwip_heap_usado},
+    {"estacao_lwip_heap_maximo_bytes", "Maior uso do heap interno do lwIP", lwip_heap_maximo},
+#endif
+};
+
+#define NUM_MEDIDORES (sizeof(medidores) / sizeof(medidores[0]))
+
+// ============================================================================
+// === Pools do lwIP ===
+#if MEMP_STATS
+static const char *const nomes_pools[MEMP_MAX] = {
+#define LWIP_MEMPOOL(nome, num, tam, desc) #nome,
+#include "lwip/priv/memp_std.h"
+};
+
+// Uma família por campo, com uma linha por pool
+static const struct
+{
+    const char *nome;
+    const char *tipo;
+    const char *ajuda;
+} familias_pools[] = {
+    {"estacao_lwip_pool_usado", "gauge", "Elementos em uso no pool do lwIP"},
+    {"estacao_lwip_pool_maximo", "gauge", "Maior uso registrado no pool do lwIP"},
+    {"estacao_lwip_pool_falhas_total", "counter", "Alocacoes negadas por pool esgotado"},
+};
+#define NUM_ITENS_POOLS (3 * MEMP_MAX)
+#else
+#define NUM_ITENS_POOLS 0
+#endif
+
+// ============================================================================
+// === Tarefas do agendador ===
+// Uma família por estatística, com uma linha por tarefa registrada
+static const struct
+{
+    const char *nome;
+    const char *tipo;
+    const char *ajuda;
+} familias_tarefas[] = {
+    {"estacao_agendador_execucoes_total", "counter", "Execucoes da tarefa"},
+    {"estacao_agendador_prazos_perdidos_total", "counter", "Execucoes concluidas apos o prazo ou descartadas"},
+    {"estacao_agendador_maior_duracao_segundos", "gauge", "Maior duracao de uma execucao da tarefa"},
+};
+#define NUM_FAMILIAS_TAREFAS (sizeof(familias_tarefas) / sizeof(familias_tarefas[0]))
+
+// Tempo ocioso + uma linha por (família, tarefa)
+#define NUM_ITENS_AGENDADOR (1 + NUM_FAMILIAS_TAREFAS * AGENDADOR_MAX_TAREFAS)
+
+// ============================================================================
+// === Sensores do registro ===
+static const struct
+{
+    const char *nome;
+    const char *tipo;
+    const char *ajuda;
+} familias_sensores[] = {
+    {"estacao_sensor_leitura", "gauge", "Ultima leitura valida de cada canal, sem offset"},
+    {"estacao_sensor_falhas_total", "counter", "Transacoes que falharam mesmo apos as retentativas"},
+    {"estacao_sensor_saude", "gauge", "0 ok, 1 falhando, 2 suspenso em recuo"},
+};
+#define NUM_FAMILIAS_SENSORES (sizeof(familias_sensores) / sizeof(familias_sensores[0]))
+
+// Um item por (família, sensor); na leitura, o item tem uma linha por canal
+#define NUM_ITENS_SENSORES (NUM_FAMILIAS_SENSORES * SENSORES_MAX)
+
+// ============================================================================
+// === Barramentos I2C (lib/i2c_bus.h) ===
+// Uma família por estatística, com uma linha por porta
+#define NUM_PORTAS_I2C 2
+
+static const struct
+{
+    const char *nome;
+    const char *ajuda;
+} familias_i2c[] = {
+    {"estacao_i2c_timeouts_total", "Transacoes I2C que estouraram o tempo"},
+    {"estacao_i2c_recuperacoes_total", "Recuperacoes do barramento (pulsos de SCL e reinicio)"},
+    {"estacao_i2c_recuperacoes_falhas_total", "Recuperacoes apos as quais SDA ou SCL continuaram em baixo"},
+};
+#define NUM_ITENS_I2C (sizeof(familias_i2c) / sizeof(familias_i2c[0]) * NUM_PORTAS_I2C)
+
+// ============================================================================
+// === Coleta ===
+
+uint32_t metricas_inicio(void)
+{
+    return time_us_32();
+}
+
+void metricas_registrar(metrica_latencia_t metrica, uint32_t inicio)
+{
+    uint32_t duracao = time_us_32() - inicio;
+    histograma_t *h = &histogramas[metrica];
+
+    int b = 0;
+    while (b < METRICAS_NUM_LIMITES && duracao > limites_us[b])
+    {
+        b++;
+    }
+    h->buckets[b]++;
+    h->contagem++;
+    h->soma_us += duracao;
+}
+
+void metricas_contar(metrica_contador_t contador)
+{
+    contadores[contador]++;
+}
+
+// ============================================================================
+// === Exportação ===
+// O corpo é uma sequência de itens numerados; cada item tem no máximo algumas
+// linhas curtas, e o cursor do gerador é o número do próximo item.
+
+// Itens de um histograma: um por bucket (incluindo +Inf), soma e contagem
+#define ITENS_HISTOGRAMA (METRICAS_NUM_LIMITES + 3)
+
+static int gerar_contador(uint32_t i, char *buf, size_t tam)
+{
+    int n = 0;
+    if (descricao_contadores[i].ajuda)
+    {
+        n = snprintf(buf, tam, "# HELP %s %s\n# TYPE %s counter\n",
+                     descricao_contadores[i].familia, descricao_contadores[i].ajuda,
+                     descricao_contadores[i].familia);
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    return n + snprintf(buf + n, tam - (size_t)n, "%s%s %lu\n", descricao_contadores[i].familia,
+                        descricao_contadores[i].rotulos, (unsigned long)contadores[i]);
+}
+
+static int gerar_histograma(uint32_t i, char *buf, size_t tam)
+{
+    uint32_t indice = i / ITENS_HISTOGRAMA;
+    uint32_t item = i % ITENS_HISTOGRAMA;
+    const histograma_t *h = &histogramas[indice];
+    const char *operacao = nomes_latencia[indice];
+
+    int n = 0;
+    if (i == 0)
+    {
+        n = snprintf(buf, tam, "# HELP estacao_duracao_segundos Duracao das operacoes instrumentadas\n"
+                               "# TYPE estacao_duracao_segundos histogram\n");
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    buf += n;
+    tam -= (size_t)n;
+
+    if (item <= METRICAS_NUM_LIMITES)
+    {
+        uint32_t acumulado = 0;
+        for (uint32_t b = 0; b <= item; b++)
+        {
+            acumulado += h->buckets[b];
+        }
+        if (item == METRICAS_NUM_LIMITES)
+        {
+            return n + snprintf(buf, tam, "estacao_duracao_segundos_bucket{operacao=\"%s\",le=\"+Inf\"} %lu\n",
+                                operacao, (unsigned long)acumulado);
+        }
+        return n + snprintf(buf, tam, "estacao_duracao_segundos_bucket{operacao=\"%s\",le=\"%lu.%06lu\"} %lu\n",
+                            operacao, (unsigned long)(limites_us[item] / 1000000),
+                            (unsigned long)(limites_us[item] % 1000000), (unsigned long)acumulado);
+    }
+    if (item == METRICAS_NUM_LIMITES + 1)
+    {
+        uint64_t soma = h->soma_us;
+        return n + snprintf(buf, tam, "estacao_duracao_segundos_sum{operacao=\"%s\"} %lu.%06lu\n",
+                            operacao, (unsigned long)(soma / 1000000), (unsigned long)(soma % 1000000));
+    }
+    return n + snprintf(buf, tam, "estacao_duracao_segundos_count{operacao=\"%s\"} %lu\n",
+                        operacao, (unsigned long)h->contagem);
+}
+
+static int gerar_medidor(uint32_t i, char *buf, size_t tam)
+{
+    return snprintf(buf, tam, "# HELP %s %s\n# TYPE %s gauge\n%s %lu\n",
+                    medidores[i].nome, medidores[i].ajuda, medidores[i].nome,
+                    medidores[i].nome, (unsigned long)medidores[i].valor());
+}
+
+#if MEMP_STATS
+static int gerar_pool(uint32_t i, char *buf, size_t tam)
+{
+    uint32_t familia = i / MEMP_MAX;
+    uint32_t pool = i % MEMP_MAX;
+    const struct stats_mem *s = lwip_stats.memp[pool];
+    unsigned long valor = familia == 0 ? s->used : familia == 1 ? s->max : s->err;
+
+    int n = 0;
+    if (pool == 0)
+    {
+        n = snprintf(buf, tam, "# HELP %s %s\n# TYPE %s %s\n", familias_pools[familia].nome,
+                     familias_pools[familia].ajuda, familias_pools[familia].nome, familias_pools[familia].tipo);
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    return n + snprintf(buf + n, tam - (size_t)n, "%s{pool=\"%s\"} %lu\n",
+                        familias_pools[familia].nome, nomes_pools[pool], valor);
+}
+#endif
+
+static int gerar_agendador(uint32_t i, char *buf, size_t tam)
+{
+    if (i == 0)
+    {
+        uint64_t ocioso = agendador_ocioso_us();
+        return snprintf(buf, tam, "# HELP estacao_agendador_ocioso_segundos_total Tempo dormindo em __wfe\n"
+                                  "# TYPE estacao_agendador_ocioso_segundos_total counter\n"
+                                  "estacao_agendador_ocioso_segundos_total %lu.%06lu\n",
+                        (unsigned long)(ocioso / 1000000), (unsigned long)(ocioso % 1000000));
+    }
+
+    i--;
+    uint32_t familia = i / AGENDADOR_MAX_TAREFAS;
+    const agendador_tarefa_t *t = agendador_tarefa(i % AGENDADOR_MAX_TAREFAS);
+
+    int n = 0;
+    if (i % AGENDADOR_MAX_TAREFAS == 0)
+    {
+        n = snprintf(buf, tam, "# HELP %s %s\n# TYPE %s %s\n", familias_tarefas[familia].nome,
+                     familias_tarefas[familia].ajuda, familias_tarefas[familia].nome, familias_tarefas[familia].tipo);
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    if (!t)
+    {
+        return n; // posição sem tarefa registrada
+    }
+
+    buf += n;
+    tam -= (size_t)n;
+    if (familia == 2)
+    {
+        return n + snprintf(buf, tam, "%s{tarefa=\"%s\"} %lu.%06lu\n", familias_tarefas[familia].nome, t->nome,
+                            (unsigned long)(t->maior_duracao_us / 1000000),
+                            (unsigned long)(t->maior_duracao_us % 1000000));
+    }
+    return n + snprintf(buf, tam, "%s{tarefa=\"%s\"} %lu\n", familias_tarefas[familia].nome, t->nome,
+                        (unsigned long)(familia == 0 ? t->execucoes : t->prazos_perdidos));
+}
+
+static int gerar_sensor(uint32_t i, char *buf, size_t tam)
+{
+    uint32_t familia = i / SENSORES_MAX;
+    const sensor_t *s = sensores_obter((int)(i % SENSORES_MAX));
+
+    int n = 0;
+    if (i % SENSORES_MAX == 0)
+    {
+        n = snprintf(buf, tam, "# HELP %s %s\n# TYPE %s %s\n", familias_sensores[familia].nome,
+                     familias_sensores[familia].ajuda, familias_sensores[familia].nome, familias_sensores[familia].tipo);
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    if (!s)
+    {
+        return n; // posição sem sensor registrado
+    }
+
+    int indice = (int)(i % SENSORES_MAX);
+    if (familia >= 1)
+    {
+        unsigned long valor = familia == 1 ? (unsigned long)s->falhas : (unsigned long)s->saude;
+        return n + snprintf(buf + n, tam - (size_t)n, "%s{sensor=\"%d\",modelo=\"%s\"} %lu\n",
+                            familias_sensores[familia].nome, indice, s->driver->nome, valor);
+    }
+    for (int c = 0; c < s->driver->num_canais && (size_t)n < tam; c++)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "%s{sensor=\"%d\",modelo=\"%s\",grandeza=\"%s\"} %.2f\n",
+                      familias_sensores[familia].nome, indice, s->driver->nome,
+                      grandeza_nome(s->driver->grandezas[c]), s->valores[c]);
+    }
+    return n;
+}
+
+static int gerar_i2c(uint32_t i, char *buf, size_t tam)
+{
+    uint32_t familia = i / NUM_PORTAS_I2C;
+    uint32_t porta = i % NUM_PORTAS_I2C;
+    const i2c_bus_stats_t *e = i2c_bus_stats(porta == 0 ? i2c0 : i2c1);
+    uint32_t valor = familia == 0 ? e->timeouts : familia == 1 ? e->recoveries : e->failed_recoveries;
+
+    int n = 0;
+    if (porta == 0)
+    {
+        n = snprintf(buf, tam, "# HELP %s %s\n# TYPE %s counter\n", familias_i2c[familia].nome,
+                     familias_i2c[familia].ajuda, familias_i2c[familia].nome);
+        if (n < 0 || (size_t)n >= tam)
+        {
+            return (int)tam;
+        }
+    }
+    return n + snprintf(buf + n, tam - (size_t)n, "%s{porta=\"%lu\"} %lu\n", familias_i2c[familia].nome,
+                        (unsigned long)porta, (unsigned long)valor);
+}
+
+// Seções do corpo, na ordem de exportação
+static const struct
+{
+    int (*gerar)(uint32_t i, char *buf, size_t tam);
+    uint32_t itens;
+} secoes[] = {
+    {gerar_contador, METRICA_NUM_CONTADORES},
+    {gerar_histograma, METRICA_NUM_LATENCIAS * ITENS_HISTOGRAMA},
+    {gerar_medidor, NUM_MEDIDORES},
+    {gerar_agendador, NUM_ITENS_AGENDADOR},
+    {gerar_sensor, NUM_ITENS_SENSORES},
+    {gerar_i2c, NUM_ITENS_I2C},
+#if MEMP_STATS
+    {gerar_pool, NUM_ITENS_POOLS},
+#endif
+};
+
+// Escreve um item em 'buf'. Retorna o tamanho (>= tam se não coube) ou -1 se o cursor passou do fim.
+static int gerar_item(uint32_t item, char *buf, size_t tam)
+{
+    for (size_t s = 0; s < sizeof(secoes) / sizeof(secoes[0]); s++)
+    {
+        if (item < secoes[s].itens)
+        {
+            return secoes[s].gerar(item, buf, tam);
+        }
+        item -= secoes[s].itens;
+    }
+    return -1;
+}
+
+size_t metricas_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    return http_gerar_itens(cursor, buf, tam, gerar_item);
+}
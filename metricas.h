@@ -0,0 +1,59 @@
+#ifndef METRICAS_H // Previne múltiplas inclusões do cabeçalho
+#define METRICAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Contadores e histogramas de latência dos caminhos críticos, exportados em /metrics
+// no formato texto do Prometheus. Cada métrica tem um único escritor (laço principal
+// ou callbacks do lwIP), então a atualização é feita sem travas.
+
+// ============================================================================
+// === Histogramas de latência ===
+// Limites dos buckets em µs (o último bucket, +Inf, é implícito)
+#define METRICAS_LIMITES_US {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000}
+#define METRICAS_NUM_LIMITES 11
+
+typedef enum
+{
+    METRICA_BMP280_LEITURA,  // bmp280_read_raw
+    METRICA_AHT20_LEITURA,   // aht20_read
+    METRICA_DISPLAY_PAGINA,  // Desenho e envio da página do display
+    METRICA_DISPLAY_ENVIO,   // Só a transferência I2C (ssd1306_send_data/send_region)
+    METRICA_ALERTAS_AVALIAR, // alertas_avaliar: regras avaliadas a cada amostra
+    METRICA_ALERTAS_SAIDAS,  // monitorar_alertas: LEDs, matriz e buzzer
+    METRICA_HTTP_RECV,       // callback http_recv
+    METRICA_NUM_LATENCIAS
+} metrica_latencia_t;
+
+// ============================================================================
+// === Contadores ===
+typedef enum
+{
+    METRICA_I2C_ERROS_BMP280,
+    METRICA_I2C_ERROS_AHT20,
+    METRICA_I2C_RETENTATIVAS_BMP280,
+    METRICA_I2C_RETENTATIVAS_AHT20,
+    METRICA_HTTP_CONEXOES,  // conexões aceitas
+    METRICA_HTTP_RECUSADAS, // conexões recusadas com 503 (sem slot)
+    METRICA_HTTP_REQUISICOES,
+    METRICA_NUM_CONTADORES
+} metrica_contador_t;
+
+// ============================================================================
+// === API ===
+
+// Instante de início de uma medição (µs)
+uint32_t metricas_inicio(void);
+
+// Registra no histograma o tempo decorrido desde 'inicio'
+void metricas_registrar(metrica_latencia_t metrica, uint32_t inicio);
+
+// Incrementa um contador
+void metricas_contar(metrica_contador_t contador);
+
+// Gerador do corpo de /metrics (http_gerador_t): escreve as próximas linhas inteiras
+// que couberem em 'buf' e avança 'cursor'. Retorna 0 ao terminar.
+size_t metricas_gerar(uint32_t *cursor, char *buf, size_t tam);
+
+#endif // METRICAS_H
@@ -0,0 +1,371 @@
+#include "rajada.h"
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "pico/util/queue.h"
+#include "hardware/sync.h"
+#include "rastro.h"
+
+#if RAJADA_MAX_AMOSTRAS & (RAJADA_MAX_AMOSTRAS - 1)
+#error "RAJADA_MAX_AMOSTRAS precisa ser potência de 2"
+#endif
+
+// Cabeçalho seguido das amostras: a captura concluída é enviada direto desta memória.
+// Durante a amostragem, 'amostras' é um anel com o instante bruto (time_us_32).
+static struct
+{
+    uint8_t cabecalho[RAJADA_TAM_CABECALHO];
+    rajada_amostra_t amostras[RAJADA_MAX_AMOSTRAS];
+} blob;
+
+_Static_assert(sizeof(rajada_amostra_t) == RAJADA_TAM_AMOSTRA, "layout da amostra");
+_Static_assert(offsetof(__typeof__(blob), amostras) == RAJADA_TAM_CABECALHO, "blob sem preenchimento");
+
+// ============================================================================
+// === Pedidos (núcleo 0 -> núcleo 1) ===
+
+typedef enum
+{
+    PEDIDO_JANELA,
+    PEDIDO_ARMAR,
+    PEDIDO_DISPARAR,
+    PEDIDO_PARAR,
+} tipo_pedido_t;
+
+typedef struct
+{
+    tipo_pedido_t tipo;
+    int32_t limiar_pa_s;
+    uint32_t pre;
+    uint32_t pos;
+    uint32_t captura; // Número da nova captura (janela e armar)
+} pedido_t;
+
+// Fila com trava: cada pedido entra e sai inteiro, e comandos seguidos (armar e
+// disparar na mesma requisição pipelined) não se sobrescrevem
+static queue_t pedidos;
+static bool iniciada; // false sem BMP280 ligado direto: o núcleo 1 não roda
+
+// Captura em 'blob' e downloads que apontam para ela (só no contexto do lwIP). Uma
+// nova captura reescreve 'blob', então não começa enquanto houver downloads.
+static uint32_t capturas_pedidas;
+static volatile uint32_t captura_concluida; // Escrita pelo núcleo 1 em concluir()
+static uint16_t leitores;
+
+// Enfileira o pedido e acorda o núcleo 1 (que pode estar em __wfe). Retorna false se
+// a fila estiver cheia.
+static bool enviar_pedido(tipo_pedido_t tipo, int32_t limiar_pa_s, uint32_t pre, uint32_t pos)
+{
+    bool nova = tipo == PEDIDO_JANELA || tipo == PEDIDO_ARMAR;
+    if (!iniciada || (nova && leitores > 0))
+    {
+        return false;
+    }
+    pedido_t p = {tipo, limiar_pa_s, pre, pos, capturas_pedidas + 1};
+    if (!queue_try_add(&pedidos, &p))
+    {
+        return false;
+    }
+    if (nova)
+    {
+        capturas_pedidas++; // a captura concluída deixa de ser entregue a partir daqui
+    }
+    __sev();
+    return true;
+}
+
+static uint32_t ms_para_amostras(uint32_t ms)
+{
+    uint64_t n = (uint64_t)ms * 1000u / RAJADA_PERIODO_US;
+    return n > RAJADA_MAX_AMOSTRAS ? RAJADA_MAX_AMOSTRAS : (uint32_t)n;
+}
+
+bool rajada_janela(uint32_t janela_ms)
+{
+    uint32_t pos = ms_para_amostras(janela_ms);
+    return enviar_pedido(PEDIDO_JANELA, 0, 0, pos ? pos : 1);
+}
+
+bool rajada_armar(int32_t limiar_pa_s, uint32_t pre_ms, uint32_t pos_ms)
+{
+    uint32_t pos = ms_para_amostras(pos_ms);
+    pos = pos ? pos : 1;
+    uint32_t pre = ms_para_amostras(pre_ms);
+    pre = pre > RAJADA_MAX_AMOSTRAS - pos ? RAJADA_MAX_AMOSTRAS - pos : pre;
+    return enviar_pedido(PEDIDO_ARMAR, limiar_pa_s, pre, pos);
+}
+
+bool rajada_disparar(void)
+{
+    return enviar_pedido(PEDIDO_DISPARAR, 0, 0, 0);
+}
+
+bool rajada_parar(void)
+{
+    return enviar_pedido(PEDIDO_PARAR, 0, 0, 0);
+}
+
+// ============================================================================
+// === Amostragem (núcleo 1) ===
+
+static i2c_inst_t *barramento;
+static struct bmp280_calib_param *calibracao;
+static mutex_t *mutex_barramento;
+
+static volatile rajada_estado_t estado = RAJADA_PARADA;
+static rajada_cabecalho_t cabecalho;
+static uint32_t escritas;        // Amostras gravadas no anel desde o pedido
+static uint32_t indice_gatilho;  // Número da amostra do gatilho
+static uint32_t instante_gatilho; // time_us_32 da amostra do gatilho
+static uint32_t pre_pedido, pos_pedido;
+static uint8_t gatilho_pendente; // Motivo do gatilho a aplicar na próxima amostra (0xFF: nenhum)
+static uint32_t captura_atual;   // Número da captura em andamento
+static volatile uint32_t lacunas;
+
+static void configurar_sensor(uint8_t config, uint8_t ctrl_meas)
+{
+    mutex_enter_blocking(mutex_barramento);
+    bmp280_configure(barramento, config, ctrl_meas);
+    mutex_exit(mutex_barramento);
+}
+
+static void atender_pedido(const pedido_t *pedido)
+{
+    tipo_pedido_t tipo = pedido->tipo;
+
+    if (tipo == PEDIDO_DISPARAR)
+    {
+        if (estado == RAJADA_ARMADA)
+        {
+            gatilho_pendente = RAJADA_MOTIVO_MANUAL;
+        }
+        return;
+    }
+
+    if (tipo == PEDIDO_PARAR)
+    {
+        if (estado == RAJADA_ARMADA || estado == RAJADA_CAPTURANDO)
+        {
+            configurar_sensor(BMP280_CONFIG_DEFAULT, BMP280_CTRL_MEAS_DEFAULT);
+        }
+        estado = RAJADA_PARADA;
+        return;
+    }
+
+    // Nova captura: a anterior é descartada
+    escritas = 0;
+    lacunas = 0;
+    captura_atual = pedido->captura;
+    pre_pedido = pedido->pre;
+    pos_pedido = pedido->pos;
+    cabecalho.limiar_pa_s = tipo == PEDIDO_ARMAR ? pedido->limiar_pa_s : 0;
+    gatilho_pendente = tipo == PEDIDO_JANELA ? RAJADA_MOTIVO_JANELA : 0xFF;
+    configurar_sensor(BMP280_CONFIG_FAST, BMP280_CTRL_MEAS_FAST);
+    estado = RAJADA_ARMADA;
+}
+
+static void disparar_gatilho(uint8_t motivo, uint32_t instante, int32_t raw_temp)
+{
+    indice_gatilho = escritas - 1;
+    instante_gatilho = instante;
+    cabecalho.motivo = motivo;
+    cabecalho.gatilho_ms = to_ms_since_boot(get_absolute_time());
+    cabecalho.temperatura_cc = (int16_t)bmp280_convert_temp(raw_temp, calibracao);
+    estado = RAJADA_CAPTURANDO;
+    RASTRO_INSTANTE("rajada_gatilho");
+}
+
+// Variação de pressão (Pa/s) entre a amostra mais recente e a de RAJADA_JANELA_TAXA antes
+static int32_t taxa_variacao(void)
+{
+    const rajada_amostra_t *atual = &blob.amostras[(escritas - 1) % RAJADA_MAX_AMOSTRAS];
+    const rajada_amostra_t *antiga = &blob.amostras[(escritas - 1 - RAJADA_JANELA_TAXA) % RAJADA_MAX_AMOSTRAS];
+    uint32_t dt_us = (uint32_t)(atual->instante_us - antiga->instante_us);
+    if (dt_us == 0)
+    {
+        return 0;
+    }
+    int64_t dp = (int64_t)atual->pressao_pa - (int64_t)antiga->pressao_pa;
+    return (int32_t)(dp * 1000000 / dt_us);
+}
+
+// Inverte amostras[ini..fim)
+static void inverter(uint32_t ini, uint32_t fim)
+{
+    while (ini + 1 < fim)
+    {
+        rajada_amostra_t t = blob.amostras[ini];
+        blob.amostras[ini++] = blob.amostras[--fim];
+        blob.amostras[fim] = t;
+    }
+}
+
+// Desenrola o anel para que a captura fique contínua logo após o cabeçalho
+static void concluir(void)
+{
+    uint32_t pre = pre_pedido < indice_gatilho ? pre_pedido : indice_gatilho;
+    uint32_t inicio = indice_gatilho - pre;
+    uint32_t n = pre + pos_pedido;
+
+    // Rotação à esquerda por 'k' com três inversões, sem memória extra
+    uint32_t k = inicio % RAJADA_MAX_AMOSTRAS;
+    if (k)
+    {
+        inverter(0, k);
+        inverter(k, RAJADA_MAX_AMOSTRAS);
+        inverter(0, RAJADA_MAX_AMOSTRAS);
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        blob.amostras[i].instante_us = (int32_t)((uint32_t)blob.amostras[i].instante_us - instante_gatilho);
+    }
+
+    cabecalho.num_amostras = n;
+    cabecalho.pre_gatilho = pre;
+    cabecalho.periodo_us = RAJADA_PERIODO_US;
+    cabecalho.lacunas = lacunas > 0xFFFF ? 0xFFFF : (uint16_t)lacunas;
+    rajada_codificar_cabecalho(&cabecalho, blob.cabecalho);
+
+    configurar_sensor(BMP280_CONFIG_DEFAULT, BMP280_CTRL_MEAS_DEFAULT);
+    captura_concluida = captura_atual;
+    __dmb(); // captura completa antes de ser anunciada ao núcleo 0
+    estado = RAJADA_CONCLUIDA;
+}
+
+static void amostrar(void)
+{
+    int32_t raw_temp, raw_pressao;
+    mutex_enter_blocking(mutex_barramento);
+    bool ok = bmp280_read_raw(barramento, &raw_temp, &raw_pressao);
+    mutex_exit(mutex_barramento);
+    uint32_t agora = time_us_32();
+    if (!ok)
+    {
+        lacunas++;
+        return;
+    }
+
+    rajada_amostra_t *a = &blob.amostras[escritas % RAJADA_MAX_AMOSTRAS];
+    a->instante_us = (int32_t)agora;
+    a->pressao_pa = (uint32_t)bmp280_convert_pressure(raw_pressao, raw_temp, calibracao);
+    escritas++;
+
+    if (estado == RAJADA_ARMADA)
+    {
+        if (gatilho_pendente != 0xFF)
+        {
+            disparar_gatilho(gatilho_pendente, agora, raw_temp);
+            gatilho_pendente = 0xFF;
+        }
+        else if (cabecalho.limiar_pa_s > 0 && escritas > RAJADA_JANELA_TAXA)
+        {
+            int32_t taxa = taxa_variacao();
+            if (taxa >= cabecalho.limiar_pa_s || taxa <= -cabecalho.limiar_pa_s)
+            {
+                disparar_gatilho(RAJADA_MOTIVO_LIMIAR, agora, raw_temp);
+            }
+        }
+    }
+    if (estado == RAJADA_CAPTURANDO && escritas - indice_gatilho >= pos_pedido)
+    {
+        concluir();
+    }
+}
+
+// Laço do núcleo 1: dorme em __wfe enquanto parado e amostra a cada RAJADA_PERIODO_US
+static void nucleo1_rajada(void)
+{
+    absolute_time_t proxima = get_absolute_time();
+
+    while (true)
+    {
+        pedido_t pedido;
+        if (queue_try_remove(&pedidos, &pedido))
+        {
+            atender_pedido(&pedido);
+            proxima = get_absolute_time();
+            continue; // atende os demais pedidos antes de amostrar
+        }
+
+        if (estado != RAJADA_ARMADA && estado != RAJADA_CAPTURANDO)
+        {
+            __wfe(); // acordado por enviar_pedido
+            continue;
+        }
+
+        // Mantém a grade de amostragem; períodos perdidos (barramento ocupado pelo
+        // núcleo 0 além da conta) viram lacunas em vez de amostras em sequência
+        proxima = delayed_by_us(proxima, RAJADA_PERIODO_US);
+        int64_t atraso = absolute_time_diff_us(proxima, get_absolute_time());
+        if (atraso > 0)
+        {
+            uint32_t perdidos = (uint32_t)(atraso / RAJADA_PERIODO_US) + 1;
+            lacunas += perdidos;
+            proxima = delayed_by_us(proxima, (uint64_t)perdidos * RAJADA_PERIODO_US);
+        }
+        sleep_until(proxima);
+        amostrar();
+    }
+}
+
+void rajada_iniciar(i2c_inst_t *i2c, struct bmp280_calib_param *calib, mutex_t *mutex_i2c)
+{
+    barramento = i2c;
+    calibracao = calib;
+    mutex_barramento = mutex_i2c;
+    queue_init(&pedidos, sizeof(pedido_t), RAJADA_FILA_PEDIDOS);
+    iniciada = true;
+    multicore_launch_core1(nucleo1_rajada);
+}
+
+// ============================================================================
+// === Consulta (núcleo 0) ===
+
+rajada_estado_t rajada_estado(void)
+{
+    return estado;
+}
+
+// Captura concluída, se nenhuma outra foi pedida depois dela
+static const uint8_t *blob_concluido(size_t *tam)
+{
+    if (estado != RAJADA_CONCLUIDA || captura_concluida != capturas_pedidas)
+    {
+        return NULL;
+    }
+    __dmb(); // lê a captura só depois de ver o estado
+    *tam = RAJADA_TAM_CABECALHO + (size_t)rajada_ler32(blob.cabecalho + 4) * RAJADA_TAM_AMOSTRA;
+    return (const uint8_t *)&blob;
+}
+
+const uint8_t *rajada_blob_reservar(size_t *tam)
+{
+    const uint8_t *dados = blob_concluido(tam);
+    if (dados)
+    {
+        leitores++;
+    }
+    return dados;
+}
+
+void rajada_blob_soltar(void *ref)
+{
+    (void)ref;
+    leitores--;
+}
+
+int rajada_estado_json(char *buf, size_t tam)
+{
+    static const char *const nomes[] = {"parada", "armada", "capturando", "concluida"};
+    rajada_estado_t e = estado;
+    size_t tam_blob = 0;
+    blob_concluido(&tam_blob);
+
+    return snprintf(buf, tam,
+                    "{\"estado\":\"%s\",\"periodo_us\":%u,\"max_amostras\":%u,"
+                    "\"lacunas\":%lu,\"tam_blob\":%u}",
+                    nomes[e], (unsigned)RAJADA_PERIODO_US, (unsigned)RAJADA_MAX_AMOSTRAS,
+                    (unsigned long)lacunas, (unsigned)tam_blob);
+}
@@ -0,0 +1,73 @@
+#ifndef RAJADA_H // Previne múltiplas inclusões do cabeçalho
+#define RAJADA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/mutex.h"
+#include "hardware/i2c.h"
+#include "bmp280.h"
+#include "rajada_formato.h"
+
+// Captura em rajada da pressão do BMP280 para eventos rápidos (portas batendo,
+// surtos de ventilação, rajadas de vento). Roda no núcleo 1, com o sensor na taxa
+// máxima, gravando em um anel pré-alocado; a telemetria normal continua no núcleo 0
+// no seu ritmo, dividindo o barramento I2C pelo mutex passado em rajada_iniciar.
+//
+// Modos:
+//  - janela: captura RAJADA_PERIODO_US * n a partir do comando, sem histórico;
+//  - armada: amostra continuamente e dispara quando a variação de pressão, medida ao
+//    longo de RAJADA_JANELA_TAXA amostras, passa do limiar (ou por rajada_disparar).
+//    As 'pre' amostras anteriores ao gatilho vêm junto na captura.
+// Concluída, a captura fica disponível como um bloco binário (rajada_formato.h) até
+// o próximo comando de captura, e o BMP280 volta à configuração normal. O bloco é
+// enviado sem cópia: enquanto houver reservas (downloads em andamento), janela e
+// armar são recusados, porque a nova captura reescreveria o bloco.
+//
+// Os comandos só enfileiram o pedido e acordam o núcleo 1, então podem ser chamados
+// dos callbacks do lwIP. Retornam false se foram recusados (download em andamento ou
+// fila de RAJADA_FILA_PEDIDOS pedidos cheia). Supõe-se um único chamador (o servidor
+// HTTP), sempre no contexto do lwIP.
+
+#define RAJADA_MAX_AMOSTRAS 2048 // Potência de 2; 8 bytes cada (~20 s a 100 Hz)
+#define RAJADA_PERIODO_US 10000  // 100 Hz, dentro do tempo de medição do BMP280 em BMP280_CTRL_MEAS_FAST
+#define RAJADA_JANELA_TAXA 10    // Amostras entre os pontos comparados pelo gatilho (100 ms)
+#define RAJADA_FILA_PEDIDOS 8    // Comandos aguardando o núcleo 1
+
+typedef enum
+{
+    RAJADA_PARADA,
+    RAJADA_ARMADA,     // Amostrando, esperando o gatilho
+    RAJADA_CAPTURANDO, // Gatilho ocorreu, completando as amostras posteriores
+    RAJADA_CONCLUIDA,  // Captura pronta para download
+} rajada_estado_t;
+
+// Dispara o núcleo 1. 'calib' e 'mutex_i2c' precisam continuar válidos.
+void rajada_iniciar(i2c_inst_t *i2c, struct bmp280_calib_param *calib, mutex_t *mutex_i2c);
+
+// Captura 'janela_ms' a partir de agora
+bool rajada_janela(uint32_t janela_ms);
+
+// Arma o gatilho por variação: |dP/dt| >= limiar_pa_s (<= 0: só gatilho manual)
+bool rajada_armar(int32_t limiar_pa_s, uint32_t pre_ms, uint32_t pos_ms);
+
+// Força o gatilho de uma captura armada
+bool rajada_disparar(void);
+
+// Interrompe a amostragem e descarta a captura em andamento
+bool rajada_parar(void);
+
+rajada_estado_t rajada_estado(void);
+
+// Bloco binário da captura concluída (cabeçalho + amostras), ou NULL se não houver.
+// Cada bloco devolvido é uma reserva: o conteúdo não muda até rajada_blob_soltar.
+const uint8_t *rajada_blob_reservar(size_t *tam);
+
+// Devolve uma reserva. Tem a assinatura de http_liberar_t ('ref' não é usado).
+void rajada_blob_soltar(void *ref);
+
+// Estado em JSON para GET /rajada. Retorna o tamanho escrito.
+int rajada_estado_json(char *buf, size_t tam);
+
+#endif // RAJADA_H
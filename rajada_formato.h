@@ -0,0 +1,117 @@
+#ifndef RAJADA_FORMATO_H // Previne múltiplas inclusões do cabeçalho
+#define RAJADA_FORMATO_H
+
+// Formato binário da captura em rajada (GET /rajada.bin).
+// Compartilhado entre o firmware e o conversor no host (host/rajada_csv.c),
+// por isso usa apenas C padrão. Todos os campos são little-endian.
+//
+// Cabeçalho (28 bytes):
+//   0  u16 magico           'R','J' (0x4A52)
+//   2  u8  versao           RAJADA_VERSAO
+//   3  u8  motivo           RAJADA_MOTIVO_*
+//   4  u32 num_amostras     amostras que seguem o cabeçalho
+//   8  u32 pre_gatilho      índice da amostra do gatilho (= amostras anteriores a ele)
+//  12  u32 periodo_us       período nominal de amostragem
+//  16  u32 gatilho_ms       instante do gatilho, em ms desde o boot
+//  20  i32 limiar_pa_s      limiar de variação configurado (0 na captura por janela)
+//  24  i16 temperatura      centésimos de °C no gatilho
+//  26  u16 lacunas          períodos sem amostra (barramento ocupado ou atraso)
+// Amostras (8 bytes cada):
+//   0  i32 instante_us      relativo ao gatilho (negativo antes dele)
+//   4  u32 pressao          Pa
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RAJADA_MAGICO 0x4A52
+#define RAJADA_VERSAO 1
+#define RAJADA_TAM_CABECALHO 28
+#define RAJADA_TAM_AMOSTRA 8
+
+#define RAJADA_MOTIVO_JANELA 0 // Captura iniciada por comando, sem histórico
+#define RAJADA_MOTIVO_LIMIAR 1 // Variação de pressão acima do limiar
+#define RAJADA_MOTIVO_MANUAL 2 // Gatilho forçado enquanto armada
+
+typedef struct
+{
+    uint8_t motivo;
+    uint32_t num_amostras;
+    uint32_t pre_gatilho;
+    uint32_t periodo_us;
+    uint32_t gatilho_ms;
+    int32_t limiar_pa_s;
+    int16_t temperatura_cc;
+    uint16_t lacunas;
+} rajada_cabecalho_t;
+
+// Mesmo layout do formato em CPUs little-endian (RP2040 e x86), sem preenchimento
+typedef struct
+{
+    int32_t instante_us;
+    uint32_t pressao_pa;
+} rajada_amostra_t;
+
+static inline void rajada_escrever16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void rajada_escrever32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t rajada_ler16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rajada_ler32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void rajada_codificar_cabecalho(const rajada_cabecalho_t *c, uint8_t *buf)
+{
+    rajada_escrever16(buf + 0, RAJADA_MAGICO);
+    buf[2] = RAJADA_VERSAO;
+    buf[3] = c->motivo;
+    rajada_escrever32(buf + 4, c->num_amostras);
+    rajada_escrever32(buf + 8, c->pre_gatilho);
+    rajada_escrever32(buf + 12, c->periodo_us);
+    rajada_escrever32(buf + 16, c->gatilho_ms);
+    rajada_escrever32(buf + 20, (uint32_t)c->limiar_pa_s);
+    rajada_escrever16(buf + 24, (uint16_t)c->temperatura_cc);
+    rajada_escrever16(buf + 26, c->lacunas);
+}
+
+// Valida e decodifica o cabeçalho. Retorna false se o tamanho total não confere.
+static inline bool rajada_decodificar_cabecalho(const uint8_t *buf, size_t tam, rajada_cabecalho_t *c)
+{
+    if (tam < RAJADA_TAM_CABECALHO || rajada_ler16(buf) != RAJADA_MAGICO || buf[2] != RAJADA_VERSAO)
+    {
+        return false;
+    }
+    c->motivo = buf[3];
+    c->num_amostras = rajada_ler32(buf + 4);
+    c->pre_gatilho = rajada_ler32(buf + 8);
+    c->periodo_us = rajada_ler32(buf + 12);
+    c->gatilho_ms = rajada_ler32(buf + 16);
+    c->limiar_pa_s = (int32_t)rajada_ler32(buf + 20);
+    c->temperatura_cc = (int16_t)rajada_ler16(buf + 24);
+    c->lacunas = rajada_ler16(buf + 26);
+    return tam == RAJADA_TAM_CABECALHO + (size_t)c->num_amostras * RAJADA_TAM_AMOSTRA;
+}
+
+static inline void rajada_decodificar_amostra(const uint8_t *p, rajada_amostra_t *a)
+{
+    a->instante_us = (int32_t)rajada_ler32(p + 0);
+    a->pressao_pa = rajada_ler32(p + 4);
+}
+
+#endif // RAJADA_FORMATO_H
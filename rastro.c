@@ -0,0 +1,232 @@
+#include "rastro.h"
+
+#if RASTRO_HABILITADO
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#if PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#define RASTRO_NUM_NUCLEOS 2
+
+static inline uint64_t agora_us(void)
+{
+    return time_us_64();
+}
+
+static inline uint32_t nucleo_atual(void)
+{
+    return get_core_num();
+}
+
+static inline void publicar(void)
+{
+    __dmb(); // evento completo antes de avançar o contador de escrita
+}
+#else
+// Build no host: um único "núcleo", sem interrupções
+#include <time.h>
+
+#define RASTRO_NUM_NUCLEOS 1
+
+static inline uint64_t agora_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static inline uint32_t nucleo_atual(void)
+{
+    return 0;
+}
+
+static inline uint32_t save_and_disable_interrupts(void)
+{
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t estado)
+{
+    (void)estado;
+}
+
+static inline void publicar(void)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+#endif
+
+typedef struct
+{
+    uint64_t instante_us;
+    const char *nome;
+    uint8_t fase;
+} rastro_evento_t;
+
+// Anel de um núcleo. Só esse núcleo escreve nele; 'escrita' conta eventos desde o boot
+// e o evento de número 'seq' fica em eventos[seq % RASTRO_TAM_ANEL].
+typedef struct
+{
+    rastro_evento_t eventos[RASTRO_TAM_ANEL];
+    volatile uint32_t escrita;
+} rastro_anel_t;
+
+static rastro_anel_t aneis[RASTRO_NUM_NUCLEOS];
+
+// Cada núcleo grava no próprio anel, sem trava entre núcleos. As interrupções ficam
+// mascaradas só durante a gravação, para que um callback do lwIP no mesmo núcleo
+// não reserve a mesma posição.
+void rastro_registrar(const char *nome, rastro_fase_t fase)
+{
+    rastro_anel_t *anel = &aneis[nucleo_atual()];
+    uint64_t instante = agora_us();
+
+    uint32_t estado = save_and_disable_interrupts();
+    uint32_t seq = anel->escrita;
+    rastro_evento_t *e = &anel->eventos[seq % RASTRO_TAM_ANEL];
+    e->instante_us = instante;
+    e->nome = nome;
+    e->fase = (uint8_t)fase;
+    publicar();
+    anel->escrita = seq + 1;
+    restore_interrupts(estado);
+}
+
+// ============================================================================
+// === Exportação ===
+// O cursor guarda a etapa (2 bits), quantos eventos ainda faltam exportar do núcleo
+// atual (9 bits) e o número do próximo evento (21 bits; no cabeçalho, a parte).
+// Cada núcleo exporta só os eventos que existiam quando sua etapa começou, então a
+// exportação termina mesmo com a gravação continuando. A leitura não bloqueia a
+// gravação: eventos sobrescritos durante a exportação são pulados.
+
+#define ETAPA_CABECALHO 0
+#define ETAPA_FIM (RASTRO_NUM_NUCLEOS + 1)
+#define SEQ_MASCARA 0x1FFFFFu
+#define ETAPA(cursor) ((cursor) >> 30)
+#define RESTANTES(cursor) (((cursor) >> 21) & 0x1FFu)
+#define SEQ(cursor) ((cursor) & SEQ_MASCARA)
+#define CURSOR(etapa, restantes, seq) \
+    (((uint32_t)(etapa) << 30) | ((uint32_t)(restantes) << 21) | ((seq) & SEQ_MASCARA))
+
+#if RASTRO_TAM_ANEL > 0x1FF
+#error "RASTRO_TAM_ANEL maior que o contador de eventos do cursor"
+#endif
+
+// Início do JSON, em partes curtas para caber em qualquer buffer de exportação
+static const char *const cabecalho_json[] = {
+    "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[",
+    "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"estacao\"}},",
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"nucleo 0\"}},",
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"nucleo 1\"}}",
+};
+#define PARTES_CABECALHO (sizeof(cabecalho_json) / sizeof(cabecalho_json[0]))
+
+// Evento mais antigo ainda garantido no anel. Uma posição fica de margem porque
+// é a que o núcleo pode estar sobrescrevendo neste momento.
+static uint32_t seq_mais_antiga(uint32_t escrita)
+{
+    return escrita > RASTRO_TAM_ANEL - 1 ? escrita - (RASTRO_TAM_ANEL - 1) : 0;
+}
+
+// Cursor que começa a exportação do núcleo de índice 'nucleo' (ou o fim do JSON)
+static uint32_t inicio_etapa(uint32_t nucleo)
+{
+    if (nucleo >= RASTRO_NUM_NUCLEOS)
+    {
+        return CURSOR(ETAPA_FIM, 0, 0);
+    }
+    uint32_t escrita = aneis[nucleo].escrita;
+    uint32_t inicio = seq_mais_antiga(escrita);
+    return CURSOR(nucleo + 1, escrita - inicio, inicio);
+}
+
+// Escreve o item indicado pelo cursor e calcula o cursor seguinte.
+// Retorna o tamanho escrito (0 se o item não gera texto) ou -1 se a exportação terminou.
+static int gerar_item(uint32_t cursor, char *buf, size_t tam, uint32_t *proximo)
+{
+    uint32_t etapa = ETAPA(cursor);
+
+    if (etapa == ETAPA_CABECALHO)
+    {
+        uint32_t parte = SEQ(cursor);
+        *proximo = parte + 1 < PARTES_CABECALHO ? CURSOR(ETAPA_CABECALHO, 0, parte + 1) : inicio_etapa(0);
+        return snprintf(buf, tam, "%s", cabecalho_json[parte]);
+    }
+    if (etapa == ETAPA_FIM)
+    {
+        if (SEQ(cursor))
+        {
+            return -1;
+        }
+        *proximo = CURSOR(ETAPA_FIM, 0, 1);
+        return snprintf(buf, tam, "]}\n");
+    }
+
+    uint32_t nucleo = etapa - 1;
+    const rastro_anel_t *anel = &aneis[nucleo];
+    uint32_t escrita = anel->escrita;
+    uint32_t restantes = RESTANTES(cursor);
+
+    // Reconstrói o número completo do evento a partir dos bits do cursor
+    uint32_t seq = escrita - ((escrita - SEQ(cursor)) & SEQ_MASCARA);
+    if (restantes == 0 || seq == escrita)
+    {
+        *proximo = inicio_etapa(nucleo + 1); // núcleo exportado
+        return 0;
+    }
+    if (escrita - seq >= RASTRO_TAM_ANEL)
+    {
+        // Leitura ficou para trás: os eventos perdidos contam como exportados
+        uint32_t novo = seq_mais_antiga(escrita);
+        uint32_t perdidos = novo - seq;
+        *proximo = perdidos < restantes ? CURSOR(etapa, restantes - perdidos, novo) : inicio_etapa(nucleo + 1);
+        return 0;
+    }
+
+    rastro_evento_t e = anel->eventos[seq % RASTRO_TAM_ANEL];
+    *proximo = CURSOR(etapa, restantes - 1, seq + 1);
+    publicar();
+    if (anel->escrita - seq >= RASTRO_TAM_ANEL)
+    {
+        return 0; // sobrescrito enquanto era copiado
+    }
+
+    return snprintf(buf, tam, ",{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%lu%s}",
+                    e.nome, e.fase, (unsigned long long)e.instante_us, (unsigned long)nucleo,
+                    e.fase == RASTRO_FASE_INSTANTE ? ",\"s\":\"t\"" : "");
+}
+
+size_t rastro_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    size_t usado = 0;
+    while (usado < tam)
+    {
+        uint32_t proximo;
+        int n = gerar_item(*cursor, buf + usado, tam - usado, &proximo);
+        if (n < 0 || (size_t)n >= tam - usado)
+        {
+            break; // fim da exportação, ou o item fica para a próxima parte
+        }
+        usado += (size_t)n;
+        *cursor = proximo;
+    }
+    return usado;
+}
+
+void rastro_imprimir(void)
+{
+    char buf[256];
+    uint32_t cursor = 0;
+    size_t n;
+    while ((n = rastro_gerar(&cursor, buf, sizeof(buf))) > 0)
+    {
+        fwrite(buf, 1, n, stdout);
+    }
+    fflush(stdout);
+}
+
+#endif // RASTRO_HABILITADO
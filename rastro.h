@@ -0,0 +1,50 @@
+#ifndef RASTRO_H // Previne múltiplas inclusões do cabeçalho
+#define RASTRO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Rastro de eventos de início/fim com timestamps de time_us_64, gravados em um anel
+// por núcleo e exportados no formato JSON do Chrome (about:tracing / Perfetto).
+// Desligado por padrão: com RASTRO_HABILITADO = 0 as macros não geram código.
+// Para ligar: cmake -DRASTRO=ON (firmware) ou definir RASTRO_HABILITADO=1 no host.
+
+#ifndef RASTRO_HABILITADO
+#define RASTRO_HABILITADO 0
+#endif
+
+#define RASTRO_TAM_ANEL 256 // Eventos guardados por núcleo (os mais antigos são sobrescritos)
+
+// Fase do evento, com o mesmo caractere usado no campo "ph" do JSON
+typedef enum
+{
+    RASTRO_FASE_INICIO = 'B',
+    RASTRO_FASE_FIM = 'E',
+    RASTRO_FASE_INSTANTE = 'i',
+} rastro_fase_t;
+
+#if RASTRO_HABILITADO
+
+// 'nome' precisa ser uma string estática (só o ponteiro é guardado)
+#define RASTRO_INICIO(nome) rastro_registrar((nome), RASTRO_FASE_INICIO)
+#define RASTRO_FIM(nome) rastro_registrar((nome), RASTRO_FASE_FIM)
+#define RASTRO_INSTANTE(nome) rastro_registrar((nome), RASTRO_FASE_INSTANTE)
+
+// Grava um evento no anel do núcleo atual
+void rastro_registrar(const char *nome, rastro_fase_t fase);
+
+// Gerador do JSON (http_gerador_t): escreve os próximos eventos que couberem em 'buf'
+size_t rastro_gerar(uint32_t *cursor, char *buf, size_t tam);
+
+// Escreve o JSON completo na saída padrão (USB stdio no firmware)
+void rastro_imprimir(void);
+
+#else
+
+#define RASTRO_INICIO(nome) ((void)0)
+#define RASTRO_FIM(nome) ((void)0)
+#define RASTRO_INSTANTE(nome) ((void)0)
+
+#endif // RASTRO_HABILITADO
+
+#endif // RASTRO_H
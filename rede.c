@@ -0,0 +1,153 @@
+#include "rede.h"
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+
+static rede_estado_t estado = REDE_DESLIGADA;
+static const char *rede_ssid, *rede_senha;
+static rede_ip_t avisar_ip;
+
+static uint32_t ip_atual;
+static uint32_t inicio_ms;   // Início da tentativa (CONECTANDO) ou do recuo (ESPERANDO)
+static uint32_t recuo_ms;    // Recuo atual; 0 depois de uma conexão bem-sucedida
+static uint32_t conexoes, falhas, quedas;
+
+static uint32_t agora_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static void mudar_ip(uint32_t ip)
+{
+    if (ip == ip_atual)
+    {
+        return;
+    }
+    ip_atual = ip;
+    if (avisar_ip)
+    {
+        avisar_ip(ip);
+    }
+}
+
+static void esperar(void)
+{
+    falhas++;
+    recuo_ms = recuo_ms == 0 ? REDE_RECUO_MIN_MS : (recuo_ms * 2 > REDE_RECUO_MAX_MS ? REDE_RECUO_MAX_MS : recuo_ms * 2);
+    estado = REDE_ESPERANDO;
+    inicio_ms = agora_ms();
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA); // Abandona a tentativa em andamento
+}
+
+static void tentar(void)
+{
+    estado = REDE_CONECTANDO;
+    inicio_ms = agora_ms();
+    if (cyw43_arch_wifi_connect_async(rede_ssid, rede_senha, CYW43_AUTH_WPA2_AES_PSK) != 0)
+    {
+        esperar(); // A tentativa nem começou
+    }
+}
+
+bool rede_iniciar(const char *ssid, const char *senha, rede_ip_t ao_mudar_ip)
+{
+    rede_ssid = ssid;
+    rede_senha = senha;
+    avisar_ip = ao_mudar_ip;
+
+    if (cyw43_arch_init())
+    {
+        printf("Wi-Fi: driver nao iniciou, estacao sem rede\n");
+        estado = REDE_DESLIGADA;
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+    tentar();
+    return true;
+}
+
+void rede_processar(void)
+{
+    if (estado == REDE_DESLIGADA)
+    {
+        return;
+    }
+
+    int enlace = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    uint32_t agora = agora_ms();
+
+    switch (estado)
+    {
+    case REDE_CONECTANDO:
+        if (enlace == CYW43_LINK_UP)
+        {
+            estado = REDE_CONECTADA;
+            recuo_ms = 0;
+            conexoes++;
+            mudar_ip(cyw43_state.netif[CYW43_ITF_STA].ip_addr.addr);
+        }
+        else if (enlace < 0 || agora - inicio_ms >= REDE_PRAZO_CONEXAO_MS)
+        {
+            // CYW43_LINK_FAIL, _NONET ou _BADAUTH, ou associado sem IP por tempo demais
+            esperar();
+        }
+        break;
+
+    case REDE_CONECTADA:
+        if (enlace != CYW43_LINK_UP)
+        {
+            // Reconecta na hora; o recuo só cresce se as tentativas seguintes falharem
+            quedas++;
+            mudar_ip(0);
+            tentar();
+        }
+        else
+        {
+            mudar_ip(cyw43_state.netif[CYW43_ITF_STA].ip_addr.addr); // Renovação do DHCP
+        }
+        break;
+
+    case REDE_ESPERANDO:
+        if (agora - inicio_ms >= recuo_ms)
+        {
+            tentar();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+rede_estado_t rede_estado(void)
+{
+    return estado;
+}
+
+const char *rede_estado_nome(rede_estado_t e)
+{
+    static const char *const nomes[] = {"desligada", "conectando", "conectada", "esperando"};
+    return nomes[e];
+}
+
+uint32_t rede_ip(void)
+{
+    return ip_atual;
+}
+
+uint32_t rede_conexoes(void)
+{
+    return conexoes;
+}
+
+uint32_t rede_falhas(void)
+{
+    return falhas;
+}
+
+uint32_t rede_quedas(void)
+{
+    return quedas;
+}
@@ -0,0 +1,51 @@
+#ifndef REDE_H // Previne múltiplas inclusões do cabeçalho
+#define REDE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gerenciador da conexão Wi-Fi, sem bloqueio. rede_processar é chamada pela tarefa de
+// manutenção, consulta o estado do enlace no driver CYW43 e:
+//  - enquanto conecta, espera o enlace subir com IP (até REDE_PRAZO_CONEXAO_MS);
+//  - numa falha (AP ausente, senha errada, prazo estourado), espera um recuo que
+//    dobra a cada falha seguida, de REDE_RECUO_MIN_MS até REDE_RECUO_MAX_MS;
+//  - conectada, percebe a queda do enlace e a troca de IP (DHCP).
+// Toda mudança de IP (inclusive a perda, com ip = 0) é avisada pela callback, que a
+// aplicação usa para reabrir o servidor HTTP e atualizar o display. O resto da estação
+// roda igual com ou sem rede.
+//
+// No host, o driver é substituído por um enlace simulado (host/shim/pico/cyw43_arch.h)
+// e host/simular_rede.c percorre as transições.
+
+#define REDE_PRAZO_CONEXAO_MS 15000 // Tentativa sem IP depois disso conta como falha
+#define REDE_RECUO_MIN_MS 1000
+#define REDE_RECUO_MAX_MS 60000
+
+typedef enum
+{
+    REDE_DESLIGADA,  // Driver não iniciou: a estação segue sem rede
+    REDE_CONECTANDO, // Tentativa em andamento
+    REDE_CONECTADA,  // Enlace de pé e com IP
+    REDE_ESPERANDO,  // Recuo antes da próxima tentativa
+} rede_estado_t;
+
+// IP novo, em ordem de rede (como no lwIP), ou 0 quando a conexão cai
+typedef void (*rede_ip_t)(uint32_t ip);
+
+// Liga o driver em modo estação e dispara a primeira tentativa. Retorna false (estado
+// REDE_DESLIGADA) se o driver não iniciar. 'ssid' e 'senha' precisam continuar válidos.
+bool rede_iniciar(const char *ssid, const char *senha, rede_ip_t ao_mudar_ip);
+
+// Avança a máquina de estados; barata quando nada muda
+void rede_processar(void);
+
+rede_estado_t rede_estado(void);
+const char *rede_estado_nome(rede_estado_t estado);
+uint32_t rede_ip(void); // 0 se não conectada
+
+// Estatísticas desde o boot
+uint32_t rede_conexoes(void); // Vezes que o enlace subiu com IP
+uint32_t rede_falhas(void);   // Tentativas que não conectaram
+uint32_t rede_quedas(void);   // Enlaces que caíram depois de conectados
+
+#endif // REDE_H
@@ -0,0 +1,473 @@
+#include "sensores.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "rastro.h"
+#include "i2c_bus.h"
+#include "sensores_drivers.h"
+#include "servidor_http.h"
+
+// ============================================================================
+// === Drivers ===
+// As funções de cada modelo estão em sensores_drivers.cpp
+
+const sensor_driver_t SENSOR_BMP280 = {
+    .nome = "bmp280",
+    .endereco = 0x76,
+    .num_canais = 2,
+    .grandezas = {GRANDEZA_TEMPERATURA, GRANDEZA_PRESSAO},
+    .metrica_leitura = METRICA_BMP280_LEITURA,
+    .metrica_erros = METRICA_I2C_ERROS_BMP280,
+    .metrica_retentativas = METRICA_I2C_RETENTATIVAS_BMP280,
+    .sondar = sensores_bmp280_sondar,
+    .disparar = NULL,
+    .coletar = sensores_bmp280_coletar,
+    .converter = sensores_bmp280_converter,
+};
+
+// A conversão leva ~80 ms; disparada numa aquisição, é coletada na seguinte
+const sensor_driver_t SENSOR_AHT20 = {
+    .nome = "aht20",
+    .endereco = AHT20_I2C_ADDR,
+    .num_canais = 2,
+    .grandezas = {GRANDEZA_TEMPERATURA, GRANDEZA_UMIDADE},
+    .metrica_leitura = METRICA_AHT20_LEITURA,
+    .metrica_erros = METRICA_I2C_ERROS_AHT20,
+    .metrica_retentativas = METRICA_I2C_RETENTATIVAS_AHT20,
+    .sondar = sensores_aht20_sondar,
+    .disparar = sensores_aht20_disparar,
+    .coletar = sensores_aht20_coletar,
+    .converter = sensores_aht20_converter,
+};
+
+// Modelos procurados na varredura; a ordem define a ordem dos sensores
+static const sensor_driver_t *const drivers[] = {&SENSOR_BMP280, &SENSOR_AHT20};
+#define NUM_DRIVERS (sizeof(drivers) / sizeof(drivers[0]))
+
+// ============================================================================
+// === Registro ===
+
+typedef struct
+{
+    i2c_inst_t *i2c;
+    uint8_t endereco;
+    uint8_t selecao; // Último valor escrito no registrador de controle
+} mux_t;
+
+static sensor_t sensores[SENSORES_MAX];
+static int num_sensores;
+static mux_t muxes[2 * SENSORES_MAX_MUX]; // Duas portas I2C no RP2040
+static int num_muxes;
+static mutex_t *mutex;
+
+static bool escrever_mux(mux_t *m, uint8_t selecao)
+{
+    if (i2c_bus_write(m->i2c, m->endereco, &selecao, 1, false) != 1)
+    {
+        return false;
+    }
+    m->selecao = selecao;
+    return true;
+}
+
+// Deixa aberto só o canal do sensor (ou nenhum, se ele for direto) entre os
+// multiplexadores da sua porta. Só escreve nos que mudam.
+static bool selecionar(const sensor_t *s)
+{
+    bool ok = true;
+    for (int i = 0; i < num_muxes; i++)
+    {
+        mux_t *m = &muxes[i];
+        if (m->i2c != s->i2c)
+        {
+            continue;
+        }
+        uint8_t selecao = m->endereco == s->mux ? (uint8_t)(1u << s->canal_mux) : 0;
+        if (m->selecao != selecao)
+        {
+            ok = escrever_mux(m, selecao) && ok;
+        }
+    }
+    return ok;
+}
+
+static bool presente(i2c_inst_t *i2c, uint8_t endereco)
+{
+    uint8_t lixo;
+    return i2c_read_timeout_us(i2c, endereco, &lixo, 1, false, SENSORES_SONDA_US) == 1;
+}
+
+// O TCA9548A devolve na leitura o que foi escrito no controle; outro dispositivo na
+// mesma faixa de endereços dificilmente repete o padrão. Sai com todos os canais fechados.
+static bool eh_mux(i2c_inst_t *i2c, uint8_t endereco)
+{
+    const uint8_t padrao = 0xA5;
+    uint8_t lido = 0;
+    if (i2c_write_timeout_us(i2c, endereco, &padrao, 1, false, SENSORES_SONDA_US) != 1 ||
+        i2c_read_timeout_us(i2c, endereco, &lido, 1, false, SENSORES_SONDA_US) != 1)
+    {
+        return false;
+    }
+    const uint8_t fechado = 0;
+    i2c_write_timeout_us(i2c, endereco, &fechado, 1, false, SENSORES_SONDA_US);
+    return lido == padrao;
+}
+
+// Endereço já ocupado por um dispositivo ligado direto na porta
+static bool ocupado_direto(i2c_inst_t *i2c, uint8_t endereco)
+{
+    for (int i = 0; i < num_sensores; i++)
+    {
+        if (sensores[i].i2c == i2c && sensores[i].mux == SENSOR_SEM_MUX && sensores[i].driver->endereco == endereco)
+        {
+            return true;
+        }
+    }
+    for (int i = 0; i < num_muxes; i++)
+    {
+        if (muxes[i].i2c == i2c && muxes[i].endereco == endereco)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Procura cada modelo na posição atual (porta e canal já selecionados)
+static void registrar(i2c_inst_t *i2c, uint8_t mux, uint8_t canal)
+{
+    for (size_t d = 0; d < NUM_DRIVERS && num_sensores < SENSORES_MAX; d++)
+    {
+        const sensor_driver_t *driver = drivers[d];
+        if ((mux != SENSOR_SEM_MUX && ocupado_direto(i2c, driver->endereco)) || !presente(i2c, driver->endereco))
+        {
+            continue;
+        }
+
+        sensor_t *s = &sensores[num_sensores];
+        memset(s, 0, sizeof(*s));
+        s->driver = driver;
+        s->i2c = i2c;
+        s->mux = mux;
+        s->canal_mux = canal;
+        if (!driver->sondar(s))
+        {
+            continue;
+        }
+        s->principal = sensores_buscar(driver, false) == NULL;
+        num_sensores++;
+        printf("Sensor %s na porta %u", driver->nome, i2c_hw_index(i2c));
+        if (mux != SENSOR_SEM_MUX)
+        {
+            printf(", mux 0x%02x canal %u", mux, canal);
+        }
+        printf("\n");
+    }
+}
+
+int sensores_iniciar(i2c_inst_t *const *portas, int num_portas, mutex_t *mutex_i2c)
+{
+    mutex = mutex_i2c;
+    mutex_enter_blocking(mutex);
+
+    for (int p = 0; p < num_portas; p++)
+    {
+        i2c_inst_t *i2c = portas[p];
+
+        // Multiplexadores primeiro, para a varredura direta não ver canais que
+        // ficaram abertos de antes de um reset
+        int muxes_porta = 0;
+        for (uint8_t e = 0; e < TCA9548A_NUM_ENDERECOS && muxes_porta < SENSORES_MAX_MUX; e++)
+        {
+            uint8_t endereco = TCA9548A_ENDERECO_BASE + e;
+            if (num_muxes < (int)(sizeof(muxes) / sizeof(muxes[0])) && eh_mux(i2c, endereco))
+            {
+                muxes[num_muxes++] = (mux_t){.i2c = i2c, .endereco = endereco, .selecao = 0};
+                muxes_porta++;
+            }
+        }
+
+        registrar(i2c, SENSOR_SEM_MUX, 0);
+
+        for (int i = 0; i < num_muxes; i++)
+        {
+            if (muxes[i].i2c != i2c)
+            {
+                continue;
+            }
+            for (uint8_t canal = 0; canal < TCA9548A_NUM_CANAIS; canal++)
+            {
+                if (escrever_mux(&muxes[i], (uint8_t)(1u << canal)))
+                {
+                    registrar(i2c, muxes[i].endereco, canal);
+                }
+            }
+            escrever_mux(&muxes[i], 0);
+        }
+    }
+
+    mutex_exit(mutex);
+    return num_sensores;
+}
+
+// ============================================================================
+// === Aquisição ===
+
+// Coleta com retentativa; tempo de cada tentativa, retentativas e falhas vão para as métricas
+static bool coletar(sensor_t *s)
+{
+    const sensor_driver_t *d = s->driver;
+    for (int tentativa = 0; tentativa < SENSORES_TENTATIVAS; tentativa++)
+    {
+        if (tentativa > 0)
+        {
+            metricas_contar(d->metrica_retentativas);
+        }
+        RASTRO_INICIO(d->nome);
+        uint32_t inicio = metricas_inicio();
+        bool ok = d->coletar(s);
+        metricas_registrar(d->metrica_leitura, inicio);
+        RASTRO_FIM(d->nome);
+        if (ok)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Falha de coleta, disparo ou seleção do canal. A partir de SENSORES_FALHAS_SUSPENSAO
+// seguidas, suspende o sensor com recuo exponencial: 1, 2, 4... aquisições.
+static void registrar_falha(sensor_t *s)
+{
+    s->falhas++;
+    metricas_contar(s->driver->metrica_erros);
+    if (s->falhas_seguidas < UINT8_MAX)
+    {
+        s->falhas_seguidas++;
+    }
+    if (s->falhas_seguidas < SENSORES_FALHAS_SUSPENSAO)
+    {
+        s->saude = SENSOR_FALHANDO;
+        return;
+    }
+
+    s->recuo = s->recuo == 0 ? 1 : (s->recuo * 2 > SENSORES_RECUO_MAX ? SENSORES_RECUO_MAX : s->recuo * 2);
+    s->espera = s->recuo;
+    s->saude = SENSOR_SUSPENSO;
+    s->pendente = false;
+}
+
+static void registrar_sucesso(sensor_t *s)
+{
+    s->falhas_seguidas = 0;
+    s->recuo = 0;
+    s->saude = SENSOR_OK;
+}
+
+void sensores_coletar(void)
+{
+    for (int i = 0; i < num_sensores; i++)
+    {
+        sensor_t *s = &sensores[i];
+        const sensor_driver_t *d = s->driver;
+
+        // Suspenso: nem reserva o barramento até o fim do recuo
+        if (s->espera > 0)
+        {
+            s->espera--;
+            continue;
+        }
+
+        // Seleção do canal e transações do sensor sem a captura em rajada no meio
+        mutex_enter_blocking(mutex);
+        bool selecionado = selecionar(s);
+
+        // Fim do recuo: o dispositivo pode ter reiniciado, então passa pela sonda de
+        // novo. Se responder, fica em observação: a próxima falha já o suspende de novo,
+        // com o recuo dobrado.
+        if (s->saude == SENSOR_SUSPENSO)
+        {
+            if (!(selecionado && d->sondar(s)))
+            {
+                s->valido = false;
+                registrar_falha(s);
+                mutex_exit(mutex);
+                continue;
+            }
+            s->saude = SENSOR_FALHANDO;
+        }
+
+        // Sem medição pendente (início, falha ao disparar ou volta da suspensão) não há
+        // o que coletar. Uma falha conta uma vez por aquisição, na coleta ou no disparo.
+        bool esperado = selecionado && (s->pendente || !d->disparar);
+        bool falhou = !selecionado || (esperado && !coletar(s));
+        s->valido = esperado && !falhou;
+        if (s->valido)
+        {
+            d->converter(s, s->valores);
+        }
+
+        if (d->disparar)
+        {
+            s->pendente = selecionado && d->disparar(s);
+            falhou = falhou || !s->pendente;
+        }
+
+        if (falhou)
+        {
+            registrar_falha(s);
+        }
+        else if (s->valido)
+        {
+            registrar_sucesso(s);
+        }
+        mutex_exit(mutex);
+    }
+}
+
+int sensores_quantidade(void)
+{
+    return num_sensores;
+}
+
+const sensor_t *sensores_obter(int indice)
+{
+    return indice >= 0 && indice < num_sensores ? &sensores[indice] : NULL;
+}
+
+sensor_t *sensores_buscar(const sensor_driver_t *driver, bool direto)
+{
+    for (int i = 0; i < num_sensores; i++)
+    {
+        if (sensores[i].driver == driver && (!direto || sensores[i].mux == SENSOR_SEM_MUX))
+        {
+            return &sensores[i];
+        }
+    }
+    return NULL;
+}
+
+bool sensores_valor(grandeza_t grandeza, float *valor)
+{
+    float soma = 0.0f, soma_validos[2] = {0.0f, 0.0f};
+    int n = 0, validos[2] = {0, 0}; // [0] principais, [1] secundários
+
+    for (int i = 0; i < num_sensores; i++)
+    {
+        const sensor_t *s = &sensores[i];
+        int grupo = s->principal ? 0 : 1;
+        for (int c = 0; c < s->driver->num_canais; c++)
+        {
+            if (s->driver->grandezas[c] != grandeza)
+            {
+                continue;
+            }
+            if (s->principal)
+            {
+                soma += s->valores[c];
+                n++;
+            }
+            if (s->valido)
+            {
+                soma_validos[grupo] += s->valores[c];
+                validos[grupo]++;
+            }
+        }
+    }
+
+    for (int grupo = 0; grupo < 2; grupo++)
+    {
+        if (validos[grupo] > 0)
+        {
+            *valor = soma_validos[grupo] / validos[grupo];
+            return true;
+        }
+    }
+    *valor = n > 0 ? soma / n : 0.0f;
+    return false;
+}
+
+amostra_t sensores_amostra(const configuracao_t *config, uint32_t instante_ms)
+{
+    float temperatura, pressao, umidade;
+    bool temperatura_ok = sensores_valor(GRANDEZA_TEMPERATURA, &temperatura);
+    bool pressao_ok = sensores_valor(GRANDEZA_PRESSAO, &pressao);
+    bool umidade_ok = sensores_valor(GRANDEZA_UMIDADE, &umidade);
+
+    // Calibração em vários pontos sobre a leitura, e o offset por cima
+    const calibracao_t *cal = config->calibracao;
+
+    return (amostra_t){
+        .instante_ms = instante_ms,
+        .temperatura = calibracao_aplicar(&cal[GRANDEZA_TEMPERATURA], temperatura) + config->offset_temp,
+        .pressao = calibracao_aplicar(&cal[GRANDEZA_PRESSAO], pressao) + config->offset_pressao,
+        .umidade = umidade_ok ? calibracao_aplicar(&cal[GRANDEZA_UMIDADE], umidade) + config->offset_umidade
+                              : 0.0f, // 0 se erro no sensor
+        .temperatura_valida = temperatura_ok,
+        .umidade_valida = umidade_ok,
+        .pressao_valida = pressao_ok,
+    };
+}
+
+const char *sensores_saude_nome(sensor_saude_t saude)
+{
+    static const char *const nomes[] = {"ok", "falhando", "suspenso"};
+    return nomes[saude];
+}
+
+// ============================================================================
+// === Exportação ===
+// Itens: "[", um sensor por item e "]"
+
+static int gerar_sensor(int i, char *buf, size_t tam)
+{
+    const sensor_t *s = &sensores[i];
+    char mux[8] = "null";
+    if (s->mux != SENSOR_SEM_MUX)
+    {
+        snprintf(mux, sizeof(mux), "\"0x%02x\"", s->mux);
+    }
+
+    int n = snprintf(buf, tam,
+                     "%s{\"indice\":%d,\"modelo\":\"%s\",\"porta\":%u,\"mux\":%s,\"canal\":%u,\"endereco\":\"0x%02x\","
+                     "\"principal\":%s,\"valido\":%s,\"saude\":\"%s\",\"falhas\":%lu,\"leituras\":{",
+                     i == 0 ? "" : ",", i, s->driver->nome, i2c_hw_index(s->i2c), mux, s->canal_mux,
+                     s->driver->endereco, s->principal ? "true" : "false", s->valido ? "true" : "false",
+                     sensores_saude_nome(s->saude), (unsigned long)s->falhas);
+    for (int c = 0; c < s->driver->num_canais && n >= 0 && (size_t)n < tam; c++)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "%s\"%s\":%.2f", c == 0 ? "" : ",",
+                      grandeza_nome(s->driver->grandezas[c]), s->valores[c]);
+    }
+    if (n >= 0 && (size_t)n < tam)
+    {
+        n += snprintf(buf + n, tam - (size_t)n, "}}");
+    }
+    return n;
+}
+
+// Escreve o item 'item'. Retorna o tamanho ou -1 depois do último item.
+static int gerar_item(uint32_t item, char *buf, size_t tam)
+{
+    if (item == 0)
+    {
+        return snprintf(buf, tam, "[");
+    }
+    if (item > (uint32_t)num_sensores + 1)
+    {
+        return -1;
+    }
+    if (item == (uint32_t)num_sensores + 1)
+    {
+        return snprintf(buf, tam, "]\n");
+    }
+    return gerar_sensor((int)item - 1, buf, tam);
+}
+
+size_t sensores_gerar(uint32_t *cursor, char *buf, size_t tam)
+{
+    return http_gerar_itens(cursor, buf, tam, gerar_item);
+}
@@ -0,0 +1,153 @@
+#ifndef SENSORES_H // Previne múltiplas inclusões do cabeçalho
+#define SENSORES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/mutex.h"
+#include "hardware/i2c.h"
+#include "amostra.h"
+#include "configuracao.h"
+#include "metricas.h"
+#include "bmp280.h"
+#include "aht20.h"
+
+// Registro dos sensores da estação. No boot, sensores_iniciar varre as portas I2C
+// recebidas e os canais de cada multiplexador TCA9548A encontrado, e cria um sensor
+// para cada dispositivo que um driver reconhece. Cada sensor publica um canal por
+// grandeza que mede (ex.: BMP280 interno e externo, AHT20 redundante).
+//
+// A aquisição é em duas etapas para todos os sensores: cada chamada a sensores_coletar
+// busca a medição disparada na chamada anterior e já dispara a próxima, então as
+// conversões correm em paralelo entre os períodos e o custo cresce linearmente com o
+// número de sensores, sem esperas com o barramento ocupado.
+//
+// O primeiro sensor de cada modelo é o "principal": a amostra da estação (amostra_t,
+// /estado, MQTT, UDP, alertas) usa a média dos canais principais válidos de cada
+// grandeza, como antes com um BMP280 e um AHT20. Os demais aparecem em GET /sensores
+// e em /metrics. Sensores atrás de um multiplexador não podem repetir o endereço de
+// um dispositivo ligado direto na mesma porta.
+//
+// Cada sensor tem um estado de saúde. Depois de SENSORES_FALHAS_SUSPENSAO falhas
+// seguidas ele é suspenso: fica fora do barramento por um recuo que dobra a cada
+// nova falha (até SENSORES_RECUO_MAX aquisições) e, ao fim do recuo, passa de novo
+// pela sonda do driver, porque o dispositivo pode ter reiniciado. Enquanto isso a
+// estação segue com os demais: se nenhum sensor principal de uma grandeza estiver
+// válido, sensores_valor usa os secundários válidos. As transações em si têm tempo
+// limitado e recuperam o barramento quando ele trava (lib/i2c_bus.h).
+
+#define SENSORES_MAX 8           // Sensores registrados
+#define SENSORES_MAX_MUX 2       // TCA9548A por porta
+#define SENSOR_MAX_CANAIS 2      // Grandezas por sensor
+#define SENSOR_SEM_MUX 0         // Valor de 'mux' para sensor ligado direto na porta
+#define SENSORES_TENTATIVAS 2    // Tentativas por coleta antes de contar como erro
+#define SENSORES_SONDA_US 2000   // Timeout da sonda de presença no boot
+#define SENSORES_FALHAS_SUSPENSAO 3 // Falhas seguidas até suspender o sensor
+#define SENSORES_RECUO_MAX 64    // Aquisições sem tentar, no máximo, um sensor suspenso (32 s)
+
+// Multiplexador I2C TCA9548A: endereços 0x70-0x77, um registrador de controle
+// com um bit por canal
+#define TCA9548A_ENDERECO_BASE 0x70
+#define TCA9548A_NUM_ENDERECOS 8
+#define TCA9548A_NUM_CANAIS 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sensor sensor_t;
+
+typedef enum
+{
+    SENSOR_OK,
+    SENSOR_FALHANDO, // Falhou na última tentativa, ainda tentado a cada aquisição
+    SENSOR_SUSPENSO, // Em recuo depois de falhas seguidas
+} sensor_saude_t;
+
+// Driver de um modelo de sensor. As funções recebem o barramento já reservado e o
+// canal do multiplexador já selecionado.
+typedef struct
+{
+    const char *nome;
+    uint8_t endereco; // Endereço I2C (fixo nos drivers de lib/)
+    uint8_t num_canais;
+    grandeza_t grandezas[SENSOR_MAX_CANAIS];
+    metrica_latencia_t metrica_leitura;
+    metrica_contador_t metrica_erros;
+    metrica_contador_t metrica_retentativas;
+
+    bool (*sondar)(sensor_t *s);                   // Confirma o modelo e inicializa
+    bool (*disparar)(sensor_t *s);                 // Inicia uma medição (NULL: mede sozinho)
+    bool (*coletar)(sensor_t *s);                  // Lê o resultado bruto
+    void (*converter)(sensor_t *s, float *valores); // Bruto -> unidades de amostra_t
+} sensor_driver_t;
+
+struct sensor
+{
+    const sensor_driver_t *driver;
+    i2c_inst_t *i2c;
+    uint8_t mux;       // Endereço do TCA9548A, ou SENSOR_SEM_MUX
+    uint8_t canal_mux;
+    bool principal;    // Primeiro do modelo: entra na amostra da estação
+    bool pendente;     // Medição disparada esperando a coleta
+    bool valido;       // Resultado da última coleta
+    uint32_t falhas;   // Transações que falharam mesmo após as retentativas
+    sensor_saude_t saude;
+    uint8_t falhas_seguidas;
+    uint16_t recuo;    // Aquisições puladas na suspensão atual
+    uint16_t espera;   // Aquisições que ainda faltam para a próxima tentativa
+    float valores[SENSOR_MAX_CANAIS]; // Última leitura válida de cada canal
+
+    // Estado bruto de cada driver
+    union
+    {
+        struct
+        {
+            struct bmp280_calib_param calib;
+            uint8_t calibracao[NUM_CALIB_PARAMS]; // Registradores 0x88..0x9F, como lidos
+            uint8_t medicao[6];                   // Registradores 0xF7..0xFC da última coleta
+        } bmp280;
+        struct
+        {
+            uint8_t quadro[6]; // Status + 20 bits de umidade + 20 bits de temperatura
+        } aht20;
+    } bruto;
+};
+
+extern const sensor_driver_t SENSOR_BMP280;
+extern const sensor_driver_t SENSOR_AHT20;
+
+// Varre 'portas' (já inicializadas) e registra os sensores. O barramento é reservado
+// por 'mutex_i2c' em cada acesso. Retorna quantos sensores foram encontrados.
+int sensores_iniciar(i2c_inst_t *const *portas, int num_portas, mutex_t *mutex_i2c);
+
+// Coleta a medição pendente de cada sensor e dispara a próxima
+void sensores_coletar(void);
+
+int sensores_quantidade(void);
+const sensor_t *sensores_obter(int indice);
+
+// Primeiro sensor do modelo; com 'direto', só entre os ligados sem multiplexador.
+// NULL se não houver.
+sensor_t *sensores_buscar(const sensor_driver_t *driver, bool direto);
+
+// Média da grandeza nos sensores principais válidos; sem nenhum, nos secundários
+// válidos. Sem nenhum válido, devolve a média das últimas leituras dos principais e
+// retorna false.
+bool sensores_valor(grandeza_t grandeza, float *valor);
+
+// Amostra da estação: sensores_valor de cada grandeza com os offsets de 'config'.
+// Sem AHT20 válido a umidade vai zerada; a temperatura e a pressão ficam nas últimas leituras.
+amostra_t sensores_amostra(const configuracao_t *config, uint32_t instante_ms);
+
+const char *sensores_saude_nome(sensor_saude_t saude);
+
+// Gerador da lista de sensores em JSON (http_gerador_t)
+size_t sensores_gerar(uint32_t *cursor, char *buf, size_t tam);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSORES_H
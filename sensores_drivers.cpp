@@ -0,0 +1,68 @@
+#include "sensores_drivers.h"
+
+#include "barramento_pico.hpp"
+#include "bmp280.hpp"
+#include "aht20.hpp"
+
+// A porta do sensor só é conhecida na varredura, então cada função escolhe entre as
+// duas especializações; dentro de cada uma, endereço e registradores são constantes.
+using Bmp280Porta0 = Bmp280<BarramentoPico<0>>;
+using Bmp280Porta1 = Bmp280<BarramentoPico<1>>;
+using Aht20Porta0 = Aht20<BarramentoPico<0>>;
+using Aht20Porta1 = Aht20<BarramentoPico<1>>;
+
+static bool porta0(const sensor_t *s)
+{
+    return i2c_hw_index(s->i2c) == 0;
+}
+
+bool sensores_bmp280_sondar(sensor_t *s)
+{
+    auto &b = s->bruto.bmp280;
+    if (porta0(s))
+    {
+        return Bmp280Porta0::verificar() && Bmp280Porta0::iniciar() && Bmp280Porta0::ler_calibracao(b.calib, b.calibracao);
+    }
+    return Bmp280Porta1::verificar() && Bmp280Porta1::iniciar() && Bmp280Porta1::ler_calibracao(b.calib, b.calibracao);
+}
+
+// Modo normal: o BMP280 mede sozinho, a coleta só lê o último resultado. Os
+// registradores ficam crus em 'bruto' (gravacao.h) e só são decodificados na conversão.
+bool sensores_bmp280_coletar(sensor_t *s)
+{
+    auto &medicao = s->bruto.bmp280.medicao;
+    return porta0(s) ? Bmp280Porta0::ler_medicao(medicao) : Bmp280Porta1::ler_medicao(medicao);
+}
+
+void sensores_bmp280_converter(sensor_t *s, float *valores)
+{
+    const auto &b = s->bruto.bmp280;
+    int32_t temp = bmp280::temperatura_bruta(b.medicao);
+    int32_t pressao = bmp280::pressao_bruta(b.medicao);
+    valores[0] = bmp280::converter_temperatura(temp, b.calib) / 100.0f;      // centésimos de °C -> °C
+    valores[1] = bmp280::converter_pressao(pressao, temp, b.calib) / 100.0f; // Pa -> hPa
+}
+
+bool sensores_aht20_sondar(sensor_t *s)
+{
+    return porta0(s) ? Aht20Porta0::verificar() && Aht20Porta0::iniciar()
+                     : Aht20Porta1::verificar() && Aht20Porta1::iniciar();
+}
+
+bool sensores_aht20_disparar(sensor_t *s)
+{
+    return porta0(s) ? Aht20Porta0::disparar() : Aht20Porta1::disparar();
+}
+
+bool sensores_aht20_coletar(sensor_t *s)
+{
+    auto &quadro = s->bruto.aht20.quadro;
+    return porta0(s) ? Aht20Porta0::coletar(quadro) : Aht20Porta1::coletar(quadro);
+}
+
+void sensores_aht20_converter(sensor_t *s, float *valores)
+{
+    AHT20_Data dados = aht20::converter(s->bruto.aht20.quadro);
+    valores[0] = dados.temperature;
+    valores[1] = dados.humidity;
+}
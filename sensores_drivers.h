@@ -0,0 +1,27 @@
+#ifndef SENSORES_DRIVERS_H // Previne múltiplas inclusões do cabeçalho
+#define SENSORES_DRIVERS_H
+
+#include <stdbool.h>
+
+#include "sensores.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Funções dos drivers do registro (sensor_driver_t), implementadas em
+// sensores_drivers.cpp sobre os drivers especializados de lib/bmp280.hpp e lib/aht20.hpp
+bool sensores_bmp280_sondar(sensor_t *s);
+bool sensores_bmp280_coletar(sensor_t *s);
+void sensores_bmp280_converter(sensor_t *s, float *valores);
+
+bool sensores_aht20_sondar(sensor_t *s);
+bool sensores_aht20_disparar(sensor_t *s);
+bool sensores_aht20_coletar(sensor_t *s);
+void sensores_aht20_converter(sensor_t *s, float *valores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSORES_DRIVERS_H
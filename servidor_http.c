@@ -0,0 +1,861 @@
+#include "servidor_http.h"
+#include "http_requisicao.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "metricas.h"
+#include "rastro.h"
+
+// Estado de uma conexão HTTP. Sobrevive entre requisições enquanto a conexão
+// estiver aberta (keep-alive) e guarda o que já chegou do cliente, permitindo
+// reunir requisições fragmentadas e atender várias enviadas em sequência (pipelining).
+typedef struct
+{
+    struct tcp_pcb *pcb;               // NULL quando o slot está livre
+    char req[HTTP_TAM_REQUISICAO + 1]; // bytes recebidos e ainda não processados (+1 para '\0')
+    size_t req_len;                    // quantidade de bytes válidos em 'req'
+    struct pbuf *resto;                // recebido que ainda não coube em 'req' (janela fechada)
+    uint16_t atendidas;                // requisições já respondidas nesta conexão
+    uint32_t ultimo_ms;                // instante da última atividade (para timeout ocioso)
+    bool fechar;                       // encerra a conexão ao terminar a resposta atual
+    bool cliente_encerrou;             // cliente enviou FIN; responde o que falta e fecha
+    bool http10;                       // requisição atual é HTTP/1.0 (sem chunked)
+
+    // Resposta em andamento
+    bool respondendo;                  // ainda há bytes da resposta a entregar ao TCP
+    char cabecalho[HTTP_TAM_CABECALHO];
+    size_t tam_cabecalho;
+    const char *corpo;
+    size_t tam_corpo;
+    bool copiar_corpo;                 // corpo dinâmico precisa ser copiado pelo lwIP
+    size_t enfileirado;                // bytes (cabeçalho + corpo) já entregues ao tcp_write
+    http_gerador_t gerador;            // corpo gerado em partes (NULL quando terminou)
+    uint32_t cursor_gerador;
+    bool fragmentado;                  // partes enviadas como chunks (Transfer-Encoding: chunked)
+    char dinamico[HTTP_TAM_CORPO_DINAMICO];
+
+    // Corpo compartilhado enviado sem cópia: o lwIP aponta para ele até o cliente confirmar
+    http_liberar_t liberar;            // NULL quando a conexão não segura nenhum
+    void *ref;
+    uint32_t nao_confirmados;          // bytes entregues ao tcp_write e ainda não confirmados
+} http_conexao_t;
+
+// Conexão já fechada cujo corpo compartilhado ainda não foi todo confirmado. O slot
+// volta para a tabela na hora; o PCB fica com este registro até a confirmação (ou o
+// fim da conexão), quando o corpo é solto.
+typedef struct
+{
+    struct tcp_pcb *pcb; // NULL quando o registro está livre
+    uint32_t nao_confirmados;
+    http_liberar_t liberar;
+    void *ref;
+} http_fechamento_t;
+
+// Tabela fixa de conexões: o consumo de RAM é conhecido em tempo de compilação
+static http_conexao_t conexoes[HTTP_MAX_CONEXOES];
+static http_fechamento_t fechamentos[HTTP_MAX_CONEXOES];
+
+// Próximo slot a ser servido na rodada (escalonamento circular entre conexões)
+static uint8_t proximo_slot;
+
+// Tratador de rotas registrado pela aplicação
+static http_tratador_t tratador_rotas;
+
+// PCB que escuta novas conexões e sua porta (para servidor_http_reiniciar)
+static struct tcp_pcb *pcb_escuta;
+static uint16_t porta_escuta;
+
+// Resposta enviada quando todos os slots estão ocupados com requisições em andamento
+static const char resposta_ocupado[] =
+    "HTTP/1.1 503 Service Unavailable\r\n"
+    "Content-Length: 0\r\n"
+    "Retry-After: 1\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+// Último chunk de um corpo gerado em partes
+static const char fim_fragmentado[] = "0\r\n\r\n";
+
+// Espaço reservado antes de cada parte para o tamanho do chunk ("XXX\r\n")
+#define HTTP_RESERVA_CHUNK 5
+
+// Código interno: a conexão foi fechada normalmente e seu slot liberado
+#define HTTP_CONEXAO_FECHADA ERR_CLSD
+
+static uint32_t agora_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+// Texto da linha de status para os códigos usados pelo servidor e pelas rotas
+static const char *texto_status(int status)
+{
+    switch (status)
+    {
+    case 200:
+        return "OK";
+    case 304:
+        return "Not Modified";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 409:
+        return "Conflict";
+    case 413:
+        return "Payload Too Large";
+    case 431:
+        return "Request Header Fields Too Large";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Error";
+    }
+}
+
+// Descarta o que a conexão ainda segurava do cliente
+static void descartar_resto(http_conexao_t *c)
+{
+    if (c->resto)
+    {
+        pbuf_free(c->resto);
+        c->resto = NULL;
+    }
+}
+
+// Passa para 'req' o quanto couber do pbuf guardado e reabre a janela só desses bytes.
+// O restante fica guardado até as requisições à frente serem atendidas.
+static void absorver_resto(http_conexao_t *c)
+{
+    size_t livre = HTTP_TAM_REQUISICAO - c->req_len;
+    if (!c->resto || livre == 0)
+    {
+        return;
+    }
+    u16_t n = c->resto->tot_len < livre ? c->resto->tot_len : (u16_t)livre;
+    pbuf_copy_partial(c->resto, c->req + c->req_len, n, 0);
+    c->req_len += n;
+    tcp_recved(c->pcb, n);
+    c->resto = pbuf_free_header(c->resto, n); // NULL quando copiou tudo
+}
+
+// Desassocia os callbacks do PCB e devolve o slot à tabela
+static void liberar_slot(http_conexao_t *c)
+{
+    struct tcp_pcb *pcb = c->pcb;
+    descartar_resto(c);
+
+    tcp_arg(pcb, NULL);
+    tcp_recv(pcb, NULL);
+    tcp_sent(pcb, NULL);
+    tcp_poll(pcb, NULL, 0);
+    tcp_err(pcb, NULL);
+    c->pcb = NULL;
+}
+
+// Devolve o corpo compartilhado que a conexão segurava
+static void soltar_corpo(http_conexao_t *c)
+{
+    if (c->liberar)
+    {
+        c->liberar(c->ref);
+        c->liberar = NULL;
+    }
+}
+
+// Solta o corpo compartilhado de uma conexão fechada e devolve o registro
+static void encerrar_fechamento(http_fechamento_t *f)
+{
+    f->liberar(f->ref);
+    f->pcb = NULL;
+}
+
+// Cliente confirmou dados de uma conexão já fechada
+static err_t fechamento_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+    http_fechamento_t *f = (http_fechamento_t *)arg;
+    f->nao_confirmados -= len < f->nao_confirmados ? len : f->nao_confirmados;
+    if (f->nao_confirmados == 0)
+    {
+        tcp_arg(tpcb, NULL);
+        tcp_sent(tpcb, NULL);
+        tcp_err(tpcb, NULL);
+        encerrar_fechamento(f);
+    }
+    return ERR_OK;
+}
+
+// Conexão já fechada terminou antes da confirmação (RST, tempo esgotado)
+static void fechamento_erro(void *arg, err_t err)
+{
+    (void)err;
+    encerrar_fechamento((http_fechamento_t *)arg);
+}
+
+// Aborta a conexão (RST). O chamador deve devolver ERR_ABRT ao lwIP se o PCB for o do callback.
+static err_t abortar_conexao(http_conexao_t *c)
+{
+    struct tcp_pcb *pcb = c->pcb;
+    liberar_slot(c);
+    tcp_abort(pcb); // descarta os segmentos: ninguém mais aponta para o corpo compartilhado
+    soltar_corpo(c);
+    return ERR_ABRT;
+}
+
+// Libera o slot e fecha a conexão TCP; os dados já enfileirados ainda são enviados.
+// Um corpo compartilhado ainda não confirmado passa para um registro de fechamento.
+static err_t fechar_conexao(http_conexao_t *c)
+{
+    struct tcp_pcb *pcb = c->pcb;
+    http_fechamento_t *f = NULL;
+    if (c->liberar && c->nao_confirmados > 0)
+    {
+        for (int i = 0; i < HTTP_MAX_CONEXOES && !f; i++)
+        {
+            f = fechamentos[i].pcb ? NULL : &fechamentos[i];
+        }
+        if (!f)
+        {
+            return abortar_conexao(c); // Sem registro livre não haveria como soltar o corpo
+        }
+    }
+    liberar_slot(c);
+
+    if (tcp_close(pcb) != ERR_OK)
+    {
+        // Sem memória para o FIN: aborta para não vazar o PCB
+        tcp_abort(pcb);
+        soltar_corpo(c);
+        return ERR_ABRT;
+    }
+    if (f)
+    {
+        *f = (http_fechamento_t){pcb, c->nao_confirmados, c->liberar, c->ref};
+        c->liberar = NULL;
+        tcp_arg(pcb, f);
+        tcp_sent(pcb, fechamento_sent);
+        tcp_err(pcb, fechamento_erro);
+    }
+    soltar_corpo(c);
+    return HTTP_CONEXAO_FECHADA;
+}
+
+// Converte o código interno para o valor esperado pelos callbacks do lwIP
+static err_t retorno_callback(err_t err)
+{
+    return err == HTTP_CONEXAO_FECHADA ? ERR_OK : err;
+}
+
+// Prepara cabeçalho e corpo da resposta a partir do que o tratador preencheu
+static void preparar_resposta(http_conexao_t *c, const http_resposta_t *resp)
+{
+    char conexao[64];
+    if (c->fechar)
+    {
+        snprintf(conexao, sizeof(conexao), "Connection: close\r\n");
+    }
+    else
+    {
+        snprintf(conexao, sizeof(conexao), "Connection: keep-alive\r\nKeep-Alive: timeout=%d, max=%d\r\n",
+                 HTTP_TIMEOUT_OCIOSO_MS / 1000, HTTP_MAX_REQ_POR_CONEXAO - c->atendidas);
+    }
+
+    // Corpo gerado em partes não tem tamanho conhecido: vai em chunks ou até o fechamento
+    char tamanho[40] = "";
+    c->gerador = resp->gerador;
+    c->cursor_gerador = 0;
+    c->fragmentado = resp->gerador && !c->http10;
+    if (c->fragmentado)
+    {
+        snprintf(tamanho, sizeof(tamanho), "Transfer-Encoding: chunked\r\n");
+    }
+    else if (!resp->gerador && resp->status != 304)
+    {
+        snprintf(tamanho, sizeof(tamanho), "Content-Length: %u\r\n", (unsigned)resp->tam_corpo);
+    }
+
+    int tam = snprintf(c->cabecalho, sizeof(c->cabecalho),
+                       "HTTP/1.1 %d %s\r\n"
+                       "Content-Type: %s\r\n"
+                       "%s"
+                       "%s"
+                       "%s"
+                       "\r\n",
+                       resp->status, texto_status(resp->status),
+                       resp->tipo,
+                       tamanho,
+                       conexao,
+                       resp->cabecalhos ? resp->cabecalhos : "");
+    c->tam_cabecalho = (tam > 0 && (size_t)tam < sizeof(c->cabecalho)) ? (size_t)tam : 0;
+
+    c->corpo = resp->gerador ? c->dinamico : resp->corpo;
+    c->tam_corpo = resp->gerador ? 0 : resp->tam_corpo;
+    if (resp->liberar && !c->liberar)
+    {
+        c->liberar = resp->liberar;
+        c->ref = resp->ref;
+    }
+    else if (resp->liberar)
+    {
+        // Só uma referência por conexão, e a anterior ainda espera confirmação
+        memcpy(c->dinamico, resp->corpo, c->tam_corpo);
+        c->corpo = c->dinamico;
+        resp->liberar(resp->ref);
+    }
+    c->copiar_corpo = c->corpo == c->dinamico;
+    c->enfileirado = 0;
+    c->respondendo = true;
+}
+
+// Produz a próxima parte de um corpo gerado no buffer dinâmico da conexão.
+// Chamado quando tudo o que havia antes (cabeçalho e parte anterior) já foi entregue ao TCP.
+// Retorna false se o gerador falhou.
+static bool gerar_parte(http_conexao_t *c)
+{
+    char *dados = c->dinamico + HTTP_RESERVA_CHUNK;
+    size_t n = c->gerador(&c->cursor_gerador, dados, HTTP_TAM_CORPO_DINAMICO - HTTP_RESERVA_CHUNK - 2);
+    if (n == HTTP_GERADOR_ERRO)
+    {
+        return false;
+    }
+
+    c->tam_cabecalho = 0; // o cabeçalho já foi enviado
+    c->enfileirado = 0;
+    c->copiar_corpo = true;
+
+    if (n == 0)
+    {
+        c->gerador = NULL;
+        c->corpo = fim_fragmentado;
+        c->tam_corpo = c->fragmentado ? sizeof(fim_fragmentado) - 1 : 0;
+        c->copiar_corpo = false;
+        return true;
+    }
+    if (!c->fragmentado)
+    {
+        c->corpo = dados;
+        c->tam_corpo = n;
+        return true;
+    }
+
+    // Tamanho do chunk em hexadecimal logo antes dos dados, e CRLF depois
+    char prefixo[HTTP_RESERVA_CHUNK + 1];
+    int tam_prefixo = snprintf(prefixo, sizeof(prefixo), "%x\r\n", (unsigned)n);
+    memcpy(dados - tam_prefixo, prefixo, (size_t)tam_prefixo);
+    dados[n] = '\r';
+    dados[n + 1] = '\n';
+    c->corpo = dados - tam_prefixo;
+    c->tam_corpo = (size_t)tam_prefixo + n + 2;
+    return true;
+}
+
+// Responde com um erro do próprio servidor e encerra a conexão depois do envio
+static void responder_erro(http_conexao_t *c, int status, const char *txt)
+{
+    http_resposta_t resp = {.dinamico = c->dinamico};
+    http_resposta_texto(&resp, status, txt);
+
+    c->req_len = 0; // o restante do buffer não pode mais ser interpretado
+    descartar_resto(c);
+    c->fechar = true;
+    preparar_resposta(c, &resp);
+}
+
+// Entrega ao TCP o quanto couber da resposta atual. O restante é enviado quando
+// o cliente confirmar dados (http_sent) ou no próximo tcp_poll.
+static err_t enviar_pendente(http_conexao_t *c)
+{
+    size_t total = c->tam_cabecalho + c->tam_corpo;
+
+    while (c->enfileirado < total || c->gerador)
+    {
+        if (c->enfileirado == total)
+        {
+            // Parte anterior entregue: gera a próxima (ou o fim do corpo)
+            if (!gerar_parte(c))
+            {
+                return abortar_conexao(c); // corpo incompleto: o cliente precisa ver o erro
+            }
+            total = c->tam_cabecalho + c->tam_corpo;
+            continue;
+        }
+
+        const char *dados;
+        size_t restante;
+        u8_t flags;
+
+        if (c->enfileirado < c->tam_cabecalho)
+        {
+            dados = c->cabecalho + c->enfileirado;
+            restante = c->tam_cabecalho - c->enfileirado;
+            flags = TCP_WRITE_FLAG_COPY;
+        }
+        else
+        {
+            size_t pos = c->enfileirado - c->tam_cabecalho;
+            dados = c->corpo + pos;
+            restante = c->tam_corpo - pos;
+            // Corpos estáticos (página HTML) ficam na flash e não precisam de cópia
+            flags = c->copiar_corpo ? TCP_WRITE_FLAG_COPY : 0;
+        }
+
+        size_t livre = tcp_sndbuf(c->pcb);
+        if (livre == 0)
+        {
+            break;
+        }
+        size_t n = restante < livre ? restante : livre;
+        if (c->enfileirado + n < total)
+        {
+            flags |= TCP_WRITE_FLAG_MORE;
+        }
+
+        err_t err = tcp_write(c->pcb, dados, (u16_t)n, flags);
+        if (err == ERR_MEM)
+        {
+            break; // Fila ou memória do lwIP esgotada: tenta novamente no próximo http_sent/http_poll
+        }
+        if (err != ERR_OK)
+        {
+            return abortar_conexao(c); // Conexão em estado inválido para envio
+        }
+        c->enfileirado += n;
+        c->nao_confirmados += n;
+    }
+
+    if (tcp_output(c->pcb) == ERR_RTE)
+    {
+        return abortar_conexao(c); // Sem rota para o cliente
+    }
+
+    if (c->enfileirado < total || c->gerador)
+    {
+        return ERR_OK;
+    }
+
+    // Resposta inteira entregue ao TCP
+    c->respondendo = false;
+    if (c->fechar)
+    {
+        return fechar_conexao(c);
+    }
+    return ERR_OK;
+}
+
+// Atende, em ordem, até 'limite' requisições completas que já estão no buffer.
+// Uma nova resposta só começa quando a anterior foi inteiramente enfileirada.
+static err_t atender(http_conexao_t *c, int limite)
+{
+    while (!c->respondendo && limite-- > 0)
+    {
+        size_t tam_cabecalhos = 0;
+        int tam = http_requisicao_completa(c->req, c->req_len, HTTP_TAM_REQUISICAO, &tam_cabecalhos);
+        if (tam == 0)
+        {
+            break;
+        }
+
+        if (tam < 0)
+        {
+            responder_erro(c, -tam, tam == -431 ? "Cabecalho muito grande" : tam == -413 ? "Corpo muito grande" : "Requisicao invalida");
+        }
+        else
+        {
+            // Separa cabeçalhos e corpo como strings independentes
+            char corpo_final = c->req[tam];
+            c->req[tam_cabecalhos - 2] = '\0';
+            c->req[tam] = '\0';
+
+            http_requisicao_t req = {
+                .texto = c->req,
+                .corpo = c->req + tam_cabecalhos,
+                .tam_corpo = (size_t)tam - tam_cabecalhos,
+            };
+            http_resposta_t resp = {
+                .status = 200,
+                .tipo = "text/html",
+                .corpo = "",
+                .tam_corpo = 0,
+                .cabecalhos = NULL,
+                .dinamico = c->dinamico,
+            };
+            tratador_rotas(&req, &resp);
+
+            // Corpo compartilhado grande demais para 'dinamico' numa conexão que ainda
+            // segura outro: a requisição espera a confirmação do anterior (http_sent)
+            if (resp.liberar && c->liberar && resp.tam_corpo > HTTP_TAM_CORPO_DINAMICO)
+            {
+                resp.liberar(resp.ref);
+                c->req[tam_cabecalhos - 2] = '\r';
+                c->req[tam] = corpo_final;
+                break;
+            }
+            metricas_contar(METRICA_HTTP_REQUISICOES);
+
+            // HTTP/1.0 não conhece chunked: corpo gerado termina com o fechamento da conexão
+            c->atendidas++;
+            c->http10 = http_requisicao_http10(req.texto);
+            c->fechar = c->cliente_encerrou ||
+                        !http_requisicao_mantem_conexao(req.texto) ||
+                        c->atendidas >= HTTP_MAX_REQ_POR_CONEXAO ||
+                        (resp.gerador && c->http10);
+            preparar_resposta(c, &resp);
+
+            // Descarta a requisição atendida, preservando as próximas (pipelining), e
+            // completa o buffer com o que ainda não tinha cabido
+            c->req[tam] = corpo_final;
+            memmove(c->req, c->req + tam, c->req_len - (size_t)tam);
+            c->req_len -= (size_t)tam;
+            absorver_resto(c);
+        }
+
+        err_t err = enviar_pendente(c);
+        if (err != ERR_OK)
+        {
+            return err;
+        }
+    }
+
+    // Cliente já encerrou e não há mais nada a responder
+    if (c->cliente_encerrou && !c->respondendo && c->req_len == 0)
+    {
+        return fechar_conexao(c);
+    }
+    return ERR_OK;
+}
+
+// Rodada circular pelas demais conexões com requisições pendentes, para que um
+// cliente com muitas requisições enfileiradas não atrase os outros
+static void servir_demais(const http_conexao_t *atual)
+{
+    for (int i = 0; i < HTTP_MAX_CONEXOES; i++)
+    {
+        http_conexao_t *c = &conexoes[(proximo_slot + i) % HTTP_MAX_CONEXOES];
+        if (c != atual && c->pcb && !c->respondendo && c->req_len > 0)
+        {
+            atender(c, HTTP_RESPOSTAS_POR_VEZ);
+        }
+    }
+    proximo_slot = (proximo_slot + 1) % HTTP_MAX_CONEXOES;
+}
+
+// Callback chamado quando dados HTTP foram confirmados pelo cliente
+static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+    (void)tpcb;
+    http_conexao_t *c = (http_conexao_t *)arg;
+    if (!c)
+    {
+        return ERR_OK;
+    }
+    RASTRO_INICIO("http_sent");
+    c->ultimo_ms = agora_ms();
+
+    // Corpo compartilhado já enfileirado por inteiro e confirmado: o lwIP não o usa mais
+    c->nao_confirmados -= len < c->nao_confirmados ? len : c->nao_confirmados;
+    if (!c->respondendo && c->nao_confirmados == 0)
+    {
+        soltar_corpo(c);
+    }
+
+    err_t err = ERR_OK;
+    if (c->respondendo)
+    {
+        err = enviar_pendente(c);
+    }
+    if (err == ERR_OK)
+    {
+        err = atender(c, HTTP_RESPOSTAS_POR_VEZ);
+    }
+    servir_demais(c);
+    RASTRO_FIM("http_sent");
+    return retorno_callback(err);
+}
+
+// Acumula os bytes recebidos e atende as requisições completas
+static err_t receber(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    http_conexao_t *c = (http_conexao_t *)arg;
+
+    // Conexão já liberada: apenas descarta
+    if (!c)
+    {
+        if (p)
+        {
+            tcp_recved(tpcb, p->tot_len);
+            pbuf_free(p);
+        }
+        return ERR_OK;
+    }
+
+    // Se não recebeu dados (p == NULL), o cliente encerrou o envio
+    if (!p)
+    {
+        c->cliente_encerrou = true;
+        return retorno_callback(atender(c, HTTP_RESPOSTAS_POR_VEZ));
+    }
+
+    if (err != ERR_OK)
+    {
+        pbuf_free(p);
+        return err;
+    }
+
+    if (c->resto)
+    {
+        // O segmento anterior ainda não coube inteiro: recusa este por enquanto. O lwIP
+        // o reentrega depois, e a janela fechada segura o cliente.
+        return ERR_MEM;
+    }
+
+    // Copia para o buffer da conexão o quanto couber; o resto (o começo das próximas
+    // requisições de um segmento com várias) entra à medida que as da frente são
+    // atendidas. Só uma requisição que sozinha passa do buffer recebe 431 (em atender).
+    c->resto = p;
+    absorver_resto(c);
+
+    c->ultimo_ms = agora_ms();
+    err = atender(c, HTTP_RESPOSTAS_POR_VEZ);
+    servir_demais(c);
+    return retorno_callback(err);
+}
+
+// Callback de recepção do lwIP, com o tempo de processamento registrado nas métricas
+static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    RASTRO_INICIO("http_recv");
+    uint32_t inicio = metricas_inicio();
+    err_t resultado = receber(arg, tpcb, p, err);
+    metricas_registrar(METRICA_HTTP_RECV, inicio);
+    RASTRO_FIM("http_recv");
+    return resultado;
+}
+
+// Chamado periodicamente pelo lwIP: retoma envios pendentes e encerra conexões ociosas
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb)
+{
+    http_conexao_t *c = (http_conexao_t *)arg;
+    if (!c)
+    {
+        tcp_abort(tpcb);
+        return ERR_ABRT;
+    }
+    RASTRO_INSTANTE("http_poll");
+
+    if (agora_ms() - c->ultimo_ms > HTTP_TIMEOUT_OCIOSO_MS)
+    {
+        return retorno_callback(fechar_conexao(c));
+    }
+
+    err_t err = ERR_OK;
+    if (c->respondendo)
+    {
+        err = enviar_pendente(c);
+    }
+    if (err == ERR_OK)
+    {
+        err = atender(c, HTTP_RESPOSTAS_POR_VEZ);
+    }
+    return retorno_callback(err);
+}
+
+// Conexão abortada pelo lwIP (RST, falta de memória): o PCB já foi liberado
+static void http_erro(void *arg, err_t err)
+{
+    (void)err;
+    http_conexao_t *c = (http_conexao_t *)arg;
+    if (c)
+    {
+        c->pcb = NULL;
+        descartar_resto(c);
+        soltar_corpo(c);
+    }
+}
+
+// Procura um slot livre. Se todos estiverem ocupados, encerra a conexão keep-alive
+// ociosa há mais tempo. Conexões com requisição em andamento nunca são descartadas, nem
+// as que ainda não receberam a primeira resposta: o pedido delas pode estar a caminho, e
+// o cliente receberia um RST em vez de uma resposta.
+static http_conexao_t *alocar_slot(void)
+{
+    http_conexao_t *ociosa = NULL;
+
+    for (int i = 0; i < HTTP_MAX_CONEXOES; i++)
+    {
+        http_conexao_t *c = &conexoes[i];
+        if (!c->pcb)
+        {
+            return c;
+        }
+        if (!c->respondendo && c->req_len == 0 && c->atendidas > 0 && (!ociosa || c->ultimo_ms < ociosa->ultimo_ms))
+        {
+            ociosa = c;
+        }
+    }
+
+    if (ociosa)
+    {
+        fechar_conexao(ociosa);
+    }
+    return ociosa;
+}
+
+// Callback chamado quando uma nova conexão TCP é aceita
+static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+    (void)arg;
+    if (err != ERR_OK || !newpcb)
+    {
+        return ERR_VAL;
+    }
+    RASTRO_INSTANTE("tcp_accept");
+
+    http_conexao_t *c = alocar_slot();
+    if (!c)
+    {
+        // Sem slot disponível: avisa o cliente e encerra sem manter estado
+        metricas_contar(METRICA_HTTP_RECUSADAS);
+        if (tcp_write(newpcb, resposta_ocupado, sizeof(resposta_ocupado) - 1, 0) != ERR_OK ||
+            tcp_close(newpcb) != ERR_OK)
+        {
+            tcp_abort(newpcb);
+            return ERR_ABRT;
+        }
+        return ERR_OK;
+    }
+
+    metricas_contar(METRICA_HTTP_CONEXOES);
+    c->pcb = newpcb;
+    c->req_len = 0;
+    c->resto = NULL;
+    c->atendidas = 0;
+    c->ultimo_ms = agora_ms();
+    c->fechar = false;
+    c->cliente_encerrou = false;
+    c->respondendo = false;
+    c->liberar = NULL;
+    c->nao_confirmados = 0;
+
+    // Associa o estado e os callbacks da conexão
+    tcp_arg(newpcb, c);
+    tcp_recv(newpcb, http_recv);
+    tcp_sent(newpcb, http_sent);
+    tcp_poll(newpcb, http_poll, HTTP_INTERVALO_POLL);
+    tcp_err(newpcb, http_erro);
+    return ERR_OK;
+}
+
+// Cria o PCB de escuta na porta configurada
+static bool escutar(void)
+{
+    // Cria um novo PCB TCP (Protocolo Control Block)
+    struct tcp_pcb *pcb = tcp_new();
+    if (!pcb)
+    {
+        printf("Erro ao criar PCB TCP\n");
+        return false;
+    }
+    // Vincula o PCB TCP à porta, qualquer IP, mesmo com conexões antigas em TIME_WAIT
+    ip_set_option(pcb, SOF_REUSEADDR);
+    if (tcp_bind(pcb, IP_ADDR_ANY, porta_escuta) != ERR_OK)
+    {
+        printf("Erro ao ligar o servidor na porta %u\n", porta_escuta);
+        tcp_close(pcb);
+        return false;
+    }
+    // Coloca o PCB para escutar conexões entrantes
+    pcb_escuta = tcp_listen(pcb);
+    if (!pcb_escuta)
+    {
+        printf("Erro ao escutar na porta %u\n", porta_escuta);
+        return false;
+    }
+    // Define o callback para aceitar novas conexões TCP
+    tcp_accept(pcb_escuta, connection_callback);
+    printf("Servidor HTTP rodando na porta %u...\n", porta_escuta);
+    return true;
+}
+
+// Função que inicia o servidor HTTP na porta indicada
+bool servidor_http_iniciar(uint16_t porta, http_tratador_t tratador)
+{
+    tratador_rotas = tratador;
+    porta_escuta = porta;
+    return escutar();
+}
+
+// Aborta as conexões abertas e volta a escutar. As conexões do IP antigo já não têm
+// volta; abortá-las libera os slots na hora, em vez de esperar o timeout ocioso.
+bool servidor_http_reiniciar(void)
+{
+    cyw43_arch_lwip_begin();
+    for (int i = 0; i < HTTP_MAX_CONEXOES; i++)
+    {
+        if (conexoes[i].pcb)
+        {
+            abortar_conexao(&conexoes[i]);
+        }
+        if (fechamentos[i].pcb)
+        {
+            tcp_abort(fechamentos[i].pcb); // fechamento_erro solta o corpo
+        }
+    }
+    if (pcb_escuta)
+    {
+        tcp_close(pcb_escuta);
+        pcb_escuta = NULL;
+    }
+    bool ok = escutar();
+    cyw43_arch_lwip_end();
+    return ok;
+}
+
+// Quantidade de slots de conexão em uso
+int servidor_http_conexoes_ativas(void)
+{
+    int ativas = 0;
+    for (int i = 0; i < HTTP_MAX_CONEXOES; i++)
+    {
+        if (conexoes[i].pcb)
+        {
+            ativas++;
+        }
+    }
+    return ativas;
+}
+
+// Preenche a resposta com um corpo de texto simples
+void http_resposta_texto(http_resposta_t *resp, int status, const char *txt)
+{
+    resp->status = status;
+    resp->tipo = "text/plain";
+    resp->corpo = txt;
+    resp->tam_corpo = strlen(txt);
+}
+
+size_t http_gerar_itens(uint32_t *cursor, char *buf, size_t tam, http_item_t item)
+{
+    size_t usado = 0;
+    while (usado < tam)
+    {
+        int n = item(*cursor, buf + usado, tam - usado);
+        if (n < 0)
+        {
+            break; // fim do corpo
+        }
+        if ((size_t)n >= tam - usado)
+        {
+            if (usado == 0)
+            {
+                return HTTP_GERADOR_ERRO; // não cabe nem sozinho
+            }
+            break; // não coube inteiro: fica para a próxima parte
+        }
+        usado += (size_t)n;
+        (*cursor)++;
+    }
+    return usado;
+}
@@ -0,0 +1,94 @@
+#ifndef SERVIDOR_HTTP_H // Previne múltiplas inclusões do cabeçalho
+#define SERVIDOR_HTTP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwip/tcp.h"
+
+// ============================================================================
+// === Parâmetros do servidor HTTP ===
+#define HTTP_PORTA 80
+#define HTTP_MAX_CONEXOES 16         // Slots de conexão simultâneas (tabela fixa, sem malloc)
+#define HTTP_TAM_REQUISICAO 1024     // Limite de cabeçalhos + corpo acumulados por requisição
+#define HTTP_TAM_CABECALHO 256       // Linha de status + cabeçalhos da resposta
+#define HTTP_TAM_CORPO_DINAMICO 768  // Corpo gerado pelas rotas (JSON, texto)
+#define HTTP_MAX_REQ_POR_CONEXAO 100 // Após isso a conexão responde com "Connection: close"
+#define HTTP_RESPOSTAS_POR_VEZ 4     // Requisições atendidas por conexão a cada rodada
+#define HTTP_TIMEOUT_OCIOSO_MS 5000  // Conexão keep-alive sem tráfego é encerrada
+#define HTTP_INTERVALO_POLL 2        // Intervalo do tcp_poll, em unidades de 500 ms
+
+// ============================================================================
+// === Tipos ===
+
+// Requisição completa, já reunida a partir de um ou mais segmentos TCP
+typedef struct
+{
+    const char *texto; // Linha de requisição + cabeçalhos, terminado em '\0'
+    const char *corpo; // Corpo indicado por Content-Length, terminado em '\0'
+    size_t tam_corpo;  // Tamanho do corpo em bytes (0 se ausente)
+} http_requisicao_t;
+
+// Gera o próximo trecho de um corpo de tamanho desconhecido em 'buf' (até 'tam' bytes).
+// 'cursor' começa em 0 e é avançado pelo gerador. Retorna 0 quando não há mais dados, ou
+// HTTP_GERADOR_ERRO se não consegue continuar: a conexão é abortada, e o cliente vê a
+// resposta incompleta em vez de um corpo cortado que pareceria inteiro.
+typedef size_t (*http_gerador_t)(uint32_t *cursor, char *buf, size_t tam);
+#define HTTP_GERADOR_ERRO ((size_t)-1)
+
+// Escreve o item 'item' de um corpo em 'buf'. Retorna o tamanho, como snprintf (>= tam
+// se não coube), ou -1 depois do último item.
+typedef int (*http_item_t)(uint32_t item, char *buf, size_t tam);
+
+// Devolve a referência a um corpo compartilhado entre conexões (veja 'liberar' abaixo)
+typedef void (*http_liberar_t)(void *ref);
+
+// Resposta montada pelo tratador de rotas para uma requisição
+typedef struct
+{
+    int status;             // Código HTTP (200, 404...)
+    const char *tipo;       // Content-Type
+    const char *corpo;      // Corpo: estático ou apontando para 'dinamico'
+    size_t tam_corpo;       // Tamanho do corpo em bytes
+    const char *cabecalhos; // Cabeçalhos extras terminados em "\r\n" (ou NULL)
+    char *dinamico;         // Buffer de HTTP_TAM_CORPO_DINAMICO bytes para corpos gerados
+    http_gerador_t gerador; // Corpo produzido em partes durante o envio (ignora 'corpo')
+    http_liberar_t liberar; // Corpo compartilhado: chamado com 'ref' quando o TCP o soltar
+    void *ref;
+} http_resposta_t;
+
+// Tratador de rotas: recebe a requisição completa e preenche a resposta.
+// Quando 'corpo' aponta para 'dinamico', o conteúdo é copiado para a pilha TCP;
+// caso contrário o ponteiro deve permanecer válido (memória estática).
+// Com 'gerador' o corpo é enviado com "Transfer-Encoding: chunked" (HTTP/1.0: até o
+// fechamento da conexão), permitindo respostas maiores que o buffer dinâmico.
+// Com 'liberar' o corpo é um buffer imutável compartilhado entre conexões: vai sem cópia
+// e 'liberar(ref)' é chamado uma vez, quando o cliente confirmou todos os bytes (ou a
+// conexão caiu). Se a conexão ainda segura outro corpo compartilhado, este é copiado para
+// 'dinamico' e liberado na hora; se não couber, é liberado e o tratador é chamado de novo
+// para a mesma requisição quando o anterior for confirmado.
+typedef void (*http_tratador_t)(const http_requisicao_t *req, http_resposta_t *resp);
+
+// ============================================================================
+// === API ===
+
+// Inicia o servidor HTTP na porta indicada. Retorna false em caso de erro.
+bool servidor_http_iniciar(uint16_t porta, http_tratador_t tratador);
+
+// Fecha todas as conexões e recria o PCB de escuta na mesma porta (troca de IP).
+// Chamar fora dos callbacks do lwIP. Retorna false se não voltou a escutar.
+bool servidor_http_reiniciar(void);
+
+// Quantidade de slots de conexão em uso
+int servidor_http_conexoes_ativas(void);
+
+// Preenche a resposta com um corpo de texto simples
+void http_resposta_texto(http_resposta_t *resp, int status, const char *txt);
+
+// Gerador (http_gerador_t) de um corpo feito de itens: escreve em 'buf' os próximos itens
+// inteiros e deixa 'cursor' no primeiro que não coube. Um item maior que o buffer inteiro
+// nunca caberia: retorna HTTP_GERADOR_ERRO.
+size_t http_gerar_itens(uint32_t *cursor, char *buf, size_t tam, http_item_t item);
+
+#endif // SERVIDOR_HTTP_H
@@ -0,0 +1,179 @@
+#include "supervisor.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#include "agendador.h"
+
+#define MAGICA_ESTADO 0x45535431u   // "EST1"
+#define MAGICA_REGISTRO 0x53555031u // "SUP1"
+#define TAM_CAUSA 16
+
+// Bloco de estado retido. 'tamanho' recusa um bloco gravado por um firmware com outro
+// estado_retido_t; 'soma' cobre tudo o que vem antes dela.
+typedef struct
+{
+    uint32_t magica;
+    uint32_t tamanho;
+    uint32_t sequencia;
+    estado_retido_t estado;
+    uint32_t soma;
+} bloco_t;
+
+// Contagem de resets e causa do último, mantidos entre partidas a quente
+typedef struct
+{
+    uint32_t magica;
+    uint32_t reinicios;
+    char causa[TAM_CAUSA];
+    uint32_t soma;
+} registro_t;
+
+static bloco_t __uninitialized_ram(blocos)[2];
+static registro_t __uninitialized_ram(registro);
+
+static uint32_t sequencia; // Do último bloco publicado
+static int livre;          // Bloco da próxima escrita
+static bool quente;
+static uint32_t partida_ms;
+static char causa[TAM_CAUSA]; // Copiada do registro na partida ("" se não houve)
+
+// FNV-1a por palavra: os blocos são alinhados e têm tamanho múltiplo de 4
+static uint32_t checksum(const void *dados, size_t tam)
+{
+    const uint32_t *p = dados;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tam / 4; i++)
+    {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+static bool bloco_valido(const bloco_t *b)
+{
+    return b->magica == MAGICA_ESTADO && b->tamanho == sizeof(estado_retido_t) &&
+           b->soma == checksum(b, offsetof(bloco_t, soma));
+}
+
+static void registro_publicar(void)
+{
+    registro.magica = MAGICA_REGISTRO;
+    registro.soma = checksum(&registro, offsetof(registro_t, soma));
+}
+
+const estado_retido_t *supervisor_partida(void)
+{
+    // Só um reset por estouro do watchdog ligado em supervisor_iniciar conta; o
+    // watchdog_reboot do bootrom e do picotool (regravação) não
+    bool watchdog = watchdog_enable_caused_reboot();
+    bool registro_ok = registro.magica == MAGICA_REGISTRO &&
+                       registro.soma == checksum(&registro, offsetof(registro_t, soma));
+
+    const bloco_t *escolhido = NULL;
+    for (int i = 0; watchdog && i < 2; i++)
+    {
+        if (bloco_valido(&blocos[i]) && (!escolhido || (int32_t)(blocos[i].sequencia - escolhido->sequencia) > 0))
+        {
+            escolhido = &blocos[i];
+        }
+    }
+
+    quente = escolhido != NULL && registro_ok;
+    if (quente)
+    {
+        sequencia = escolhido->sequencia;
+        livre = escolhido == &blocos[0] ? 1 : 0;
+        memcpy(causa, registro.causa, TAM_CAUSA);
+        causa[TAM_CAUSA - 1] = '\0';
+        registro.reinicios++;
+    }
+    else
+    {
+        sequencia = 0;
+        livre = 0;
+        blocos[0].magica = blocos[1].magica = 0;
+        registro.reinicios = 0;
+    }
+    registro.causa[0] = '\0';
+    registro_publicar();
+    return quente ? &escolhido->estado : NULL;
+}
+
+estado_retido_t *supervisor_alterar(void)
+{
+    return &blocos[livre].estado;
+}
+
+void supervisor_publicar(void)
+{
+    bloco_t *b = &blocos[livre];
+    b->magica = MAGICA_ESTADO;
+    b->tamanho = sizeof(estado_retido_t);
+    b->sequencia = ++sequencia;
+    b->soma = checksum(b, offsetof(bloco_t, soma));
+    livre ^= 1;
+}
+
+void supervisor_iniciar(void)
+{
+    partida_ms = to_ms_since_boot(get_absolute_time());
+    watchdog_enable(SUPERVISOR_WATCHDOG_MS, true);
+}
+
+bool supervisor_verificar(void)
+{
+    uint64_t agora = time_us_64();
+    for (size_t i = 0; i < agendador_num_tarefas(); i++)
+    {
+        const agendador_tarefa_t *t = agendador_tarefa(i);
+        uint64_t tolerancia = (uint64_t)t->periodo_us * SUPERVISOR_PERIODOS_TOLERADOS + SUPERVISOR_FOLGA_MS * 1000u;
+        if (agora - t->ultimo_fim_us > tolerancia)
+        {
+            // Sem alimentar o watchdog daqui em diante: o reset vem em
+            // SUPERVISOR_WATCHDOG_MS, e a causa fica para a próxima partida
+            if (registro.causa[0] == '\0')
+            {
+                strncpy(registro.causa, t->nome, TAM_CAUSA - 1);
+                registro.causa[TAM_CAUSA - 1] = '\0';
+                registro_publicar();
+            }
+            return false;
+        }
+    }
+
+    // A tarefa atrasada voltou antes do reset: nada a registrar
+    if (registro.causa[0] != '\0')
+    {
+        registro.causa[0] = '\0';
+        registro_publicar();
+    }
+    watchdog_update();
+    return true;
+}
+
+bool supervisor_partida_quente(void)
+{
+    return quente;
+}
+
+uint32_t supervisor_reinicios(void)
+{
+    return registro.reinicios;
+}
+
+uint32_t supervisor_partida_ms(void)
+{
+    return partida_ms;
+}
+
+const char *supervisor_causa(void)
+{
+    if (!quente)
+    {
+        return NULL;
+    }
+    return causa[0] != '\0' ? causa : "laco";
+}
@@ -0,0 +1,66 @@
+#ifndef SUPERVISOR_H // Previne múltiplas inclusões do cabeçalho
+#define SUPERVISOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "amostra.h"
+#include "configuracao.h"
+#include "alertas.h"
+#include "grafico.h"
+
+// Supervisão pelo watchdog e partida a quente.
+//
+// O watchdog do RP2040 só é alimentado por supervisor_verificar, e só se todas as
+// tarefas do agendador tiverem terminado uma execução há no máximo
+// SUPERVISOR_PERIODOS_TOLERADOS períodos (mais SUPERVISOR_FOLGA_MS). Um laço preso
+// dentro de uma tarefa, ou uma tarefa que deixou de rodar, reinicia a placa em até
+// SUPERVISOR_WATCHDOG_MS.
+//
+// O estado que não se quer perder (configuração, última amostra, regras de alerta e
+// histórico do gráfico) é copiado para a RAM de .uninitialized_data, que o crt0 não
+// zera e o reset do watchdog preserva. São dois blocos usados alternadamente, cada um
+// com número de sequência e checksum: um reset no meio de uma cópia invalida só o
+// bloco sendo escrito, e o outro continua valendo. Depois de um reset do watchdog
+// com um bloco válido, a partida é a quente: o estado é restaurado e a espera do USB
+// e da conexão Wi-Fi saem do caminho.
+
+#define SUPERVISOR_WATCHDOG_MS 3000    // Sem alimentação por esse tempo, a placa reinicia
+#define SUPERVISOR_PERIODOS_TOLERADOS 4 // Execuções seguidas que uma tarefa pode perder
+#define SUPERVISOR_FOLGA_MS 1000        // Somada à tolerância de cada tarefa
+
+typedef struct
+{
+    configuracao_t config;
+    amostra_t amostra; // Última amostra publicada
+    regra_t regras[ALERTAS_MAX_REGRAS];
+    grafico_historico_t grafico;
+} estado_retido_t;
+
+// Verifica a causa do reset e os blocos retidos. Na partida a quente (reset do
+// watchdog com um bloco válido) retorna o estado guardado, que continua válido até o
+// segundo supervisor_publicar; na partida a frio, NULL. Chamar no início do main.
+const estado_retido_t *supervisor_partida(void);
+
+// Abre a escrita do bloco livre e o retorna para ser preenchido no lugar. Precisa ser
+// seguida de supervisor_publicar.
+estado_retido_t *supervisor_alterar(void);
+
+// Fecha o bloco aberto por supervisor_alterar com a sequência e o checksum
+void supervisor_publicar(void);
+
+// Liga o watchdog (pausado durante a depuração). Chamar logo antes do agendador.
+void supervisor_iniciar(void);
+
+// Confere os batimentos das tarefas e alimenta o watchdog se todos estiverem em dia.
+// Na primeira tarefa atrasada, grava o nome dela para a próxima partida e deixa de
+// alimentar o watchdog. Retorna false nesse caso.
+bool supervisor_verificar(void);
+
+// Estatísticas da partida, para /metrics e o console
+bool supervisor_partida_quente(void);
+uint32_t supervisor_reinicios(void);   // Resets do watchdog desde a última partida a frio
+uint32_t supervisor_partida_ms(void);  // Do reset até supervisor_iniciar
+const char *supervisor_causa(void);    // Tarefa atrasada no último reset, "laco" se nenhuma, ou NULL
+
+#endif // SUPERVISOR_H
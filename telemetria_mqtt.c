@@ -0,0 +1,385 @@
+#include "telemetria_mqtt.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/apps/mqtt.h"
+#include "telemetria_udp.h"
+
+// Estados da sessão com o broker
+typedef enum
+{
+    MQTT_DESCONECTADO,
+    MQTT_CONECTANDO,
+    MQTT_CONECTADO
+} estado_mqtt_t;
+
+static mqtt_client_t *cliente;
+static volatile estado_mqtt_t estado = MQTT_DESCONECTADO;
+static uint32_t proxima_tentativa_ms;     // instante da próxima tentativa de conexão
+static uint32_t espera_ms = MQTT_RECONEXAO_MIN_MS;
+static mqtt_comando_t tratar_comando;
+
+// Fila circular de amostras a publicar
+static amostra_t fila[MQTT_TAM_FILA];
+static uint8_t inicio_fila, tam_fila;
+static uint8_t lote = 1;                  // amostras por mensagem com o enlace livre
+static uint32_t seq_mensagem;             // número de sequência da próxima mensagem
+static uint32_t descartadas;              // amostras perdidas por fila cheia
+
+_Static_assert(MQTT_JANELA * MQTT_MAX_LOTE < MQTT_TAM_FILA, "a fila precisa ter amostras fora dos lotes em trânsito");
+
+// Lotes publicados aguardando PUBACK, na ordem de envio. As amostras de um lote só saem
+// da fila com a confirmação. Se a sessão cai ou uma publicação falha, os lotes em
+// trânsito voltam a ser pendentes e são publicados de novo (entrega pelo menos uma vez:
+// uma repetição tem outro seq, mas as mesmas amostras, com o mesmo t_ms).
+typedef struct
+{
+    uint32_t seq;
+    uint8_t amostras;
+    bool confirmado;
+} lote_t;
+
+static lote_t em_transito[MQTT_JANELA];
+static uint8_t num_em_transito;
+static uint8_t enviadas; // amostras do início da fila que estão em lotes em trânsito
+
+// Client id único por placa (o broker derruba a sessão de um id repetido), e os tópicos
+// montados a partir de MQTT_TOPICO_BASE e dele
+static char id_estacao[24];
+static char topico_telemetria[64];
+static char topico_status[64];
+static char topico_cmd[64];
+static char topico_resposta[64];
+
+// Mensagem recebida no tópico de comandos (pode chegar em vários pedaços)
+static bool recebendo_cmd;
+static char cmd_buf[160];
+static size_t cmd_len;
+
+static uint32_t agora_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+// Agenda a próxima tentativa de conexão com espera exponencial
+static void agendar_reconexao(void)
+{
+    estado = MQTT_DESCONECTADO;
+    proxima_tentativa_ms = agora_ms() + espera_ms;
+    espera_ms *= 2;
+    if (espera_ms > MQTT_RECONEXAO_MAX_MS)
+    {
+        espera_ms = MQTT_RECONEXAO_MAX_MS;
+    }
+}
+
+// Aplica uma linha "chave=valor" recebida no tópico de comandos
+static bool aplicar_linha_comando(char *linha)
+{
+    char *igual = strchr(linha, '=');
+    if (!igual)
+    {
+        return false;
+    }
+    *igual = '\0';
+
+    char *fim;
+    float valor = strtof(igual + 1, &fim);
+    if (fim == igual + 1)
+    {
+        return false;
+    }
+
+    // Chave própria do módulo: tamanho do lote de publicação
+    if (strcmp(linha, "lote") == 0)
+    {
+        if (valor < 1 || valor > MQTT_MAX_LOTE)
+        {
+            return false;
+        }
+        lote = (uint8_t)valor;
+        return true;
+    }
+    return tratar_comando && tratar_comando(linha, valor);
+}
+
+// Interpreta o comando completo: várias linhas "chave=valor" separadas por '\n', ';' ou '&'
+static void processar_comando(void)
+{
+    int aplicados = 0, rejeitados = 0;
+
+    cmd_buf[cmd_len] = '\0';
+    for (char *linha = strtok(cmd_buf, "\n;&"); linha; linha = strtok(NULL, "\n;&"))
+    {
+        if (aplicar_linha_comando(linha))
+        {
+            aplicados++;
+        }
+        else
+        {
+            rejeitados++;
+        }
+    }
+
+    char resposta[48];
+    int tam = snprintf(resposta, sizeof(resposta), "aplicados=%d;rejeitados=%d", aplicados, rejeitados);
+    mqtt_publish(cliente, topico_resposta, resposta, (u16_t)tam, 0, 0, NULL, NULL);
+}
+
+// Início de uma publicação recebida: só o tópico de comandos interessa
+static void mqtt_publicacao_cb(void *arg, const char *topico, u32_t tam_total)
+{
+    recebendo_cmd = strcmp(topico, topico_cmd) == 0;
+    cmd_len = 0;
+}
+
+// Dados de uma publicação recebida; o comando é aplicado ao chegar o último pedaço
+static void mqtt_dados_cb(void *arg, const u8_t *dados, u16_t tam, u8_t flags)
+{
+    if (!recebendo_cmd)
+    {
+        return;
+    }
+
+    size_t cabe = sizeof(cmd_buf) - 1 - cmd_len;
+    if (tam > cabe)
+    {
+        tam = (u16_t)cabe;
+    }
+    memcpy(cmd_buf + cmd_len, dados, tam);
+    cmd_len += tam;
+
+    if (flags & MQTT_DATA_FLAG_LAST)
+    {
+        processar_comando();
+        recebendo_cmd = false;
+    }
+}
+
+// Devolve à fila todos os lotes em trânsito; confirmações tardias deles são ignoradas
+static void devolver_lotes(void)
+{
+    num_em_transito = 0;
+    enviadas = 0;
+}
+
+// Resultado da tentativa de conexão ou queda da sessão
+static void mqtt_conexao_cb(mqtt_client_t *c, void *arg, mqtt_connection_status_t status)
+{
+    if (status == MQTT_CONNECT_ACCEPTED)
+    {
+        estado = MQTT_CONECTADO;
+        espera_ms = MQTT_RECONEXAO_MIN_MS;
+        devolver_lotes();
+        mqtt_subscribe(c, topico_cmd, 1, NULL, NULL);
+        mqtt_publish(c, topico_status, "online", 6, 1, 1, NULL, NULL);
+        printf("MQTT conectado a %s\n", MQTT_BROKER_IP);
+    }
+    else
+    {
+        printf("MQTT desconectado (status %d)\n", status);
+        devolver_lotes(); // o cliente descartou as publicações sem PUBACK
+        agendar_reconexao();
+    }
+}
+
+// Confirmação (PUBACK) ou falha de uma publicação de telemetria; 'arg' é o seq do lote
+static void mqtt_publicado_cb(void *arg, err_t err)
+{
+    uint32_t seq = (uint32_t)(uintptr_t)arg;
+    int i = 0;
+    while (i < num_em_transito && em_transito[i].seq != seq)
+    {
+        i++;
+    }
+    if (i == num_em_transito)
+    {
+        return; // lote já devolvido à fila
+    }
+    if (err != ERR_OK)
+    {
+        devolver_lotes();
+        return;
+    }
+
+    // Remove da fila os lotes confirmados do início, na ordem de envio
+    em_transito[i].confirmado = true;
+    while (num_em_transito > 0 && em_transito[0].confirmado)
+    {
+        uint8_t n = em_transito[0].amostras;
+        inicio_fila = (inicio_fila + n) % MQTT_TAM_FILA;
+        tam_fila -= n;
+        enviadas -= n;
+        num_em_transito--;
+        memmove(em_transito, em_transito + 1, num_em_transito * sizeof(lote_t));
+    }
+}
+
+// Dispara a conexão com o broker sem aguardar o resultado
+static void conectar(void)
+{
+    ip_addr_t broker;
+    if (!ipaddr_aton(MQTT_BROKER_IP, &broker))
+    {
+        return;
+    }
+
+    // Última vontade: o broker publica "offline" se a estação sumir sem desconectar
+    struct mqtt_connect_client_info_t info = {
+        .client_id = id_estacao,
+        .keep_alive = MQTT_KEEP_ALIVE_S,
+        .will_topic = topico_status,
+        .will_msg = "offline",
+        .will_qos = 1,
+        .will_retain = 1,
+    };
+
+    estado = MQTT_CONECTANDO;
+    if (mqtt_client_connect(cliente, &broker, MQTT_BROKER_PORTA, mqtt_conexao_cb, NULL, &info) != ERR_OK)
+    {
+        agendar_reconexao();
+    }
+}
+
+// Publica as amostras mais antigas ainda fora de lotes em trânsito em uma única mensagem.
+// Com o enlace livre envia 'lote' amostras; se a fila cresceu (enlace lento),
+// agrupa até MQTT_MAX_LOTE amostras na mesma mensagem.
+static bool publicar_lote(void)
+{
+    uint8_t pendentes = tam_fila - enviadas;
+    if (pendentes == 0 || pendentes < lote)
+    {
+        return false;
+    }
+    uint8_t n = pendentes < MQTT_MAX_LOTE ? pendentes : MQTT_MAX_LOTE;
+
+    // Formato: {"seq":N,"desc":D,"amostras":[[t_ms,temp,press,umid],...]}
+    char payload[64 + MQTT_MAX_LOTE * 48];
+    int tam = snprintf(payload, sizeof(payload), "{\"seq\":%lu,\"desc\":%lu,\"amostras\":[",
+                       (unsigned long)seq_mensagem, (unsigned long)descartadas);
+    uint8_t incluidas = 0;
+    while (incluidas < n)
+    {
+        const amostra_t *a = &fila[(inicio_fila + enviadas + incluidas) % MQTT_TAM_FILA];
+        char item[64];
+        int tam_item;
+        if (a->umidade_valida)
+        {
+            tam_item = snprintf(item, sizeof(item), "%s[%lu,%.2f,%.2f,%.2f]", incluidas ? "," : "",
+                                (unsigned long)a->instante_ms, a->temperatura, a->pressao, a->umidade);
+        }
+        else
+        {
+            tam_item = snprintf(item, sizeof(item), "%s[%lu,%.2f,%.2f,null]", incluidas ? "," : "",
+                                (unsigned long)a->instante_ms, a->temperatura, a->pressao);
+        }
+
+        // Leituras absurdas não podem estourar o payload: o lote termina antes
+        if (tam_item <= 0 || (size_t)tam_item >= sizeof(item) || (size_t)(tam + tam_item + 3) > sizeof(payload))
+        {
+            break;
+        }
+        memcpy(payload + tam, item, (size_t)tam_item);
+        tam += tam_item;
+        incluidas++;
+    }
+    if (incluidas == 0)
+    {
+        incluidas = 1; // amostra impossível de formatar: descarta para não travar a fila
+    }
+    payload[tam++] = ']';
+    payload[tam++] = '}';
+
+    // ERR_MEM indica buffer de saída do cliente cheio: tenta de novo na próxima passagem
+    if (mqtt_publish(cliente, topico_telemetria, payload, (u16_t)tam, 1, 0, mqtt_publicado_cb,
+                     (void *)(uintptr_t)seq_mensagem) != ERR_OK)
+    {
+        return false;
+    }
+
+    em_transito[num_em_transito++] = (lote_t){seq_mensagem, incluidas, false};
+    enviadas += incluidas;
+    seq_mensagem++;
+    return true;
+}
+
+// Prepara o cliente. A conexão é feita depois, de forma assíncrona, por telemetria_mqtt_processar.
+void telemetria_mqtt_iniciar(mqtt_comando_t comando)
+{
+    tratar_comando = comando;
+
+    // Mesmo número do beacon UDP, derivado do ID único da flash
+    snprintf(id_estacao, sizeof(id_estacao), "%s-%08lx", MQTT_PREFIXO_ID, (unsigned long)telemetria_udp_id_estacao());
+    snprintf(topico_telemetria, sizeof(topico_telemetria), "%s/%s/telemetria", MQTT_TOPICO_BASE, id_estacao);
+    snprintf(topico_status, sizeof(topico_status), "%s/%s/status", MQTT_TOPICO_BASE, id_estacao);
+    snprintf(topico_cmd, sizeof(topico_cmd), "%s/%s/cmd", MQTT_TOPICO_BASE, id_estacao);
+    snprintf(topico_resposta, sizeof(topico_resposta), "%s/%s/cmd/resposta", MQTT_TOPICO_BASE, id_estacao);
+    printf("MQTT: client id %s\n", id_estacao);
+
+    cyw43_arch_lwip_begin();
+    cliente = mqtt_client_new();
+    if (cliente)
+    {
+        mqtt_set_inpub_callback(cliente, mqtt_publicacao_cb, mqtt_dados_cb, NULL);
+    }
+    cyw43_arch_lwip_end();
+
+    if (!cliente)
+    {
+        printf("Erro ao criar cliente MQTT\n");
+    }
+    proxima_tentativa_ms = agora_ms();
+}
+
+// Enfileira uma amostra. Se a fila estiver cheia, a mais antiga ainda não publicada é
+// descartada; as que estão em lotes em trânsito esperam a confirmação.
+void telemetria_mqtt_amostra(const amostra_t *amostra)
+{
+    cyw43_arch_lwip_begin(); // a confirmação (callback do lwIP) também tira amostras da fila
+    if (tam_fila == MQTT_TAM_FILA)
+    {
+        for (uint8_t i = enviadas; i + 1 < tam_fila; i++)
+        {
+            fila[(inicio_fila + i) % MQTT_TAM_FILA] = fila[(inicio_fila + i + 1) % MQTT_TAM_FILA];
+        }
+        tam_fila--;
+        descartadas++;
+    }
+    fila[(inicio_fila + tam_fila) % MQTT_TAM_FILA] = *amostra;
+    tam_fila++;
+    cyw43_arch_lwip_end();
+}
+
+// Executado no laço principal: reconecta com espera crescente e publica o que estiver na fila
+void telemetria_mqtt_processar(void)
+{
+    if (!cliente)
+    {
+        return;
+    }
+
+    cyw43_arch_lwip_begin();
+    if (estado == MQTT_DESCONECTADO && (int32_t)(agora_ms() - proxima_tentativa_ms) >= 0)
+    {
+        conectar();
+    }
+    else if (estado == MQTT_CONECTADO)
+    {
+        // Publica sem esperar confirmações, até MQTT_JANELA mensagens em trânsito
+        while (num_em_transito < MQTT_JANELA && publicar_lote())
+        {
+        }
+    }
+    cyw43_arch_lwip_end();
+}
+
+// Indica se há sessão ativa com o broker
+bool telemetria_mqtt_conectado(void)
+{
+    return estado == MQTT_CONECTADO;
+}
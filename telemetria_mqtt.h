@@ -0,0 +1,45 @@
+#ifndef TELEMETRIA_MQTT_H // Previne múltiplas inclusões do cabeçalho
+#define TELEMETRIA_MQTT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "amostra.h"
+
+// ============================================================================
+// === Parâmetros do broker e dos tópicos ===
+#define MQTT_BROKER_IP "192.168.0.10" // Endereço do broker (ex.: Mosquitto local)
+#define MQTT_BROKER_PORTA 1883
+#define MQTT_PREFIXO_ID "estacao"     // Client id e <id> dos tópicos: estacao-<id do beacon UDP>
+#define MQTT_TOPICO_BASE "estacoes"   // Tópicos: estacoes/<id>/{telemetria,status,cmd}
+#define MQTT_KEEP_ALIVE_S 30
+
+// === Fila de saída e lotes ===
+#define MQTT_TAM_FILA 32        // Amostras aguardando publicação
+#define MQTT_MAX_LOTE 8         // Amostras por mensagem quando o enlace está lento
+#define MQTT_JANELA 3           // Publicações QoS 1 em trânsito simultaneamente
+#define MQTT_RECONEXAO_MIN_MS 1000
+#define MQTT_RECONEXAO_MAX_MS 60000
+
+// Callback para comandos de configuração recebidos no tópico cmd (formato "chave=valor").
+// Retorna true se a chave foi reconhecida e aplicada.
+typedef bool (*mqtt_comando_t)(const char *chave, float valor);
+
+// ============================================================================
+// === API ===
+
+// Prepara o cliente. A conexão é feita depois, de forma assíncrona, por telemetria_mqtt_processar.
+void telemetria_mqtt_iniciar(mqtt_comando_t comando);
+
+// Enfileira uma amostra. Se a fila estiver cheia, a mais antiga ainda não publicada é
+// descartada. Uma amostra só sai da fila quando o broker confirma (PUBACK) o seu lote.
+void telemetria_mqtt_amostra(const amostra_t *amostra);
+
+// Executado no laço principal: reconecta com espera crescente e publica o que estiver na fila.
+// Nunca bloqueia aguardando a rede.
+void telemetria_mqtt_processar(void);
+
+// Indica se há sessão ativa com o broker
+bool telemetria_mqtt_conectado(void);
+
+#endif // TELEMETRIA_MQTT_H
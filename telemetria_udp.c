@@ -0,0 +1,135 @@
+#include "telemetria_udp.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "pico/rand.h"
+#include "pico/unique_id.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+
+static struct udp_pcb *pcb_udp;
+static ip_addr_t destino;
+
+static telemetria_udp_pacote_t pacote; // lote em montagem
+static uint32_t proxima_seq;
+static bool houve_descarte;            // um envio falhou desde o último datagrama
+
+// Converte para ponto fixo com arredondamento, saturando nos limites do campo
+static int32_t ponto_fixo(float valor, float escala, int32_t minimo, int32_t maximo)
+{
+    float v = roundf(valor * escala);
+    if (!(v >= (float)minimo)) // também trata NaN
+    {
+        return minimo;
+    }
+    if (v > (float)maximo)
+    {
+        return maximo;
+    }
+    return (int32_t)v;
+}
+
+// Envia o lote atual em um datagrama de tamanho fixo
+static void enviar_pacote(void)
+{
+    pacote.seq = proxima_seq;
+    pacote.flags = houve_descarte ? TELEMETRIA_UDP_FLAG_FILA_CHEIA : 0;
+
+    uint8_t buf[TELEMETRIA_UDP_TAM_PACOTE];
+    telemetria_udp_codificar(&pacote, buf);
+
+    cyw43_arch_lwip_begin();
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, sizeof(buf), PBUF_RAM);
+    err_t err = ERR_MEM;
+    if (p)
+    {
+        memcpy(p->payload, buf, sizeof(buf));
+        err = udp_sendto(pcb_udp, p, &destino, TELEMETRIA_UDP_PORTA);
+        pbuf_free(p);
+    }
+    cyw43_arch_lwip_end();
+
+    // A sequência só avança para datagramas que saíram: falhas locais são sinalizadas
+    // no próximo pacote em vez de aparecerem como perda na rede
+    if (err == ERR_OK)
+    {
+        proxima_seq++;
+        houve_descarte = false;
+    }
+    else
+    {
+        houve_descarte = true;
+    }
+    pacote.quantidade = 0;
+}
+
+// Cria o PCB UDP. O ID da estação vem do identificador único da flash.
+bool telemetria_udp_iniciar(void)
+{
+    if (!ipaddr_aton(TELEMETRIA_UDP_DESTINO, &destino))
+    {
+        printf("Destino UDP invalido: %s\n", TELEMETRIA_UDP_DESTINO);
+        return false;
+    }
+
+    cyw43_arch_lwip_begin();
+    pcb_udp = udp_new();
+    if (pcb_udp)
+    {
+        ip_set_option(pcb_udp, SOF_BROADCAST); // permite destino de broadcast
+    }
+    cyw43_arch_lwip_end();
+
+    if (!pcb_udp)
+    {
+        printf("Erro ao criar PCB UDP\n");
+        return false;
+    }
+
+    pacote.estacao = telemetria_udp_id_estacao();
+    pacote.sessao = (uint16_t)get_rand_32();
+    pacote.quantidade = 0;
+    printf("Beacon UDP: estacao %08lx -> %s:%d\n", (unsigned long)pacote.estacao,
+           TELEMETRIA_UDP_DESTINO, TELEMETRIA_UDP_PORTA);
+    return true;
+}
+
+// Acumula a amostra e envia o datagrama quando o lote estiver completo
+void telemetria_udp_amostra(const amostra_t *amostra)
+{
+    if (!pcb_udp)
+    {
+        return;
+    }
+
+    if (pacote.quantidade == 0)
+    {
+        pacote.instante_ms = amostra->instante_ms;
+    }
+
+    telemetria_udp_amostra_t *a = &pacote.amostras[pacote.quantidade++];
+    uint32_t delta = amostra->instante_ms - pacote.instante_ms;
+    a->delta_ms = delta > UINT16_MAX ? UINT16_MAX : (uint16_t)delta;
+    a->temperatura_cc = (int16_t)ponto_fixo(amostra->temperatura, 100.0f, INT16_MIN, INT16_MAX);
+    a->pressao_pa = (uint32_t)ponto_fixo(amostra->pressao, 100.0f, 0, INT32_MAX);
+    a->umidade_cp = amostra->umidade_valida
+                        ? (uint16_t)ponto_fixo(amostra->umidade, 100.0f, 0, 10000)
+                        : TELEMETRIA_UDP_UMIDADE_INVALIDA;
+
+    if (pacote.quantidade >= TELEMETRIA_UDP_LOTE || pacote.quantidade >= TELEMETRIA_UDP_MAX_AMOSTRAS)
+    {
+        enviar_pacote();
+    }
+}
+
+// ID usado nos datagramas: 32 bits menos significativos do ID único da flash
+uint32_t telemetria_udp_id_estacao(void)
+{
+    pico_unique_board_id_t id;
+    pico_get_unique_board_id(&id);
+    return telemetria_udp_ler32(&id.id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES - 4]);
+}
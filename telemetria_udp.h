@@ -0,0 +1,28 @@
+#ifndef TELEMETRIA_UDP_H // Previne múltiplas inclusões do cabeçalho
+#define TELEMETRIA_UDP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "amostra.h"
+#include "telemetria_udp_formato.h"
+
+// ============================================================================
+// === Parâmetros do beacon UDP ===
+#define TELEMETRIA_UDP_DESTINO "255.255.255.255" // Coletor (unicast) ou broadcast da rede
+#define TELEMETRIA_UDP_PORTA 5005
+#define TELEMETRIA_UDP_LOTE 1 // Amostras por datagrama (1..TELEMETRIA_UDP_MAX_AMOSTRAS)
+
+// ============================================================================
+// === API ===
+
+// Cria o PCB UDP. O ID da estação vem do identificador único da flash.
+bool telemetria_udp_iniciar(void);
+
+// Acumula a amostra e envia o datagrama quando o lote estiver completo
+void telemetria_udp_amostra(const amostra_t *amostra);
+
+// ID usado nos datagramas (útil para exibir/associar no coletor)
+uint32_t telemetria_udp_id_estacao(void);
+
+#endif // TELEMETRIA_UDP_H
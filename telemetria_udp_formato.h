@@ -0,0 +1,164 @@
+#ifndef TELEMETRIA_UDP_FORMATO_H // Previne múltiplas inclusões do cabeçalho
+#define TELEMETRIA_UDP_FORMATO_H
+
+// Formato binário do datagrama de telemetria UDP.
+// Compartilhado entre o firmware e o receptor no host (host/receptor_udp.c),
+// por isso usa apenas C padrão. Todos os campos são little-endian.
+//
+// Cabeçalho (20 bytes):
+//   0  u16 magico       'E','M' (0x4D45)
+//   2  u8  versao       TELEMETRIA_UDP_VERSAO
+//   3  u8  quantidade   amostras válidas no pacote (1..TELEMETRIA_UDP_MAX_AMOSTRAS)
+//   4  u32 estacao      ID da estação
+//   8  u16 sessao       sorteado no boot: reinício da sequência não é contado como perda
+//  10  u16 flags        TELEMETRIA_UDP_FLAG_*
+//  12  u32 seq          número de sequência do pacote (+1 a cada datagrama)
+//  16  u32 instante_ms  instante da primeira amostra, em ms desde o boot
+// Amostras (10 bytes cada, sempre TELEMETRIA_UDP_MAX_AMOSTRAS posições):
+//   0  u16 delta_ms     atraso em relação a instante_ms
+//   2  i16 temperatura  centésimos de °C
+//   4  u16 umidade      centésimos de % (TELEMETRIA_UDP_UMIDADE_INVALIDA se ausente)
+//   6  u32 pressao      Pa (centésimos de hPa)
+// Final (2 bytes):
+//   u16 crc             CRC-16/CCITT-FALSE de todos os bytes anteriores
+//
+// Detecção de perdas: o receptor acompanha (estacao, sessao, seq). Um salto na sequência
+// indica datagramas perdidos, um número repetido indica duplicata e o CRC descarta
+// datagramas corrompidos.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRIA_UDP_MAGICO 0x4D45
+#define TELEMETRIA_UDP_VERSAO 1
+#define TELEMETRIA_UDP_MAX_AMOSTRAS 4
+#define TELEMETRIA_UDP_TAM_CABECALHO 20
+#define TELEMETRIA_UDP_TAM_AMOSTRA 10
+#define TELEMETRIA_UDP_TAM_PACOTE (TELEMETRIA_UDP_TAM_CABECALHO + \
+                                   TELEMETRIA_UDP_MAX_AMOSTRAS * TELEMETRIA_UDP_TAM_AMOSTRA + 2)
+#define TELEMETRIA_UDP_UMIDADE_INVALIDA 0xFFFF
+#define TELEMETRIA_UDP_FLAG_FILA_CHEIA 0x0001 // amostras foram descartadas antes deste pacote
+
+// Amostra em ponto fixo
+typedef struct
+{
+    uint16_t delta_ms;
+    int16_t temperatura_cc;
+    uint16_t umidade_cp;
+    uint32_t pressao_pa;
+} telemetria_udp_amostra_t;
+
+// Pacote decodificado
+typedef struct
+{
+    uint8_t quantidade;
+    uint32_t estacao;
+    uint16_t sessao;
+    uint16_t flags;
+    uint32_t seq;
+    uint32_t instante_ms;
+    telemetria_udp_amostra_t amostras[TELEMETRIA_UDP_MAX_AMOSTRAS];
+} telemetria_udp_pacote_t;
+
+// CRC-16/CCITT-FALSE (polinômio 0x1021, valor inicial 0xFFFF)
+static inline uint16_t telemetria_udp_crc16(const uint8_t *dados, size_t tam)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < tam; i++)
+    {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static inline void telemetria_udp_escrever16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void telemetria_udp_escrever32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t telemetria_udp_ler16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t telemetria_udp_ler32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Serializa o pacote em 'buf' (TELEMETRIA_UDP_TAM_PACOTE bytes). Posições sem amostra vão zeradas.
+static inline void telemetria_udp_codificar(const telemetria_udp_pacote_t *pct, uint8_t *buf)
+{
+    telemetria_udp_escrever16(buf + 0, TELEMETRIA_UDP_MAGICO);
+    buf[2] = TELEMETRIA_UDP_VERSAO;
+    buf[3] = pct->quantidade;
+    telemetria_udp_escrever32(buf + 4, pct->estacao);
+    telemetria_udp_escrever16(buf + 8, pct->sessao);
+    telemetria_udp_escrever16(buf + 10, pct->flags);
+    telemetria_udp_escrever32(buf + 12, pct->seq);
+    telemetria_udp_escrever32(buf + 16, pct->instante_ms);
+
+    for (int i = 0; i < TELEMETRIA_UDP_MAX_AMOSTRAS; i++)
+    {
+        uint8_t *p = buf + TELEMETRIA_UDP_TAM_CABECALHO + i * TELEMETRIA_UDP_TAM_AMOSTRA;
+        telemetria_udp_amostra_t vazia = {0};
+        const telemetria_udp_amostra_t *a = i < pct->quantidade ? &pct->amostras[i] : &vazia;
+        telemetria_udp_escrever16(p + 0, a->delta_ms);
+        telemetria_udp_escrever16(p + 2, (uint16_t)a->temperatura_cc);
+        telemetria_udp_escrever16(p + 4, a->umidade_cp);
+        telemetria_udp_escrever32(p + 6, a->pressao_pa);
+    }
+
+    size_t tam_dados = TELEMETRIA_UDP_TAM_PACOTE - 2;
+    telemetria_udp_escrever16(buf + tam_dados, telemetria_udp_crc16(buf, tam_dados));
+}
+
+// Valida e decodifica um datagrama. Retorna false se tamanho, versão ou CRC não conferem.
+static inline bool telemetria_udp_decodificar(const uint8_t *buf, size_t tam, telemetria_udp_pacote_t *pct)
+{
+    size_t tam_dados = TELEMETRIA_UDP_TAM_PACOTE - 2;
+    if (tam != TELEMETRIA_UDP_TAM_PACOTE ||
+        telemetria_udp_ler16(buf) != TELEMETRIA_UDP_MAGICO ||
+        buf[2] != TELEMETRIA_UDP_VERSAO ||
+        telemetria_udp_ler16(buf + tam_dados) != telemetria_udp_crc16(buf, tam_dados))
+    {
+        return false;
+    }
+
+    pct->quantidade = buf[3];
+    if (pct->quantidade == 0 || pct->quantidade > TELEMETRIA_UDP_MAX_AMOSTRAS)
+    {
+        return false;
+    }
+    pct->estacao = telemetria_udp_ler32(buf + 4);
+    pct->sessao = telemetria_udp_ler16(buf + 8);
+    pct->flags = telemetria_udp_ler16(buf + 10);
+    pct->seq = telemetria_udp_ler32(buf + 12);
+    pct->instante_ms = telemetria_udp_ler32(buf + 16);
+
+    for (int i = 0; i < pct->quantidade; i++)
+    {
+        const uint8_t *p = buf + TELEMETRIA_UDP_TAM_CABECALHO + i * TELEMETRIA_UDP_TAM_AMOSTRA;
+        pct->amostras[i].delta_ms = telemetria_udp_ler16(p + 0);
+        pct->amostras[i].temperatura_cc = (int16_t)telemetria_udp_ler16(p + 2);
+        pct->amostras[i].umidade_cp = telemetria_udp_ler16(p + 4);
+        pct->amostras[i].pressao_pa = telemetria_udp_ler32(p + 6);
+    }
+    return true;
+}
+
+#endif // TELEMETRIA_UDP_FORMATO_H